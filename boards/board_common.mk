@@ -593,6 +593,7 @@ LWIP-MOD-MK?=$(ROOTDIR)/communication/lwip.mod.mk
 include $(LWIP-MOD-MK)
 
 obj-$(USE_RAMLOG) += ramlog.o
+obj-$(USE_STRACE) += strace.o
 
 #TCF
 TCF-MOD-MK?=$(ROOTDIR)/common/tcf/tcf.mod.mk
@@ -623,6 +624,15 @@ obj-$(USE_SLEEP) += sleep.o
 # Circular Buffer (always)
 obj-y += cirq_buffer.o
 
+# Static memory arena, CFG+=ARENA. Pulled in by lwIP (Arc_MBox, sys_arch)
+ifeq ($(USE_LWIP),y)
+ifneq ($(CFG_ARENA),y)
+CFG_ARENA=y
+def-y += CFG_ARENA
+endif
+endif
+obj-$(CFG_ARENA) += arena.o
+
 obj-y += version.o
 
 # IPC for JAC6
@@ -15,6 +15,7 @@ MOD_AVAIL+=XCP COM PDUR IPDUM WDGM WDGIF DET DCM DEM CANTP J1939TP CANIF RTE FEE
 
 # Linux OS
 MOD_AVAIL+=LINUXOS LINUXOS_DB
+MOD_AVAIL+=STRACE
 
 # Network management
 MOD_AVAIL+=COMM NM CANNM CANSM NMHB UDPNM 
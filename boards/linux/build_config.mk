@@ -29,6 +29,7 @@ MOD_AVAIL+=ETHIF
 MOD_AVAIL+=ETHTSYN
 MOD_AVAIL+=LDCOM
 MOD_AVAIL+=STBM
+MOD_AVAIL+=STRACE
 # Required modules
 #MOD_USE += 
 
@@ -26,6 +26,7 @@
 #include "T1_AppInterface.h"
 #include "T1_AppInterface.h"
 #include "ARCCORE_T1_interface.h"
+#include "strace.h"
 #include <string.h>
 
 #if defined(CFG_T1_COREID_CBK)
@@ -145,6 +146,7 @@ void Arc_T1_Tx_Cbk(void){
  * @param taskId
  */
 void Os_WaitEventHook(TaskType taskId){
+    STRACE(STRACE_EV_TASK_WAIT, taskId);
     OSTH_SUSPEND_NOSUSP(taskId, Arc_T1_GetCoreId(), Timer_GetTicks());
 }
 
@@ -153,6 +155,7 @@ void Os_WaitEventHook(TaskType taskId){
  * @param taskId
  */
 void Os_ResumeEventHook(TaskType taskId){
+    STRACE(STRACE_EV_TASK_RESUME, taskId);
     OSTH_RESUME_NOSUSP(taskId, Arc_T1_GetCoreId(), Timer_GetTicks());
 }
 
@@ -161,6 +164,7 @@ void Os_ResumeEventHook(TaskType taskId){
  * @param taskId
  */
 void Os_ReleaseEventHook(TaskType taskId){
+    STRACE(STRACE_EV_TASK_RELEASE, taskId);
     OSTH_RELEASE_NOSUSP(taskId, Arc_T1_GetCoreId(), Timer_GetTicks());
 }
 
@@ -169,6 +173,7 @@ void Os_ReleaseEventHook(TaskType taskId){
  * @param taskId
  */
 void Os_ActivateTaskHook(TaskType taskId){
+    STRACE(STRACE_EV_TASK_ACTIVATE, taskId);
     OSTH_ACTIVATE_NOSUSP(taskId, Arc_T1_GetCoreId(), Timer_GetTicks());
 }
 
@@ -178,6 +183,7 @@ void Os_ActivateTaskHook(TaskType taskId){
  */
 void Os_StopTaskHook(TaskType taskId){
     taskRunning[taskId] = FALSE;
+    STRACE(STRACE_EV_TASK_STOP, taskId);
     OSTH_STOP_NOSUSP(taskId, Arc_T1_GetCoreId(), Timer_GetTicks());
 }
 
@@ -188,6 +194,7 @@ void Os_StopTaskHook(TaskType taskId){
 void Os_StartTaskHook(TaskType taskId){
     if(taskRunning[taskId] == FALSE){
         taskRunning[taskId] = TRUE;
+        STRACE(STRACE_EV_TASK_START, taskId);
         OSTH_START_NOSUSP(taskId, Arc_T1_GetCoreId(), Timer_GetTicks());
     }
 }
@@ -197,6 +204,8 @@ void Os_StartTaskHook(TaskType taskId){
  * @param taskIdStop, taskIdStart
  */
 void Os_StartStopTaskHook(TaskType taskIdStop, TaskType taskIdStart){
+    STRACE(STRACE_EV_TASK_STOP, taskIdStop);
+    STRACE(STRACE_EV_TASK_START, taskIdStart);
     OSTH_STOP_START_NOSUSP(taskIdStop, taskIdStart, Arc_T1_GetCoreId(), Timer_GetTicks());
 }
 
@@ -206,6 +215,7 @@ void Os_StartStopTaskHook(TaskType taskIdStop, TaskType taskIdStart){
  * @param isr
  */
 void Os_PreIsrHook(ISRType isr) {
+    STRACE(STRACE_EV_ISR_START, isr);
     OSTH_START_NOSUSP(isr+OS_TASK_CNT, Arc_T1_GetCoreId(), Timer_GetTicks());
 }
 
@@ -215,6 +225,7 @@ void Os_PreIsrHook(ISRType isr) {
  * @param isr
  */
 void Os_PostIsrHook(ISRType isr) {
+    STRACE(STRACE_EV_ISR_STOP, isr);
     OSTH_STOP_NOSUSP(isr+OS_TASK_CNT, Arc_T1_GetCoreId(), Timer_GetTicks());
 }
 
@@ -0,0 +1,187 @@
+/*-------------------------------- Arctic Core ------------------------------
+ * Copyright (C) 2013, ArcCore AB, Sweden, www.arccore.com.
+ * Contact: <contact@arccore.com>
+ * 
+ * You may ONLY use this file:
+ * 1)if you have a valid commercial ArcCore license and then in accordance with  
+ * the terms contained in the written license agreement between you and ArcCore, 
+ * or alternatively
+ * 2)if you follow the terms found in GNU General Public License version 2 as 
+ * published by the Free Software Foundation and appearing in the file 
+ * LICENSE.GPL included in the packaging of this file or here 
+ * <http://www.gnu.org/licenses/old-licenses/gpl-2.0.txt>
+ *-------------------------------- Arctic Core -----------------------------*/
+/*
+ * DESCRIPTION
+ *  Static memory arena with fixed-size block pools, see arena.h.
+ *
+ *  Each pool is a free list of block indexes. The head holds the index of
+ *  the first free block and a tag that is incremented on every update, so
+ *  push and pop are single compare-and-swap operations without the ABA
+ *  problem. Blocks that have never been used are taken from the end of the
+ *  pool, no initialization is needed.
+ */
+
+/*lint -w2 */
+#include <string.h>
+#include "Cpu.h"
+#include "arena.h"
+#include "arc_assert.h"
+#include "arc_atomic.h"
+
+#define ARENA_IDX_NONE      0xFFFFu
+#define ARENA_HEAD(_tag, _idx)  (((uint32)(_tag) << 16u) | (uint32)(_idx))
+#define ARENA_HEAD_IDX(_h)      ((_h) & 0xFFFFu)
+#define ARENA_HEAD_TAG(_h)      ((_h) >> 16u)
+
+typedef struct {
+    uint8 *mem;
+    uint16 *next;       /* Next free block, per block */
+    uint32 blockSize;
+    uint32 blockCnt;
+} Arena_PoolCfgType;
+
+typedef struct {
+    uint32 freeHead;    /* ARENA_HEAD(tag, first free block) */
+    uint32 unused;      /* First never used block */
+    uint32 used;
+    uint32 highWater;
+    uint32 failCnt;
+} Arena_PoolType;
+
+/* Pool memory */
+#define ARENA_POOL_MEM(_size, _cnt) \
+    static uint64 Arena_Mem_##_size[((_size) * (_cnt)) / sizeof(uint64)]; \
+    static uint16 Arena_Next_##_size[_cnt];
+ARENA_POOLS(ARENA_POOL_MEM)
+
+#define ARENA_POOL_CFG(_size, _cnt) \
+    { (uint8 *)Arena_Mem_##_size, Arena_Next_##_size, (_size), (_cnt) },
+static const Arena_PoolCfgType Arena_PoolCfg[ARENA_POOL_CNT] = {
+    ARENA_POOLS(ARENA_POOL_CFG)
+};
+
+#define ARENA_POOL_INIT(_size, _cnt) \
+    { ARENA_HEAD(0u, ARENA_IDX_NONE), 0u, 0u, 0u, 0u },
+static Arena_PoolType Arena_Pool[ARENA_POOL_CNT] = {
+    ARENA_POOLS(ARENA_POOL_INIT)
+};
+
+static uint32 Arena_FailCnt = 0;
+
+#if defined(__GNUC__)
+#define ARENA_LOAD(_p)              __atomic_load_n((_p), __ATOMIC_ACQUIRE)
+#define ARENA_CAS(_p, _old, _new)   __atomic_compare_exchange_n((_p), &(_old), (_new), FALSE, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#define ARENA_ADD(_p, _v)           __atomic_add_fetch((_p), (_v), __ATOMIC_RELAXED)
+/* A stale next of a block popped by someone else is discarded by the CAS */
+#define ARENA_NEXT_GET(_cfg, _i)        __atomic_load_n(&(_cfg)->next[_i], __ATOMIC_RELAXED)
+#define ARENA_NEXT_SET(_cfg, _i, _v)    __atomic_store_n(&(_cfg)->next[_i], (_v), __ATOMIC_RELAXED)
+#else
+#define ARENA_LOAD(_p)              Arc_AtomicLoadAcq32(_p)
+#define ARENA_CAS(_p, _old, _new)   Arc_AtomicCas32((_p), &(_old), (_new))
+#define ARENA_ADD(_p, _v)           Arc_AtomicAdd32((_p), (_v))
+#define ARENA_NEXT_GET(_cfg, _i)        ((_cfg)->next[_i])
+#define ARENA_NEXT_SET(_cfg, _i, _v)    ((_cfg)->next[_i] = (_v))
+#endif
+
+/* A free block of the pool or ARENA_IDX_NONE */
+static uint32 arena_pop( const Arena_PoolCfgType *cfg, Arena_PoolType *pool ) {
+    uint32 old = ARENA_LOAD(&pool->freeHead);
+    uint32 idx;
+
+    while (ARENA_HEAD_IDX(old) != ARENA_IDX_NONE) {
+        idx = ARENA_HEAD_IDX(old);
+        if (ARENA_CAS(&pool->freeHead, old, ARENA_HEAD(ARENA_HEAD_TAG(old) + 1u, ARENA_NEXT_GET(cfg, idx)))) {
+            return idx;
+        }
+    }
+
+    /* Never used blocks */
+    idx = ARENA_LOAD(&pool->unused);
+    while (idx < cfg->blockCnt) {
+        if (ARENA_CAS(&pool->unused, idx, idx + 1u)) {
+            return idx;
+        }
+    }
+    return ARENA_IDX_NONE;
+}
+
+static void arena_push( const Arena_PoolCfgType *cfg, Arena_PoolType *pool, uint32 idx ) {
+    uint32 old = ARENA_LOAD(&pool->freeHead);
+
+    do {
+        ARENA_NEXT_SET(cfg, idx, (uint16)ARENA_HEAD_IDX(old));
+    } while (!ARENA_CAS(&pool->freeHead, old, ARENA_HEAD(ARENA_HEAD_TAG(old) + 1u, idx)));
+}
+
+void *Arena_Alloc( uint32 size ) {
+    uint32 p;
+
+    for (p = 0; p < ARENA_POOL_CNT; p++) {
+        const Arena_PoolCfgType *cfg = &Arena_PoolCfg[p];
+        Arena_PoolType *pool = &Arena_Pool[p];
+        uint32 idx;
+        uint32 used;
+        uint32 hw;
+
+        if (cfg->blockSize < size) {
+            continue;
+        }
+        idx = arena_pop(cfg, pool);
+        if (idx == ARENA_IDX_NONE) {
+            (void)ARENA_ADD(&pool->failCnt, 1u);
+            continue;
+        }
+
+        used = ARENA_ADD(&pool->used, 1u);
+        hw = ARENA_LOAD(&pool->highWater);
+        while ((used > hw) && !ARENA_CAS(&pool->highWater, hw, used)) {
+            /* Retry with the new high water mark */
+        }
+        return &cfg->mem[idx * cfg->blockSize];
+    }
+
+    (void)ARENA_ADD(&Arena_FailCnt, 1u);
+    return NULL;
+}
+
+void Arena_Free( void *ptr ) {
+    uint8 *bPtr = (uint8 *)ptr;
+    uint32 p;
+
+    if (ptr == NULL) {
+        return;
+    }
+
+    for (p = 0; p < ARENA_POOL_CNT; p++) {
+        const Arena_PoolCfgType *cfg = &Arena_PoolCfg[p];
+
+        if ((bPtr >= cfg->mem) && (bPtr < &cfg->mem[cfg->blockCnt * cfg->blockSize])) {
+            uint32 idx = (uint32)(bPtr - cfg->mem) / cfg->blockSize;
+
+            ASSERT(&cfg->mem[idx * cfg->blockSize] == bPtr);
+            (void)ARENA_ADD(&Arena_Pool[p].used, (uint32)-1);
+            arena_push(cfg, &Arena_Pool[p], idx);
+            return;
+        }
+    }
+
+    /* Not from the arena */
+    ASSERT(0);
+}
+
+Std_ReturnType Arena_GetPoolStats( uint32 pool, Arena_PoolStatsType *stats ) {
+    if ((pool >= ARENA_POOL_CNT) || (stats == NULL)) {
+        return E_NOT_OK;
+    }
+    stats->blockSize = Arena_PoolCfg[pool].blockSize;
+    stats->blockCnt = Arena_PoolCfg[pool].blockCnt;
+    stats->used = Arena_Pool[pool].used;
+    stats->highWater = Arena_Pool[pool].highWater;
+    stats->failCnt = Arena_Pool[pool].failCnt;
+    return E_OK;
+}
+
+uint32 Arena_GetFailCnt( void ) {
+    return Arena_FailCnt;
+}
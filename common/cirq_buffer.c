@@ -18,10 +18,14 @@
  *  This file implements the following versions:
  *  1. CirqBuffDynXXXX
  *     - The size of the data is not known of compile time
- *       (semidynamic, since there is no free() function )
+ *       (semidynamic, memory is taken from the static arena, see arena.h)
  *  2. CirqBuffXXX
  *     - A static implementation, data is known at compile time.
  *       (implemented in the header file?)
+ *  3. CirqBuffLfXXX
+ *     - Lock-free single producer/single consumer and multiple
+ *       producer/single consumer buffers, see cirq_buffer.h.
+ *       Used by Arc_MBox and the TCF tty stream.
  *
  * Implementation note:
  * - CirqBuffDynXXXX, valgrind: OK
@@ -36,6 +40,10 @@
 #include <stdint.h>
 #include "Cpu.h"
 #include "cirq_buffer.h"
+#if defined(CFG_ARENA)
+#include "arena.h"
+#endif
+#include "arc_atomic.h"
 #include "Os.h"
 
 #ifdef _TEST_CIRQ_BUFFER_DYN_
@@ -69,7 +77,6 @@
 #endif
 
 
-/* IMPROVMENT: Make it threadsafe, add DisableAllInterrts()/EnableAllInterrupts() */
 void CirqBuff_Init(CirqBufferType *cirqbuffer, void *buffer, uint32 maxCnt, uint32 dataSize) {
     cirqbuffer->bufStart = buffer;
     cirqbuffer->maxCnt = maxCnt;
@@ -100,19 +107,20 @@ CirqBufferType CirqBuffStatCreate(void *buffer, uint32 maxCnt, uint32 dataSize)
     return cirqbuffer;
 }
 
+#if defined(CFG_ARENA)
 CirqBufferType *CirqBuffDynCreate( uint32 size, uint32 dataSize ) {
     CirqBufferType *cPtr;
-    /*lint -save -e586 */
-    cPtr = malloc(sizeof(CirqBufferType));
-    /*lint -restore */
+    cPtr = Arena_Alloc(sizeof(CirqBufferType));
     if( cPtr == NULL ) {
         return NULL;
     }
     cPtr->maxCnt = size;
     cPtr->dataSize = dataSize;
-    /*lint -save -e586 -e632 STANDARDIZED INTERFACE */
-    cPtr->bufStart = malloc(dataSize*size);
-    /*lint -restore */
+    cPtr->bufStart = Arena_Alloc(dataSize*size);
+    if( cPtr->bufStart == NULL ) {
+        Arena_Free(cPtr);
+        return NULL;
+    }
     cPtr->bufEnd = (char *)cPtr->bufStart + dataSize*size;
     cPtr->head = cPtr->bufStart;
     cPtr->tail = cPtr->bufStart;
@@ -123,12 +131,11 @@ CirqBufferType *CirqBuffDynCreate( uint32 size, uint32 dataSize ) {
 
 
 int CirqBuffDynDestroy(CirqBufferType *cPtr ) {
-    /*lint -save -e586 */
-    free(cPtr->bufStart);
-    free(cPtr);
-    /*lint -restore */
+    Arena_Free(cPtr->bufStart);
+    Arena_Free(cPtr);
     return 0;
 }
+#endif
 
 /**
  * Push an entry to the buffer.
@@ -250,6 +257,121 @@ void *CirqBuff_Peek( CirqBufferType *cPtr, uint32 offset ){
     return dataPtr;
 }
 
+#if defined(__GNUC__)
+#define CIRQ_LOAD_ACQ(_p)           __atomic_load_n((_p), __ATOMIC_ACQUIRE)
+#define CIRQ_LOAD(_p)               __atomic_load_n((_p), __ATOMIC_RELAXED)
+#define CIRQ_STORE_REL(_p, _v)      __atomic_store_n((_p), (_v), __ATOMIC_RELEASE)
+#define CIRQ_CAS(_p, _old, _new)    __atomic_compare_exchange_n((_p), &(_old), (_new), TRUE, __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+#else
+/* The interrupt lock in the acquire/release helpers keeps the compiler from
+ * moving the data copy across the index update */
+#define CIRQ_LOAD_ACQ(_p)           Arc_AtomicLoadAcq32(_p)
+#define CIRQ_LOAD(_p)               (*(volatile uint32 *)(_p))
+#define CIRQ_STORE_REL(_p, _v)      Arc_AtomicStoreRel32((_p), (_v))
+#define CIRQ_CAS(_p, _old, _new)    Arc_AtomicCas32((_p), &(_old), (_new))
+#endif
+
+int CirqBuffLf_Init( CirqBuffLfType *cPtr, CirqBuffLfModeType mode, void *buffer, uint32 *seq, uint32 maxCnt, uint32 dataSize ) {
+    if( (cPtr == NULL) || (buffer == NULL) || (maxCnt == 0u) || ((maxCnt & (maxCnt - 1u)) != 0u) ||
+        ((mode == CIRQBUFF_MPSC) && (seq == NULL)) ) {
+        return 1;
+    }
+    memset(cPtr, 0, sizeof(CirqBuffLfType));
+    cPtr->buf = buffer;
+    cPtr->seq = seq;
+    cPtr->mask = maxCnt - 1u;
+    cPtr->dataSize = dataSize;
+    cPtr->mode = mode;
+    if( mode == CIRQBUFF_MPSC ) {
+        for(uint32 i = 0; i < maxCnt; i++) {
+            seq[i] = i;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Push an entry to the buffer.
+ *
+ * @param cPtr    Buffer initialized with CirqBuffLf_Init()
+ * @param dataPtr
+ * @return 0 - if successfully pushed.
+ *         1- nothing pushed (it was full)
+ */
+int CirqBuffLf_Push( CirqBuffLfType *cPtr, const void *dataPtr ) {
+    uint32 pos;
+
+    if( cPtr->mode == CIRQBUFF_SPSC ) {
+        pos = cPtr->head;
+        if( (pos - cPtr->tailCache) > cPtr->mask ) {
+            cPtr->tailCache = CIRQ_LOAD_ACQ(&cPtr->tail);
+            if( (pos - cPtr->tailCache) > cPtr->mask ) {
+                return 1;	/* No more room */
+            }
+        }
+        MEMCPY(&cPtr->buf[(pos & cPtr->mask) * cPtr->dataSize], dataPtr, cPtr->dataSize);
+        CIRQ_STORE_REL(&cPtr->head, pos + 1u);
+        return 0;
+    }
+
+    /* MPSC, the slot is free when its sequence number equals the position */
+    pos = CIRQ_LOAD(&cPtr->head);
+    for(;;) {
+        uint32 *seq = &cPtr->seq[pos & cPtr->mask];
+        sint32 diff = (sint32)(CIRQ_LOAD_ACQ(seq) - pos);
+
+        if( diff == 0 ) {
+            if( CIRQ_CAS(&cPtr->head, pos, pos + 1u) ) {
+                MEMCPY(&cPtr->buf[(pos & cPtr->mask) * cPtr->dataSize], dataPtr, cPtr->dataSize);
+                CIRQ_STORE_REL(seq, pos + 1u);
+                return 0;
+            }
+        } else if( diff < 0 ) {
+            return 1;	/* No more room */
+        } else {
+            pos = CIRQ_LOAD(&cPtr->head);
+        }
+    }
+}
+
+/**
+ * Pop an entry from the buffer, only one consumer.
+ *
+ * @param cPtr    Buffer initialized with CirqBuffLf_Init()
+ * @param dataPtr
+ * @return 0 - if successfully popped.
+ *         1- nothing popped (it was empty)
+ */
+int CirqBuffLf_Pop( CirqBuffLfType *cPtr, void *dataPtr ) {
+    uint32 pos = cPtr->tail;
+
+    if( cPtr->mode == CIRQBUFF_SPSC ) {
+        if( pos == cPtr->headCache ) {
+            cPtr->headCache = CIRQ_LOAD_ACQ(&cPtr->head);
+            if( pos == cPtr->headCache ) {
+                return 1;
+            }
+        }
+        MEMCPY(dataPtr, &cPtr->buf[(pos & cPtr->mask) * cPtr->dataSize], cPtr->dataSize);
+        CIRQ_STORE_REL(&cPtr->tail, pos + 1u);
+        return 0;
+    }
+
+    /* MPSC, the slot is written when its sequence number is position + 1 */
+    {
+        uint32 *seq = &cPtr->seq[pos & cPtr->mask];
+
+        if( CIRQ_LOAD_ACQ(seq) != (pos + 1u) ) {
+            return 1;
+        }
+        MEMCPY(dataPtr, &cPtr->buf[(pos & cPtr->mask) * cPtr->dataSize], cPtr->dataSize);
+        /* Free for the producers one lap later */
+        CIRQ_STORE_REL(seq, pos + cPtr->mask + 1u);
+        CIRQ_STORE_REL(&cPtr->tail, pos + 1u);
+    }
+    return 0;
+}
+
 #ifdef _TEST_CIRQ_BUFFER_DYN_
 int main( void ) {
     CirqBufferType *cPtr;
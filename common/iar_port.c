@@ -89,12 +89,7 @@ size_t __write(int handle, const unsigned char *buf, size_t cnt)
     }
 #endif
 #if defined(USE_RAMLOG)
-        {
-            const unsigned char *pbuf = buf;
-            for (int i = 0; i < cnt; i++) {
-                ramlog_chr (*(pbuf + i));
-            }
-        }
+        ramlog_write((const char *)buf, cnt);
 #endif
 
     (void)buf;
@@ -15,14 +15,17 @@
  * A message box implementation.
  *
  * Notes:
- * - Uses heap
+ * - Uses the static arena, see arena.h
  * - Do NOT use Arc_MBoxDestroy() call, it's there for testing purposes only.
+ * - Any number of posters, one fetcher per box (CIRQBUFF_MPSC). The size is
+ *   rounded up to a power of 2.
  */
 
 //#define _TEST_MBOX_
 /*lint -save -e9045 */ /* non-hidden definition of type  ..inherited from other files */
 
 #include "mbox.h"
+#include "arena.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -37,17 +40,38 @@
 
 Arc_MBoxType* Arc_MBoxCreate( uint32 size ) {
     Arc_MBoxType *mPtr;
+    CirqBuffLfType *cPtr;
+    void *buf;
+    uint32 *seq;
+    uint32 cnt = 1u;
 
-    mPtr = malloc(sizeof(Arc_MBoxType));/*lint !e586  Intended malloc */
-    mPtr->cirqPtr = CirqBuffDynCreate(size,sizeof(void *)); /*lint !e613  Intended pointer usage */
+    while( cnt < size ) {
+        cnt <<= 1u;
+    }
+
+    mPtr = Arena_Alloc(sizeof(Arc_MBoxType));
+    cPtr = Arena_Alloc(sizeof(CirqBuffLfType));
+    buf = Arena_Alloc(cnt * sizeof(void *));
+    seq = Arena_Alloc(cnt * sizeof(uint32));
+    if( (mPtr == NULL) || (cPtr == NULL) || (buf == NULL) || (seq == NULL) ||
+        (CirqBuffLf_Init(cPtr, CIRQBUFF_MPSC, buf, seq, cnt, sizeof(void *)) != 0) ) {
+        Arena_Free(seq);
+        Arena_Free(buf);
+        Arena_Free(cPtr);
+        Arena_Free(mPtr);
+        return NULL;
+    }
+    mPtr->cirqPtr = cPtr;
 
     return mPtr;
 }
 
 
 void Arc_MBoxDestroy( Arc_MBoxType *mPtr ) {
-    (void)CirqBuffDynDestroy(mPtr->cirqPtr);
-    free(mPtr); /*lint !e586  Intended free */
+    Arena_Free(mPtr->cirqPtr->seq);
+    Arena_Free(mPtr->cirqPtr->buf);
+    Arena_Free(mPtr->cirqPtr);
+    Arena_Free(mPtr);
 }
 
 /**
@@ -58,7 +82,7 @@ sint32 Arc_MBoxPost( const Arc_MBoxType *mPtr, void *msg ) {
     sint32 rv;
     sint32 status;
     status = 0;
-    rv = CirqBuffPush(mPtr->cirqPtr,msg);
+    rv = CirqBuffLf_Push(mPtr->cirqPtr,msg);
     if( rv != 0) {
         status = 1;
     }
@@ -74,7 +98,7 @@ sint32 Arc_MBoxFetch(const Arc_MBoxType *mPtr, void *msg)
     sint32 rv;
     sint32 status;
     status = 0;
-    rv = CirqBuffPop(mPtr->cirqPtr,msg);
+    rv = CirqBuffLf_Pop(mPtr->cirqPtr,msg);
     if(rv != 0) {
         status = 1;
     }
@@ -92,12 +92,7 @@ UARTError WriteUARTN(const void* buf, unsigned long cnt)
 #endif
 
 #if defined(USE_RAMLOG)
-        {
-            const char *pbuf = buf;
-            for (int i = 0; i < cnt; i++) {
-                ramlog_chr (*(pbuf + i));
-            }
-        }
+        ramlog_write((const char *)buf, cnt);
 #endif
 
     (void)buf; //lint !e920 MISRA False positive. Allowed to cast pointer to void here.
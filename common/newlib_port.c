@@ -462,12 +462,7 @@ int write(  int fd, const void *_buf, size_t nbytes)
 
 
 #if defined(USE_RAMLOG)
-        {
-            char *buf = (char *)_buf;
-            for (int i = 0; i < nbytes; i++) {
-                ramlog_chr (*(buf + i));
-            }
-        }
+        ramlog_write((const char *)_buf, nbytes);
 #endif
 
     }
@@ -476,10 +471,7 @@ int write(  int fd, const void *_buf, size_t nbytes)
 #if defined(USE_RAMLOG)
         /* RAMLOG support */
         if(fd == FILE_RAMLOG) {
-            char *buf = (char *)_buf;
-              for (int i = 0; i < nbytes; i++) {
-                ramlog_chr (*(buf + i));
-              }
+            ramlog_write((const char *)_buf, nbytes);
         }
 #endif
     }
@@ -17,32 +17,82 @@
 #include "Os.h"
 #include "timer.h"
 #include "arc.h"
+#include "perf.h"
 #if defined(CFG_SHELL)
 #include "shell.h"
 #endif
+#if defined(USE_LINUXOS) && !defined(_WIN32)
+#include "LinuxOs_Timer.h"
+#include "LinuxOs_TaskStats.h"
+#endif
 
 #include <stdio.h>
 #include <string.h>
+#if defined(CFG_PERF_FUNC) && defined(USE_LINUXOS) && !defined(_WIN32)
+#include <time.h>
+#endif
 
 //#define USE_LDEBUG_PRINTF
 #include "debug.h"
 
 /* ----------------------------[private define]------------------------------*/
-#define MAX_FUNCTION_CNT    16uL // has to be less that 255
 #define MAX_NAME_CHAR_LEN   32uL
-#define NO_ACTIVE_FUNCTION 0xFFu
-#define MAX_VAL_INIT 0xFFFFFFFF
 /* ----------------------------[private macro]-------------------------------*/
-/* ----------------------------[private typedef]-----------------------------*/
 
+#if defined CFG_PERF_FUNC
+/* Function timestamps. On the linux board CLOCK_MONOTONIC_RAW in ns, else the
+ * free running timer. Differences are always in ns. */
+#if defined(USE_LINUXOS) && !defined(_WIN32)
+#define PERF_STAMP_DIFF_NS(_start, _end)    ((uint32)((_end) - (_start)))
+#else
+#define PERF_STAMP_DIFF_NS(_start, _end)    ((uint32)TIMER_TICK2NS((uint64)(TimerTick)((_end) - (_start))))
+#endif
+#endif
+
+/* ----------------------------[private typedef]-----------------------------*/
 
 #if defined CFG_PERF_FUNC
-typedef struct StatTick_Type {
-	TickType avg;
-	TickType total;
-	TickType min;
-	TickType max;
-}StatTickType;
+#if defined(USE_LINUXOS) && !defined(_WIN32)
+typedef uint64 Perf_StampType;
+#else
+typedef TimerTick Perf_StampType;
+#endif
+
+typedef struct Perf_NsStat {
+    uint32 cnt;
+    uint32 min_ns;
+    uint32 max_ns;
+    uint64 sum_ns;
+    uint32 hist[PERF_HIST_BUCKETS]; /* Bucket 0 is 0 ns, bucket n is [2^(n-1), 2^n) ns */
+} Perf_NsStatType;
+
+typedef struct Perf_FuncInfo {
+    char name[MAX_NAME_CHAR_LEN];
+    uint32 invokedCnt;
+    uint32 errorCnt;            /* Unbalanced Pre/Post calls or too deep nesting */
+    uint8 load;                 /* Active time in % of the last trigger period */
+    boolean invoked;
+    Perf_StampType prevInvoke;
+    uint64 periodActive_ns;     /* Active time since the last Perf_Trigger() */
+    Perf_NsStatType active;     /* Entry to exit, excluding preemption, ISRs and nested functions */
+    Perf_NsStatType invokePeriod; /* Between two consecutive entries */
+    Perf_NsStatType entryExit;  /* Entry to exit, wall time */
+} Perf_FuncInfoType;
+
+/* One running function measurement. Kept per task so that the same function
+ * may be measured in several tasks at once. */
+typedef struct Perf_Frame {
+    uint16 funcIdx;
+    Perf_StampType invoke;      /* Perf_PreFunctionHook() */
+    Perf_StampType start;       /* Start of the current active slice */
+    uint64 isrStart_ns;         /* Perf_IsrTime_ns at the start of the slice */
+    uint32 active_ns;           /* Active time of the finished slices */
+} Perf_FrameType;
+
+typedef struct Perf_FuncStack {
+    uint8 depth;
+    Perf_FrameType frame[PERF_NEST_DEPTH_MAX];
+} Perf_FuncStackType;
 #endif
 
 typedef struct Perf_Info_S {
@@ -71,21 +121,6 @@ typedef struct Perf_Info_S {
     int8_t called;
 	TickType timeStart;
 
-#if defined CFG_PERF_FUNC
-	/* Active PerfFuncIdx in the Task
-	 * Default activeFunc=0xFF -> No active Function * */
-	uint8_t activeFunc;
-
-	TickType invokeTime; // Tick at which Perf_Prefunction is Called
-	TickType prev_invokeTime; // Last time Tick at which Perf_Prefunction is Called
-	TickType timeActive;
-	uint32_t invokedcnt_trig;
-
-	StatTickType activePeriod_us; // Period between pre_func - post_func: ONLY active period (when task was running)
-	StatTickType invokePeriod_us; // Period between consecutive invocations of pre_func
-	StatTickType entryExitPeriod_us; // Period between pre_func and post_func
-#endif
-
 } Perf_InfoType;
 
 struct Perf_Sum {
@@ -126,8 +161,13 @@ Perf_InfoType Perf_IsrTimers[OS_ISR_MAX_CNT];
 struct Perf_Total Perf_Stats;
 
 #if defined CFG_PERF_FUNC
-Perf_InfoType Perf_FunctionTimers[MAX_FUNCTION_CNT];
-uint8 PERF_FUNCTION_CNT = 0;
+Perf_FuncInfoType Perf_FunctionTimers[PERF_FUNCTION_CNT_MAX];
+Perf_NsStatType Perf_IsrExec[OS_ISR_MAX_CNT];
+static Perf_StampType Perf_IsrStart[OS_ISR_MAX_CNT];
+static Perf_FuncStackType Perf_FuncStack[OS_TASK_CNT];
+/* Time spent in (outermost) ISRs, subtracted from the function active time */
+static uint64 Perf_IsrTime_ns = 0;
+static uint8 Perf_IsrNest = 0;
 #endif
 
 
@@ -142,15 +182,17 @@ static ShellCmdT top_funcCmdInfo = {
 		shellCmdtop_func,
 		0,1,
 		"top_func",
-		"Stat about Function measurements (alpha version)\n",
+		"top_func [hist|csv]",
 	    " (*) Use Perf_PreFunctionHook; <Function>; Perf_PostFunctionHook; \n"
-		"     Active Time[us]: Time for which function was active (excludes time for which function is preempted) \n"
+		"     Active Time[ns]: Time for which function was active (excludes time for which function is\n"
+		"                      preempted, ISRs and nested measured functions) \n"
 		"     Invoke Period[us]: Time between two consecutive invocations\n"
-		"     Entry-Exit Period[us]: Time between function entry and function exit (includes inactive time)\n"
+		"     Entry-Exit Period[ns]: Time between function entry and function exit (includes inactive time)\n"
 		"     Global Variable \"Perf_FunctionTimers\" for complete stats \n"
-		"     Average and Load are calculated over trigger period, and Min,Max over entire time\n"
-	    "     Warning: No nested calls for Perf_FunctionHook\n"
-		"     Warning: Higher CPU load\n",
+		"     Load is calculated over trigger period, Average, Min and Max over entire time\n"
+		" hist - Active time histograms of functions and ISRs, bucket n is [2^(n-1), 2^n) ns\n"
+		" csv  - All statistics as CSV\n"
+		"     Warning: Higher CPU load\n"
 		"     Warning: Supports functions in tasks only (no ISR)\n",
 		{NULL}
 };
@@ -161,8 +203,12 @@ static ShellCmdT topCmdInfo = {
     shellCmdTop,
     0,1,
     "top",
-    "top",
+    "top [hist]",
     "List CPU load\n"
+#if defined(USE_LINUXOS) && !defined(_WIN32)
+    " hist - Response, jitter and execution time histograms per task.\n"
+    "        Bucket n holds times in [2^(n-1), 2^n) us.\n"
+#endif
     " (*) The total will never be 100% since calculation times\n"
     "     are floored and time between measuring points is not\n"
     "     measured.\n",
@@ -172,6 +218,101 @@ static ShellCmdT topCmdInfo = {
 
 /* ----------------------------[private functions]---------------------------*/
 
+#if defined CFG_PERF_FUNC
+static inline Perf_StampType Perf_GetStamp(void) {
+#if defined(USE_LINUXOS) && !defined(_WIN32)
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return ((uint64)ts.tv_sec * 1000000000uLL) + (uint64)ts.tv_nsec;
+#else
+    return Timer_GetTicks();
+#endif
+}
+
+static void Perf_NsStatAdd(Perf_NsStatType *stat, uint32 ns) {
+    uint32 v = ns;
+    uint32 idx = 0;
+
+    while ((v != 0) && (idx < (PERF_HIST_BUCKETS - 1u))) {
+        v >>= 1;
+        idx++;
+    }
+    stat->hist[idx]++;
+    if ((stat->cnt == 0) || (ns < stat->min_ns)) {
+        stat->min_ns = ns;
+    }
+    if (ns > stat->max_ns) {
+        stat->max_ns = ns;
+    }
+    stat->sum_ns += ns;
+    stat->cnt++;
+}
+
+/* End an active slice of a function: preempted, nested call or exit */
+static void Perf_FramePause(Perf_FrameType *frame, Perf_StampType now) {
+    uint32 slice = PERF_STAMP_DIFF_NS(frame->start, now);
+    uint32 isr = (uint32)(Perf_IsrTime_ns - frame->isrStart_ns);
+
+    frame->active_ns += (slice > isr) ? (slice - isr) : 0u;
+}
+
+static void Perf_FrameResume(Perf_FrameType *frame, Perf_StampType now) {
+    frame->start = now;
+    frame->isrStart_ns = Perf_IsrTime_ns;
+}
+#endif
+
+#if defined(CFG_SHELL) && defined(USE_LINUXOS) && !defined(_WIN32)
+static void printTaskTiming(void) {
+    Linos_TaskStatsType stats;
+
+    puts("                 act  miss   response[us]     jitter[us]    exec[us]\n");
+    puts("Task name                   avg  p99<   max       max       avg    max\n");
+    puts("-----------------------------------------------------------------------------\n");
+    for (int i = 0; i < OS_TASK_CNT; i++) {
+        Linos_GetTaskStats(i, &stats);
+        if (stats.activateCnt == 0) {
+            continue;
+        }
+        printf("  %-14s %5u %4u %6u %6u %6u    %6u    %6u %6u\n",
+                Perf_TaskTimers[i].name,
+                stats.activateCnt,
+                stats.deadlineMissCnt,
+                (stats.completeCnt != 0) ? (uint32)((stats.response.sum_ns / stats.completeCnt) / 1000u) : 0u,
+                Linos_HistPercentile_us(&stats.response, 990u),
+                stats.response.max_ns / 1000u,
+                stats.jitter.max_ns / 1000u,
+                (stats.completeCnt != 0) ? (uint32)((stats.exec.sum_ns / stats.completeCnt) / 1000u) : 0u,
+                stats.exec.max_ns / 1000u);
+    }
+    puts("\n");
+}
+
+static void printHist(const char *name, const Linos_HistType *hist) {
+    printf("    %-9s", name);
+    for (uint32 b = 0; b < LINOS_HIST_BUCKETS; b++) {
+        printf(" %u", hist->bucket[b]);
+    }
+    puts("\n");
+}
+
+static void printTaskHist(void) {
+    Linos_TaskStatsType stats;
+
+    for (int i = 0; i < OS_TASK_CNT; i++) {
+        Linos_GetTaskStats(i, &stats);
+        if (stats.activateCnt == 0) {
+            continue;
+        }
+        printf("  %s\n", Perf_TaskTimers[i].name);
+        printHist("response", &stats.response);
+        printHist("jitter", &stats.jitter);
+        printHist("exec", &stats.exec);
+    }
+}
+#endif
+
 #if defined(CFG_SHELL)
 /*
  *
@@ -219,7 +360,34 @@ static int shellCmdTop(int argc, char *argv[] ) {
 
         printf("\nTotal%%: %d (*) See help\n\n",totalPerc);
 
+#if defined(USE_LINUXOS) && !defined(_WIN32)
+        {
+            Linos_TimerStatsType tickStats;
+            Linos_GetTimerStats(&tickStats);
+
+            puts("OS tick   period[ns]    ticks overruns  missed dropped\n");
+            puts("--------------------------------------------------\n");
+            printf("          %10u %8llu %8u %7u %7u\n",
+                    tickStats.tickPeriod_ns,
+                    (unsigned long long)tickStats.tickCnt,
+                    tickStats.overrunCnt,
+                    tickStats.missedTickCnt,
+                    tickStats.droppedTickCnt);
+            printf("  drift[us] last %u avg %u max %u\n\n",
+                    tickStats.lateLast_ns / 1000u,
+                    (tickStats.tickCnt > tickStats.missedTickCnt) ?
+                        (uint32)((tickStats.lateSum_ns / (tickStats.tickCnt - tickStats.missedTickCnt)) / 1000u) : 0u,
+                    tickStats.lateMax_ns / 1000u);
+        }
+        printTaskTiming();
+#endif
+
     } else {
+#if defined(USE_LINUXOS) && !defined(_WIN32)
+        if (strcmp(argv[1], "hist") == 0) {
+            printTaskHist();
+        }
+#endif
     }
 
     return 0;
@@ -229,29 +397,55 @@ static int shellCmdTop(int argc, char *argv[] ) {
 
 
 #if defined CFG_PERF_FUNC
+static void printFuncHist(const char *name, const Perf_NsStatType *stat) {
+    printf("  %-16s", name);
+    for (uint32 b = 0; b < PERF_HIST_BUCKETS; b++) {
+        printf(" %u", stat->hist[b]);
+    }
+    puts("\n");
+}
+
 static int shellCmdtop_func(int argc, char *argv[] ){
 
 	if(argc == 1 ) {
-		puts("               		Active Time[uS] |  Invoke Period[uS]|  Entry-Exit Period[uS] | Load \n");
-		puts("Function name  		avg   min   max |  avg   min   max  |  avg     min     max   | [%]  \n");
-		puts("--------------------------------------------------------------------------------------\n");
-
-		for (int i = 0; i < PERF_FUNCTION_CNT; i++) {
-
-			printf("  %-16s     %5d %5d %5d| %5d %5d %5d | %5d  %5d  %5d    | %2d\n",Perf_FunctionTimers[i].name,
-					Perf_FunctionTimers[i].activePeriod_us.avg,
-					Perf_FunctionTimers[i].activePeriod_us.min,
-					Perf_FunctionTimers[i].activePeriod_us.max,
-					Perf_FunctionTimers[i].invokePeriod_us.avg,
-					Perf_FunctionTimers[i].invokePeriod_us.min,
-					Perf_FunctionTimers[i].invokePeriod_us.max,
-					Perf_FunctionTimers[i].entryExitPeriod_us.avg,
-					Perf_FunctionTimers[i].entryExitPeriod_us.min,
-					Perf_FunctionTimers[i].entryExitPeriod_us.max,
-					Perf_FunctionTimers[i].load);
+		puts("                     Active Time[ns]        | Invoke Period[us]   |  Entry-Exit Period[ns]     | Load err\n");
+		puts("Function name       avg     min      max    |  avg    min    max  |  avg      min      max    | [%]     \n");
+		puts("---------------------------------------------------------------------------------------------------------\n");
+
+		for (int i = 0; i < PERF_FUNCTION_CNT_MAX; i++) {
+			Perf_FuncInfoType *f = &Perf_FunctionTimers[i];
+
+			if ((f->name[0] == '\0') && (f->invokedCnt == 0)) {
+				continue;
+			}
+			printf("  %-14s %7u %7u %8u | %6u %6u %6u | %7u %8u %8u | %3d %3u\n",f->name,
+					(f->active.cnt != 0) ? (uint32)(f->active.sum_ns / f->active.cnt) : 0u,
+					f->active.min_ns,
+					f->active.max_ns,
+					(f->invokePeriod.cnt != 0) ? (uint32)((f->invokePeriod.sum_ns / f->invokePeriod.cnt) / 1000u) : 0u,
+					f->invokePeriod.min_ns / 1000u,
+					f->invokePeriod.max_ns / 1000u,
+					(f->entryExit.cnt != 0) ? (uint32)(f->entryExit.sum_ns / f->entryExit.cnt) : 0u,
+					f->entryExit.min_ns,
+					f->entryExit.max_ns,
+					f->load,
+					f->errorCnt);
 		}
 
-
+	} else if (strcmp(argv[1], "hist") == 0) {
+		puts("Active time histograms, bucket 0: 0ns, bucket n: [2^(n-1), 2^n) ns\n");
+		for (int i = 0; i < PERF_FUNCTION_CNT_MAX; i++) {
+			if (Perf_FunctionTimers[i].active.cnt != 0) {
+				printFuncHist(Perf_FunctionTimers[i].name, &Perf_FunctionTimers[i].active);
+			}
+		}
+		for (int i = 0; i < Os_Arc_GetIsrCount(); i++) {
+			if (Perf_IsrExec[i].cnt != 0) {
+				printFuncHist(Perf_IsrTimers[i].name, &Perf_IsrExec[i]);
+			}
+		}
+	} else if (strcmp(argv[1], "csv") == 0) {
+		Perf_PrintCsv();
 	} else {
 	}
 
@@ -282,10 +476,6 @@ void Perf_Init(void) {
 	for (int i = 0; i < OS_TASK_CNT; i++) {
 		Os_Arc_GetTaskInfo(&pcb,i,OS_ARC_F_TASK_ALL);
 		memcpy(Perf_TaskTimers[i].name,pcb.name,16);
-#if defined CFG_PERF_FUNC
-		Perf_TaskTimers[i].activeFunc = NO_ACTIVE_FUNCTION;
-		PERF_FUNCTION_CNT = 0;
-#endif
 	}
 	for (int i = 0; i < Os_Arc_GetIsrCount(); i++) {
 		Os_Arc_GetIsrInfo(&pcb,i);
@@ -373,31 +563,13 @@ void Perf_Trigger(void) {
 
 
 #if defined CFG_PERF_FUNC
-	for (int i = 0; i < PERF_FUNCTION_CNT; i++){
-
-
-		Perf_FunctionTimers[i].invokePeriod_us.avg = (Perf_FunctionTimers[i].invokePeriod_us.total/
-						(Perf_FunctionTimers[i].invokedcnt_trig-1)); // -1 to compenset for not calculating for 1st cnt
-		/* Subtract number of time pre_func was called but not the post_func for
-		 * correct number of times the period was measured*/
-		Perf_FunctionTimers[i].activePeriod_us.avg = Perf_FunctionTimers[i].activePeriod_us.total/
-				(Perf_FunctionTimers[i].invokedcnt_trig-Perf_FunctionTimers[i].called);
-		Perf_FunctionTimers[i].entryExitPeriod_us.avg = Perf_FunctionTimers[i].entryExitPeriod_us.total/
-				(Perf_FunctionTimers[i].invokedcnt_trig-Perf_FunctionTimers[i].called);
-
-		/* Load for this period		 */
-		Perf_FunctionTimers[i].load = Perf_FunctionTimers[i].activePeriod_us.total*100 / Perf_Stats.timeLastPeriod_us;
-
-		/*Clear Totals for new trigger*/
-		Perf_FunctionTimers[i].activePeriod_us.total = 0;
-		Perf_FunctionTimers[i].invokePeriod_us.total = 0;
-		Perf_FunctionTimers[i].entryExitPeriod_us.total = 0;
-		Perf_FunctionTimers[i].invokedcnt_trig = 0;
-		Perf_FunctionTimers[i].prev_invokeTime = 0;
-		Perf_FunctionTimers[i].timePeriodTotal_us=0;
-		Perf_FunctionTimers[i].timeActive=0;
+	for (int i = 0; i < PERF_FUNCTION_CNT_MAX; i++){
+		/* Load for this period */
+		if (Perf_Stats.timeLastPeriod_us != 0) {
+			Perf_FunctionTimers[i].load = (uint8)((Perf_FunctionTimers[i].periodActive_ns / 10u) / Perf_Stats.timeLastPeriod_us);
+		}
+		Perf_FunctionTimers[i].periodActive_ns = 0;
 	}
-
 #endif
 
 	ResumeAllInterrupts();
@@ -413,6 +585,10 @@ void Os_PreIsrHook(ISRType isr) {
     Perf_IsrTimers[isr].invokedCnt++;
     Perf_IsrTimers[isr].called++;
     Perf_IsrTimers[isr].timeStart = Timer_GetTicks();
+#if defined CFG_PERF_FUNC
+    Perf_IsrNest++;
+    Perf_IsrStart[isr] = Perf_GetStamp();
+#endif
 
 }
 
@@ -423,6 +599,15 @@ void Os_PreIsrHook(ISRType isr) {
 void Os_PostIsrHook(ISRType isr) {
     TickType diff;
 
+#if defined CFG_PERF_FUNC
+    uint32 diff_ns = PERF_STAMP_DIFF_NS(Perf_IsrStart[isr], Perf_GetStamp());
+
+    Perf_NsStatAdd(&Perf_IsrExec[isr], diff_ns);
+    Perf_IsrNest--;
+    if (Perf_IsrNest == 0) {
+        Perf_IsrTime_ns += diff_ns;
+    }
+#endif
     diff = TIMER_TICK2US(Timer_GetTicks() - Perf_IsrTimers[isr].timeStart);
     if (diff > Perf_IsrTimers[isr].timeMax_us) {
         Perf_IsrTimers[isr].timeMax_us = diff;
@@ -448,9 +633,9 @@ void PreTaskHook(void) {
 
 #if defined CFG_PERF_FUNC
 	/*Perf_Func
-	 * If switching task during execution of perf_function	 */
-	if ( Perf_TaskTimers[task].activeFunc < MAX_FUNCTION_CNT){
-		Perf_FunctionTimers[Perf_TaskTimers[task].activeFunc].timeStart = Timer_GetTicks();
+	 * If switching back to a task during execution of perf_function	 */
+	if (Perf_FuncStack[task].depth != 0) {
+		Perf_FrameResume(&Perf_FuncStack[task].frame[Perf_FuncStack[task].depth - 1u], Perf_GetStamp());
 	}
 #endif
 
@@ -474,48 +659,40 @@ void PostTaskHook(void) {
 #if defined CFG_PERF_FUNC
 	/*Perf_Func
 	 * If switching task during execution of perf_function	 */
-	uint8 PerfFuncIdx;
-	PerfFuncIdx = Perf_TaskTimers[task].activeFunc;
-	if ( PerfFuncIdx < MAX_FUNCTION_CNT){
-		TickType diff;
-		/* */
-		diff = (Timer_GetTicks() - Perf_FunctionTimers[PerfFuncIdx].timeStart);
-		Perf_FunctionTimers[PerfFuncIdx].timeActive += diff;   		// Time since start in ticks
-
+	if (Perf_FuncStack[task].depth != 0) {
+		Perf_FramePause(&Perf_FuncStack[task].frame[Perf_FuncStack[task].depth - 1u], Perf_GetStamp());
 	}
 #endif
 }
 
 #if defined CFG_PERF_FUNC
 /* Logic: measurement of active time in function measurements
- * start timer when pre_func_hook called. reset timeActive (timeActive = active time between pre_func and post func)
- * when task is preemted by another task, in posttaskhook check if there is any function measurement active.
- * If function measurement is active when task is switched, then add time diff to timeActive (this is active time).
- * when this task is switched back to, check if there was any active function when this was switched from.
- * If there there was function active then, start time measurement for that function.
- * Note: No nested function hook calls allowed.
+ * Each task has a stack of running measurements (frames). Perf_PreFunctionHook
+ * pushes a frame and pauses the frame of the calling measured function,
+ * Perf_PostFunctionHook pops it and resumes the caller. The frame on top of the
+ * stack is paused in PostTaskHook when the task is switched out and resumed in
+ * PreTaskHook. Time spent in ISRs during an active slice is subtracted.
+ * So the active time is the exclusive time of the function itself.
+ * On LinuxOs the task switch hooks are not called, there active time includes
+ * the time the thread was preempted by other threads.
  * **/
 
 
 /*
- * Optional API, add a name to the Perf_InfoType for usability.
+ * Optional API, add a name to the Perf_FuncInfoType for usability.
  * @param PerfFuncIdx
  * @param PerfNamePtr
  * @param PerfNameLen
  */
-void Perf_InstallFunctionName(uint8 PerfFuncIdx, char *PerfNamePtr, uint8 PerfNameLen) {
+void Perf_InstallFunctionName(uint16 PerfFuncIdx, char *PerfNamePtr, uint8 PerfNameLen) {
 
     if((PerfNameLen < MAX_NAME_CHAR_LEN) &&
-            (PerfFuncIdx < MAX_FUNCTION_CNT))
+            (PerfFuncIdx < PERF_FUNCTION_CNT_MAX))
     {
         for (uint8 i = 0; i < PerfNameLen; i++) {
             Perf_FunctionTimers[PerfFuncIdx].name[i] = PerfNamePtr[i];
         }
-        /*Init default min value*/
-        Perf_FunctionTimers[PerfFuncIdx].activePeriod_us.min = MAX_VAL_INIT;
-        Perf_FunctionTimers[PerfFuncIdx].invokePeriod_us.min = MAX_VAL_INIT;
-        Perf_FunctionTimers[PerfFuncIdx].entryExitPeriod_us.min = MAX_VAL_INIT;
-        PERF_FUNCTION_CNT++;
+        Perf_FunctionTimers[PerfFuncIdx].name[PerfNameLen] = '\0';
     }
 }
 
@@ -523,74 +700,124 @@ void Perf_InstallFunctionName(uint8 PerfFuncIdx, char *PerfNamePtr, uint8 PerfNa
  * Call before the functions for measurement is called.
  * @param PerfFuncIdx
  */
-void Perf_PreFunctionHook(uint8 PerfFuncIdx) {
+void Perf_PreFunctionHook(uint16 PerfFuncIdx) {
 	TaskType task;
-	TickType diff;
+	Perf_FuncStackType *stack;
+	Perf_FrameType *frame;
+	Perf_FuncInfoType *func;
+	Perf_StampType now;
 
 	GetTaskID(&task);
 
-    if (PerfFuncIdx < MAX_FUNCTION_CNT) {
-        Perf_FunctionTimers[PerfFuncIdx].invokedCnt++;
-        Perf_FunctionTimers[PerfFuncIdx].invokedcnt_trig++;
-        Perf_FunctionTimers[PerfFuncIdx].called++;
-        Perf_FunctionTimers[PerfFuncIdx].timeStart = Timer_GetTicks(); // Called every preFunc and preTask(if active task)
-		Perf_FunctionTimers[PerfFuncIdx].timeActive = 0; // Reset time spent in function active only!
-
-		/*invoked_Period */
-		Perf_FunctionTimers[PerfFuncIdx].invokeTime = Perf_FunctionTimers[PerfFuncIdx].timeStart; // Called at preFunc in OS_TICK
-		if (Perf_FunctionTimers[PerfFuncIdx].invokedcnt_trig > 1){ // dont have prev value at 1st cnt
-			diff= TIMER_TICK2US(Perf_FunctionTimers[PerfFuncIdx].invokeTime - Perf_FunctionTimers[PerfFuncIdx].prev_invokeTime);
-			Perf_FunctionTimers[PerfFuncIdx].invokePeriod_us.total += diff;
-			Perf_FunctionTimers[PerfFuncIdx].invokePeriod_us.min = MIN(diff,Perf_FunctionTimers[PerfFuncIdx].invokePeriod_us.min);
-			Perf_FunctionTimers[PerfFuncIdx].invokePeriod_us.max = MAX(diff,Perf_FunctionTimers[PerfFuncIdx].invokePeriod_us.max);
-		}
-		Perf_FunctionTimers[PerfFuncIdx].prev_invokeTime = Perf_FunctionTimers[PerfFuncIdx].invokeTime;
+    if ((PerfFuncIdx >= PERF_FUNCTION_CNT_MAX) || (task >= OS_TASK_CNT)) {
+        return;
+    }
 
-		/* Active function*/
-		if (Perf_TaskTimers[task].activeFunc == NO_ACTIVE_FUNCTION){
-			Perf_TaskTimers[task].activeFunc = PerfFuncIdx; // Set current function as active function
-		}
-		else {
-			/* ERROR!!
-			 * If already an active function -> ignore this active function. We don't support nested function*/
-		}
+    now = Perf_GetStamp();
+    func = &Perf_FunctionTimers[PerfFuncIdx];
+    stack = &Perf_FuncStack[task];
+
+    func->invokedCnt++;
+    if (func->invoked) {
+        Perf_NsStatAdd(&func->invokePeriod, PERF_STAMP_DIFF_NS(func->prevInvoke, now));
+    }
+    func->prevInvoke = now;
+    func->invoked = TRUE;
+
+    if (stack->depth >= PERF_NEST_DEPTH_MAX) {
+        func->errorCnt++;
+        return;
     }
+
+    /* The caller is not active while the nested function runs */
+    if (stack->depth != 0) {
+        Perf_FramePause(&stack->frame[stack->depth - 1u], now);
+    }
+
+    frame = &stack->frame[stack->depth];
+    frame->funcIdx = PerfFuncIdx;
+    frame->invoke = now;
+    frame->active_ns = 0;
+    Perf_FrameResume(frame, now);
+    stack->depth++;
 }
 
 
 /*
  * Call after the function for measurement has been executed.
  * @param PerfFuncIdx
- * No nested calls for perf_function
  */
-void Perf_PostFunctionHook(uint8 PerfFuncIdx) {
-    TickType diff;
+void Perf_PostFunctionHook(uint16 PerfFuncIdx) {
 	TaskType task;
+	Perf_FuncStackType *stack;
+	Perf_FrameType *frame;
+	Perf_FuncInfoType *func;
+	Perf_StampType now;
 
 	GetTaskID(&task);
 
-    if (PerfFuncIdx < MAX_FUNCTION_CNT) {
+    if ((PerfFuncIdx >= PERF_FUNCTION_CNT_MAX) || (task >= OS_TASK_CNT)) {
+        return;
+    }
 
-    	/* Time spent during in function when active only. in ticks*/
-        Perf_FunctionTimers[PerfFuncIdx].timeActive += Timer_GetTicks() - Perf_FunctionTimers[PerfFuncIdx].timeStart;
-        diff = TIMER_TICK2US(Perf_FunctionTimers[PerfFuncIdx].timeActive);
+    now = Perf_GetStamp();
+    func = &Perf_FunctionTimers[PerfFuncIdx];
+    stack = &Perf_FuncStack[task];
 
-        Perf_FunctionTimers[PerfFuncIdx].timePeriodTotal_us += diff; 	//Time since Last trigger in uS
-        Perf_FunctionTimers[PerfFuncIdx].timeTotal_us += diff; 	//Time since begining in uS
-        Perf_FunctionTimers[PerfFuncIdx].called--;
+    if ((stack->depth == 0) || (stack->frame[stack->depth - 1u].funcIdx != PerfFuncIdx)) {
+        /* Not the innermost running measurement */
+        func->errorCnt++;
+        return;
+    }
 
-		/* time spent in function active period only*/
-		Perf_FunctionTimers[PerfFuncIdx].activePeriod_us.total+= diff;
-		Perf_FunctionTimers[PerfFuncIdx].activePeriod_us.min = MIN(diff, Perf_FunctionTimers[PerfFuncIdx].activePeriod_us.min);
-		Perf_FunctionTimers[PerfFuncIdx].activePeriod_us.max = MAX(diff, Perf_FunctionTimers[PerfFuncIdx].activePeriod_us.max);
+    stack->depth--;
+    frame = &stack->frame[stack->depth];
+    Perf_FramePause(frame, now);
 
-		/* entry_exit_period*/
-		diff = TIMER_TICK2US(Timer_GetTicks() - Perf_FunctionTimers[PerfFuncIdx].invokeTime);
-		Perf_FunctionTimers[PerfFuncIdx].entryExitPeriod_us.total+= diff;
-		Perf_FunctionTimers[PerfFuncIdx].entryExitPeriod_us.min = MIN(diff, Perf_FunctionTimers[PerfFuncIdx].entryExitPeriod_us.min);
-		Perf_FunctionTimers[PerfFuncIdx].entryExitPeriod_us.max = MAX(diff, Perf_FunctionTimers[PerfFuncIdx].entryExitPeriod_us.max);
+    Perf_NsStatAdd(&func->active, frame->active_ns);
+    Perf_NsStatAdd(&func->entryExit, PERF_STAMP_DIFF_NS(frame->invoke, now));
+    func->periodActive_ns += frame->active_ns;
 
-		Perf_TaskTimers[task].activeFunc = NO_ACTIVE_FUNCTION; // Clear active function from task
+    if (stack->depth != 0) {
+        Perf_FrameResume(&stack->frame[stack->depth - 1u], now);
+    }
+}
+
+static void Perf_PrintCsvStat(const char *type, const char *name, const char *metric, const Perf_NsStatType *stat) {
+    printf("%s,%s,%s,%u,%u,%u,%u", type, name, metric, stat->cnt,
+            stat->min_ns,
+            (stat->cnt != 0) ? (uint32)(stat->sum_ns / stat->cnt) : 0u,
+            stat->max_ns);
+    for (uint32 b = 0; b < PERF_HIST_BUCKETS; b++) {
+        printf(",%u", stat->hist[b]);
+    }
+    printf("\n");
+}
+
+/*
+ * All times in ns, hist0..histN are the log2 buckets, see PERF_HIST_BUCKETS.
+ */
+void Perf_PrintCsv(void) {
+    printf("type,name,metric,count,min_ns,avg_ns,max_ns");
+    for (uint32 b = 0; b < PERF_HIST_BUCKETS; b++) {
+        printf(",hist%u", b);
+    }
+    printf("\n");
+
+    for (int i = 0; i < PERF_FUNCTION_CNT_MAX; i++) {
+        Perf_FuncInfoType *f = &Perf_FunctionTimers[i];
+
+        if (f->invokedCnt == 0) {
+            continue;
+        }
+        Perf_PrintCsvStat("func", f->name, "active", &f->active);
+        Perf_PrintCsvStat("func", f->name, "entry_exit", &f->entryExit);
+        Perf_PrintCsvStat("func", f->name, "invoke_period", &f->invokePeriod);
+    }
+    for (int i = 0; i < Os_Arc_GetIsrCount(); i++) {
+        if (Perf_IsrExec[i].cnt != 0) {
+            Perf_PrintCsvStat("isr", Perf_IsrTimers[i].name, "exec", &Perf_IsrExec[i]);
+        }
     }
 }
 #endif
@@ -13,95 +13,351 @@
  *-------------------------------- Arctic Core -----------------------------*/
 
 /**
- * A very simple ramlog.
+ * A lock-free ramlog.
  *
  * Features:
- * - Prints to a ram space in section ".ramlog"
- * - The size is configurable using CFG_RAMLOG_SIZE (default is 1000)
+ * - Logs to a ram space in section ".ramlog"
+ * - The size is configurable using CFG_RAMLOG_SIZE (default is 2048 bytes)
  * - The ramlog section should not be cleared by the linkfile if one wants
  *   to have a ramlog that survives reset.
- * - Session support
+ * - Session support (CFG_RAMLOG_SESSION)
+ * - Any number of writers (tasks, ISRs, cores, threads) without locks
  *
- * Assumes some c-lib support:
- * - The clib support should be able to open a file called "ramlog".
- * - Printing to that file will print to the ramlog.
+ * Text written with ramlog_printf(), ramlog_puts(), the "ramlog" file or
+ * the ramlog console device and binary records, e.g. Det errors, share
+ * the log.
  *
- * HEADER
+ * CAPACITY
  *
- *   The ramlog uses a very simple header.
+ *   The ring has CFG_RAMLOG_SIZE / 32 - 1 slots of 20 data bytes, a record
+ *   of n bytes takes (n + 19) / 20 slots. The default 2048 bytes are 63
+ *   slots, about 1200 bytes of text or 63 Det errors. Text is written as one
+ *   record per line (at most 160 bytes), see ramlog_write().
  *
- *  Byte   0    1    2    3
- *       +----+----+----+----+
- *       | 01 |CNT | X  |    |
- *       +----+----+----+----+
+ * LAYOUT
  *
- *   Byte 0 is 01
- *   Byte 1 is a counter that incremented for each time the ramlog is started.
- *   Byte 2 is not defined yet.
- *   Byte 3 is 01
+ *   The log is a header followed by a ring of 32 byte slots. A record is
+ *   one or more consecutive slots.
  *
- *   01 is used since it's control sign and not a printable char.
+ *   header  uint32 magic "RLOG", uint16 version, uint16 slot size,
+ *           uint32 slot count, uint32 time stamp frequency [Hz],
+ *           uint32 session, uint32 head, 8 bytes reserved
  *
- * STRATEGY FOR SESSION
- *   Cases:
- *   1. The ramlog is empty, ie the header is not there at first position
- *   2. The header is in first poistion
- *      - look for the next?
- *      - Use saved inforation?
+ *   slot    uint32 seq       position in the ring + 1, RAMLOG_SEQ_BUSY while
+ *                            written
+ *           uint32 time      time stamp of the record (wraps), us on linux,
+ *                            Timer ticks with CFG_RAMLOG_TIMER, else Os ticks
+ *           uint8  type      RAMLOG_REC_xxx
+ *           uint8  core
+ *           uint8  len       bytes used in data
+ *           uint8  cont      slots that follow in the same record
+ *           uint8  data[20]
  *
+ * WRITING
  *
+ *   A writer reserves all slots of a record with one atomic add of head.
+ *   It claims each slot by changing seq to RAMLOG_SEQ_BUSY with a CAS, fills
+ *   it and publishes seq last, with a CAS from RAMLOG_SEQ_BUSY. When the ring
+ *   is lapped while a slot is written, the writer of the other lap finds it
+ *   busy and skips it, which leaves its own record invalid instead of mixing
+ *   the data of two writers in the slot. Writers never wait for each other.
+ *
+ * READING
+ *
+ *   Records are in the ring positions [head - slot count, head). A slot at
+ *   position pos is valid when seq is pos + 1 both before and after it is
+ *   copied, anything else is a record still being written or one that has
+ *   been overwritten. A record is valid when all its slots are.
+ *   scripts/ramlog_dump.py prints a memory dump of the log in time order.
  */
 
 /*lint -w1 Only errors in generic module used during development */
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* sched_getcpu */
+#endif
+
 #include <stdio.h>
+#include <string.h>
 
 /*lint -save -e451 */
 #include <stdarg.h>
 /*lint -restore */
-#include "arc_assert.h"
+#include "Os.h"
 #include "Ramlog.h"
 #include "MemMap.h"
 #include "device_serial.h"
+#if defined(__linux__)
+#include <time.h>
+#include <sched.h>
+#elif defined(CFG_RAMLOG_TIMER)
+#include "timer.h"
+#endif
 
 #ifndef CFG_RAMLOG_SIZE
-#define CFG_RAMLOG_SIZE  2000
+#define CFG_RAMLOG_SIZE  2048
 #endif
 
-#define RAMLOG_MAGIC	  1
+#define RAMLOG_MAGIC        0x474F4C52uL    /* "RLOG" */
+#define RAMLOG_VERSION      2u
 
+#define RAMLOG_SLOT_SIZE    32u
+#define RAMLOG_SLOT_DATA    20u
+#define RAMLOG_SLOT_CNT     ((CFG_RAMLOG_SIZE / RAMLOG_SLOT_SIZE) - 1u)  /* One for the header */
+#define RAMLOG_REC_SLOTS    8u      /* Max slots of one record */
+#define RAMLOG_SEQ_BUSY     0xFFFFFFFFuL
 
-SECTION_RAMLOG static unsigned char ramlog[CFG_RAMLOG_SIZE];
+#define RAMLOG_PRINTF_MAX   128u
+#define RAMLOG_LINE_MAX     (RAMLOG_REC_SLOTS * RAMLOG_SLOT_DATA)
 
-#if defined(CFG_RAMLOG_SESSION)
-SECTION_RAMLOG static unsigned ramlog_curr;
-SECTION_RAMLOG static unsigned ramlog_session;
+#if !defined(__linux__) && !defined(OS_NUM_CORES)
+#define OS_NUM_CORES        1
+#endif
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t slotSize;
+    uint32_t slotCnt;
+    uint32_t freq;
+    uint32_t session;
+    uint32_t head;
+    uint32_t reserved[2];
+} ramlog_header_t;
+
+typedef struct {
+    uint32_t seq;
+    uint32_t time;
+    uint8_t type;
+    uint8_t core;
+    uint8_t len;
+    uint8_t cont;
+    uint8_t data[RAMLOG_SLOT_DATA];
+} ramlog_slot_t;
+
+typedef struct {
+    ramlog_header_t hdr;
+    ramlog_slot_t slot[RAMLOG_SLOT_CNT];
+} ramlog_t;
+
+SECTION_RAMLOG static ramlog_t ramlog;
+
+/* Text of a line not yet written */
+typedef struct {
+    uint32_t time;      /* Of the first part */
+    uint32_t len;
+    uint8_t data[RAMLOG_LINE_MAX];
+} ramlog_line_t;
+
+#if defined(__linux__)
+/* Per thread, not for signal handlers */
+static __thread ramlog_line_t ramlog_line;
+#else
+/* Per core, used with interrupts off */
+static ramlog_line_t ramlog_line[OS_NUM_CORES];
+#endif
+
+
+static inline uint32_t ramlog_time( void ) {
+#if defined(__linux__)
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(((uint64_t)ts.tv_sec * 1000000uLL) + ((uint64_t)ts.tv_nsec / 1000u));
+#elif defined(CFG_RAMLOG_TIMER)
+    return Timer_GetTicks();
+#else
+    return (uint32_t)GetOsTick();
+#endif
+}
+
+static inline uint8_t ramlog_core( void ) {
+#if defined(__linux__)
+    int cpu = sched_getcpu();
+    return (cpu < 0) ? 0u : (uint8_t)cpu;
+#else
+    return (uint8_t)GetCoreID();
+#endif
+}
+
+/* Ring position of the first of cnt slots */
+static inline uint32_t ramlog_reserve( uint32_t cnt ) {
+#if defined(__GNUC__)
+    return __atomic_fetch_add(&ramlog.hdr.head, cnt, __ATOMIC_RELAXED);
+#else
+    imask_t flags;
+    uint32_t pos;
+
+    Irq_Save(flags);
+    pos = ramlog.hdr.head;
+    ramlog.hdr.head += cnt;
+    Irq_Restore(flags);
+    return pos;
+#endif
+}
+
+/* seq of a written slot. Never RAMLOG_SEQ_BUSY, the one position that would
+ * give it is stored as 0 and reads as not valid. */
+static inline uint32_t ramlog_seq( uint32_t pos ) {
+    uint32_t seq = pos + 1u;
+    return (seq == RAMLOG_SEQ_BUSY) ? 0u : seq;
+}
+
+/* Take a slot for writing, FALSE if another writer is writing it */
+static inline boolean ramlog_claim( ramlog_slot_t *slot ) {
+    boolean rv = FALSE;
+#if defined(__GNUC__)
+    uint32_t old = __atomic_load_n(&slot->seq, __ATOMIC_RELAXED);
+
+    if ((old != RAMLOG_SEQ_BUSY) &&
+        __atomic_compare_exchange_n(&slot->seq, &old, RAMLOG_SEQ_BUSY, FALSE, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        /* A reader must not see the new data with the old seq */
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        rv = TRUE;
+    }
+#else
+    imask_t flags;
+
+    Irq_Save(flags);
+    if (slot->seq != RAMLOG_SEQ_BUSY) {
+        slot->seq = RAMLOG_SEQ_BUSY;
+        rv = TRUE;
+    }
+    Irq_Restore(flags);
+#endif
+    return rv;
+}
+
+/* Publish a claimed slot, unless it is no longer ours (ramlog_init()) */
+static inline void ramlog_publish( ramlog_slot_t *slot, uint32_t seq ) {
+#if defined(__GNUC__)
+    uint32_t busy = RAMLOG_SEQ_BUSY;
+
+    (void)__atomic_compare_exchange_n(&slot->seq, &busy, seq, FALSE, __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+#else
+    slot->seq = seq;
+#endif
+}
+
+/**
+ * Write one record.
+ *
+ * @param type RAMLOG_REC_xxx
+ * @param time
+ * @param data
+ * @param len At most RAMLOG_LINE_MAX bytes
+ */
+static void ramlog_record( uint8_t type, uint32_t time, const uint8_t *data, uint32_t len ) {
+    uint32_t cnt = (len + RAMLOG_SLOT_DATA - 1u) / RAMLOG_SLOT_DATA;
+    uint8_t core = ramlog_core();
+    uint32_t pos;
+    uint32_t i;
+
+    if (cnt == 0u) {
+        cnt = 1u;
+    }
+    pos = ramlog_reserve(cnt);
+
+    for (i = 0; i < cnt; i++) {
+        ramlog_slot_t *slot = &ramlog.slot[(pos + i) % RAMLOG_SLOT_CNT];
+        uint32_t n = (len > RAMLOG_SLOT_DATA) ? RAMLOG_SLOT_DATA : len;
+
+        if (ramlog_claim(slot)) {
+            slot->time = time;
+            slot->type = type;
+            slot->core = core;
+            slot->len = (uint8_t)n;
+            slot->cont = (uint8_t)(cnt - 1u - i);
+            memcpy(slot->data, data, n);
+            ramlog_publish(slot, ramlog_seq(pos + i));
+        }
+        data += n;
+        len -= n;
+    }
+}
+
+/**
+ * Write text to the ramlog.
+ *
+ * Text is collected per thread (linux) or per core until a newline or
+ * RAMLOG_LINE_MAX bytes and written as one record, so a line written in
+ * parts, e.g. ramlog_str() and ramlog_hex() calls, takes no more slots
+ * than if written at once. A line without newline is not in the log yet.
+ *
+ * @param buf
+ * @param len
+ */
+void ramlog_write( const char *buf, size_t len ) {
+    const uint8_t *data = (const uint8_t *)buf;
+    const uint8_t *nl;
+    ramlog_line_t *line;
+    uint32_t n;
+#if !defined(__linux__)
+    imask_t flags;
+
+    Irq_Save(flags);
+    line = &ramlog_line[GetCoreID()];
 #else
-static unsigned ramlog_curr = 0;
+    line = &ramlog_line;
 #endif
 
-static FILE *rFile;
+    while (len > 0u) {
+        n = RAMLOG_LINE_MAX - line->len;
+        if (len < n) {
+            n = (uint32_t)len;
+        }
+        nl = memchr(data, '\n', n);
+        if (nl != NULL) {
+            n = (uint32_t)(nl - data) + 1u;
+        }
+        if ((line->len == 0u) && ((nl != NULL) || (n == RAMLOG_LINE_MAX))) {
+            /* A whole line, no need to collect it */
+            ramlog_record(RAMLOG_REC_TEXT, ramlog_time(), data, n);
+        } else {
+            if (line->len == 0u) {
+                line->time = ramlog_time();
+            }
+            memcpy(&line->data[line->len], data, n);
+            line->len += n;
+            if ((nl != NULL) || (line->len == RAMLOG_LINE_MAX)) {
+                ramlog_record(RAMLOG_REC_TEXT, line->time, line->data, line->len);
+                line->len = 0u;
+            }
+        }
+        data += n;
+        len -= n;
+    }
 
-//#define RAMLOG_FILENO  (FILE *)3
+#if !defined(__linux__)
+    Irq_Restore(flags);
+#endif
+}
 
+/**
+ * Write a binary record to the ramlog.
+ *
+ * @param type RAMLOG_REC_DET or RAMLOG_REC_USER and above
+ * @param data
+ * @param len Truncated to 160 bytes
+ */
+void ramlog_bin( uint8_t type, const void *data, uint32_t len ) {
+    if (len > RAMLOG_LINE_MAX) {
+        len = RAMLOG_LINE_MAX;
+    }
+    ramlog_record(type, ramlog_time(), (const uint8_t *)data, len);
+}
 
 /**
  * Print a char to the ramlog
  * @param c
  */
 void ramlog_chr( char c ) {
-  ramlog[ramlog_curr++] = c;
-  if( ramlog_curr >= CFG_RAMLOG_SIZE ) {
-      ramlog_curr = 0;
-  }
+    ramlog_write(&c, 1u);
 }
 
 
 void ramlog_fputs(char *str) {
-
-    while (*str != 0) {
-        ramlog_chr(*str++);
-    }
+    ramlog_write(str, strlen(str));
 }
 
 /**
@@ -109,27 +365,28 @@ void ramlog_fputs(char *str) {
  * @param str
  */
 void ramlog_puts( char *str ) {
-
-    ramlog_fputs(str);
+    ramlog_write(str, strlen(str));
     ramlog_chr('\n');
 }
 
 /**
- * Formatted print for the ramlog.
+ * Formatted print for the ramlog. The output is truncated to
+ * RAMLOG_PRINTF_MAX - 1 characters.
  *
  * @param format The format string.
  */
 int ramlog_printf( const char *format, ... ) {
-    // Fast and ugly ramlog support.
-
-    volatile int rv;
+    char buf[RAMLOG_PRINTF_MAX];
+    int rv;
     va_list args;
-    va_start(args,format);
 
-    ASSERT( rFile != NULL );
-    rv = vfprintf(rFile, format, args);
+    va_start(args,format);
+    rv = vsnprintf(buf, sizeof(buf), format, args);
     va_end(args);
 
+    if (rv > 0) {
+        ramlog_write(buf, ((size_t)rv < sizeof(buf)) ? (size_t)rv : (sizeof(buf) - 1u));
+    }
     return rv;
 }
 
@@ -139,32 +396,51 @@ int ramlog_printf( const char *format, ... ) {
  */
 void ramlog_init( void )
 {
-    rFile = (FILE*)fopen("ramlog","r");
+    uint32_t session = 0;
 
 #if defined(CFG_RAMLOG_SESSION)
     char buf[32];
     /* Check for existing session */
-    if( (ramlog[0] != RAMLOG_MAGIC) || (ramlog[3] != RAMLOG_MAGIC) ) {
-        ramlog_curr = 0;
-        ramlog_session = 0;
+    if( (ramlog.hdr.magic == RAMLOG_MAGIC) && (ramlog.hdr.version == RAMLOG_VERSION) &&
+        (ramlog.hdr.slotCnt == RAMLOG_SLOT_CNT) ) {
+        uint32_t i;
+
+        session = ramlog.hdr.session;
+        /* Slots written at reset could otherwise never be claimed again */
+        for (i = 0; i < RAMLOG_SLOT_CNT; i++) {
+            if (ramlog.slot[i].seq == RAMLOG_SEQ_BUSY) {
+                ramlog.slot[i].seq = 0u;
+            }
+        }
     } else {
-        /*  Search the ramlog */
+        memset(&ramlog, 0, sizeof(ramlog));
     }
-    ramlog_session++;
-    simple_sprintf(buf, "Session (%d)\n", ramlog_session);
-    ramlog_puts(buf);
+#else
+    memset(&ramlog, 0, sizeof(ramlog));
+#endif
 
+    ramlog.hdr.version = RAMLOG_VERSION;
+    ramlog.hdr.slotSize = RAMLOG_SLOT_SIZE;
+    ramlog.hdr.slotCnt = RAMLOG_SLOT_CNT;
+#if defined(__linux__)
+    ramlog.hdr.freq = 1000000uL;
+#elif defined(CFG_RAMLOG_TIMER)
+    ramlog.hdr.freq = Timer_Freq;
 #else
-    (void)ramlog[0]; /* To avoid lint warning */
-    ramlog_curr = 0;
+    ramlog.hdr.freq = (uint32_t)OsTickFreq;
+#endif
+    ramlog.hdr.session = session + 1u;
+    ramlog.hdr.magic = RAMLOG_MAGIC;
+
+#if defined(CFG_RAMLOG_SESSION)
+    simple_sprintf(buf, "Session (%d)\n", ramlog.hdr.session);
+    ramlog_fputs(buf);
 #endif
 }
 
 static int Ramlog_Write(  uint8_t *data, size_t nbytes)
 {
-    for (unsigned int i = 0; i < nbytes; i++) {
-        ramlog_chr(*data++);
-    }
+    ramlog_write((const char *)data, nbytes);
     return nbytes;
 }
 
@@ -186,7 +462,3 @@ DeviceSerialType Ramlog_Device = {
     .write = Ramlog_Write,
     .open = Ramlog_Open,
 };
-
-
-
-
@@ -17,8 +17,8 @@
  *  Created on: 2009-apr-19
  *      Author: mahi
  *
- * System trace...
- * Idea to trace
+ * System trace. Task, ISR, user scope and exclusive area events are
+ * recorded as 16 byte records in one ring per core, see strace.h.
  *
  * Inspiration:
  *   http://ltt.polymtl.ca/tracingwiki/index.php/TracingBook
@@ -26,57 +26,277 @@
  *   http://benno.id.au/docs/lttng_data_format.pml
  */
 
-/*
- * Channel
- *
- * ISR
- * TASK
- *
- */
+/* ----------------------------[includes]------------------------------------*/
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* sched_getcpu */
+#endif
+
+#include "Os.h"
+#if defined(OS_TASK_CNT) || defined(USE_KERNEL)
+#include "arc.h"
+#endif
+#include "strace.h"
+#include <stdio.h>
+#include <string.h>
+#if defined(__linux__)
+#include <time.h>
+#include <sched.h>
+#else
+#include "timer.h"
+#endif
+
+/* ----------------------------[private define]------------------------------*/
 
-typedef enum {
-    STRACE_CH_ISR = 1,
-    STRACE_CH_TASK = (1<<1),
-    STRACE_CH_KERNEL = (1<<2),
-} strace_ch_t;
+#define STRACE_MAGIC        0x43525453uL    /* "STRC" */
+#define STRACE_VERSION      1u
 
-typedef enum {
-    STRACE_EV_ISR_START,
-    STRACE_EV_ISR_STOP,
-    STRACE_EV_TASK_START,
-    STRACE_EV_TASK_STOP,
-} strace_ev_t;
+#define STRACE_NAME_TASK    0u
+#define STRACE_NAME_ISR     1u
+#define STRACE_NAME_USER    2u
 
+#if (STRACE_RING_SIZE & (STRACE_RING_SIZE - 1u)) != 0
+#error STRACE_RING_SIZE must be a power of 2
+#endif
 
-struct strace_attr_s {
-    strace_ch_t
-    /* A timestamp in some unit */
-    uint32_t timestamp;
-};
+/* ----------------------------[private variables]---------------------------*/
 
+static strace_rec_t strace_ring[STRACE_CORE_MAX][STRACE_RING_SIZE];
+static uint32_t strace_head[STRACE_CORE_MAX];
+static const char *strace_names[STRACE_NAME_MAX];
+static uint32_t strace_name_cnt = 0;
+static boolean strace_enabled = FALSE;
+
+#if defined(__linux__)
+/* Task of the calling thread, set by its own TASK_START */
+static __thread uint16_t strace_ctx = STRACE_ID_NONE;
+#endif
+
+/* ----------------------------[private functions]---------------------------*/
+
+static inline uint64_t strace_timestamp( void ) {
+#if defined(__linux__)
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000uLL) + (uint64_t)ts.tv_nsec;
+#else
+    return Timer_GetTicks();
+#endif
+}
+
+static inline uint32_t strace_core( void ) {
+#if defined(__linux__)
+    int cpu = sched_getcpu();
+    return (cpu < 0) ? 0u : ((uint32_t)cpu % STRACE_CORE_MAX);
+#else
+    return (uint32_t)GetCoreID() % STRACE_CORE_MAX;
+#endif
+}
+
+/* Ring position for a new record */
+static inline uint32_t strace_reserve( uint32_t core ) {
+#if defined(__GNUC__)
+    return __atomic_fetch_add(&strace_head[core], 1u, __ATOMIC_RELAXED);
+#else
+    imask_t flags;
+    uint32_t pos;
+
+    Irq_Save(flags);
+    pos = strace_head[core]++;
+    Irq_Restore(flags);
+    return pos;
+#endif
+}
+
+/* ----------------------------[public functions]----------------------------*/
 
 /**
+ * Record an event.
  *
- * @param ch channel to record
+ * @param event
+ * @param id task, ISR or user scope id
  */
-void strace( strace_ev_t event) {
-    switch( ch ) {
-    case STRACE_CH_ISR:
-        break;
-    case STRACE_CH_TASK:
-        break;
+void strace( strace_ev_t event, uint16_t id ) {
+    strace_rec_t *rec;
+    uint32_t core;
+    uint32_t pos;
+
+    if (!strace_enabled) {
+        return;
     }
+
+    core = strace_core();
+    pos = strace_reserve(core);
+    rec = &strace_ring[core][pos & (STRACE_RING_SIZE - 1u)];
+
+    rec->valid = 0;
+    rec->timestamp = strace_timestamp();
+    rec->event = (uint8_t)event;
+    rec->core = (uint8_t)core;
+    rec->id = id;
+#if defined(__linux__)
+    if ((event == STRACE_EV_TASK_START) || (event == STRACE_EV_TASK_RESUME)) {
+        strace_ctx = id;
+    }
+    rec->ctx = strace_ctx;
+#else
+    rec->ctx = STRACE_ID_NONE;
+#endif
+#if defined(__GNUC__)
+    __atomic_store_n(&rec->valid, 1u, __ATOMIC_RELEASE);
+#else
+    rec->valid = 1u;
+#endif
 }
 
 /**
- * Channels to use.
+ * Clear the rings and start recording.
  */
-void strace_init( strace_ch_t ch ) {
+void strace_init( void ) {
+    strace_enabled = FALSE;
+    memset(strace_ring, 0, sizeof(strace_ring));
+    memset(strace_head, 0, sizeof(strace_head));
+    strace_enabled = TRUE;
+}
+
+uint16_t strace_register( const char *name ) {
+    uint32_t id;
+
+#if defined(__GNUC__)
+    id = __atomic_fetch_add(&strace_name_cnt, 1u, __ATOMIC_RELAXED);
+#else
+    imask_t flags;
 
+    Irq_Save(flags);
+    id = strace_name_cnt++;
+    Irq_Restore(flags);
+#endif
+    if (id >= STRACE_NAME_MAX) {
+        return STRACE_ID_NONE;
+    }
+    strace_names[id] = name;
+    return (uint16_t)id;
 }
 
-void strace_print( void ) {
+#if defined(__linux__)
+static void strace_put_name( FILE *f, uint8_t kind, uint16_t id, const char *name ) {
+    uint8_t len = (uint8_t)strnlen(name, 255u);
+
+    fwrite(&kind, sizeof(kind), 1, f);
+    fwrite(&id, sizeof(id), 1, f);
+    fwrite(&len, sizeof(len), 1, f);
+    fwrite(name, 1, len, f);
+}
+#endif
+
+/**
+ * Write the rings to a file. Recording is stopped while writing.
+ *
+ * Format, host byte order:
+ *   uint32 magic "STRC", uint16 version, uint16 record size,
+ *   uint32 records per core, uint32 number of cores,
+ *   uint32 timestamp frequency [Hz], uint8 timestamp bits,
+ *   uint8 1 if ctx holds the recording task, uint16 number of names,
+ *   names: uint8 kind (0 task, 1 isr, 2 user), uint16 id, uint8 len, chars
+ *   per core: uint32 head (records written), strace_rec_t[records per core]
+ *
+ * @param filename
+ * @return 0 on success
+ */
+int strace_dump( const char *filename ) {
+#if defined(__linux__)
+    FILE *f;
+#if defined(OS_TASK_CNT) || defined(USE_KERNEL)
+    Arc_PcbType pcb;
+#endif
+#if defined(OS_TASK_CNT)
+    uint32_t taskCnt = OS_TASK_CNT;
+#else
+    uint32_t taskCnt = 0;
+#endif
+#if defined(USE_KERNEL)
+    uint32_t isrCnt = Os_Arc_GetIsrCount();
+#else
+    uint32_t isrCnt = 0;
+#endif
+    uint32_t u32;
+    uint16_t u16;
+    uint8_t u8;
+    uint32_t nameCnt;
+    boolean wasEnabled = strace_enabled;
+
+    f = fopen(filename, "wb");
+    if (f == NULL) {
+        return -1;
+    }
+    strace_enabled = FALSE;
+
+    nameCnt = (strace_name_cnt < STRACE_NAME_MAX) ? strace_name_cnt : STRACE_NAME_MAX;
 
+    u32 = STRACE_MAGIC;         fwrite(&u32, sizeof(u32), 1, f);
+    u16 = STRACE_VERSION;       fwrite(&u16, sizeof(u16), 1, f);
+    u16 = sizeof(strace_rec_t); fwrite(&u16, sizeof(u16), 1, f);
+    u32 = STRACE_RING_SIZE;     fwrite(&u32, sizeof(u32), 1, f);
+    u32 = STRACE_CORE_MAX;      fwrite(&u32, sizeof(u32), 1, f);
+    u32 = 1000000000uL;         fwrite(&u32, sizeof(u32), 1, f);
+    u8 = 64;                    fwrite(&u8, sizeof(u8), 1, f);
+    u8 = 1;                     fwrite(&u8, sizeof(u8), 1, f);
+    u16 = (uint16_t)(taskCnt + isrCnt + nameCnt);
+    fwrite(&u16, sizeof(u16), 1, f);
+
+#if defined(OS_TASK_CNT)
+    for (uint32_t i = 0; i < taskCnt; i++) {
+        Os_Arc_GetTaskInfo(&pcb, (TaskType)i, OS_ARC_F_TASK_BASIC);
+        strace_put_name(f, STRACE_NAME_TASK, (uint16_t)i, pcb.name);
+    }
+#endif
+#if defined(USE_KERNEL)
+    for (uint32_t i = 0; i < isrCnt; i++) {
+        memset(pcb.name, 0, sizeof(pcb.name));
+        Os_Arc_GetIsrInfo(&pcb, (ISRType)i);
+        pcb.name[sizeof(pcb.name) - 1u] = '\0';
+        strace_put_name(f, STRACE_NAME_ISR, (uint16_t)i, pcb.name);
+    }
+#endif
+    for (uint32_t i = 0; i < nameCnt; i++) {
+        strace_put_name(f, STRACE_NAME_USER, (uint16_t)i, strace_names[i]);
+    }
+
+    for (uint32_t c = 0; c < STRACE_CORE_MAX; c++) {
+        fwrite(&strace_head[c], sizeof(strace_head[c]), 1, f);
+        fwrite(strace_ring[c], sizeof(strace_rec_t), STRACE_RING_SIZE, f);
+    }
+
+    strace_enabled = wasEnabled;
+    return (fclose(f) == 0) ? 0 : -1;
+#else
+    (void)filename;
+    return -1;
+#endif
 }
 
+/**
+ * Print the recorded events, oldest first, one line per event:
+ * core timestamp event id ctx
+ */
+void strace_print( void ) {
+    boolean wasEnabled = strace_enabled;
+    uint32_t head;
+    uint32_t pos;
+    strace_rec_t *rec;
 
+    strace_enabled = FALSE;
+    for (uint32_t c = 0; c < STRACE_CORE_MAX; c++) {
+        head = strace_head[c];
+        pos = (head > STRACE_RING_SIZE) ? (head - STRACE_RING_SIZE) : 0u;
+        for (; pos != head; pos++) {
+            rec = &strace_ring[c][pos & (STRACE_RING_SIZE - 1u)];
+            if (rec->valid != 0) {
+                printf("%u %llu %u %u %u\n", c, (unsigned long long)rec->timestamp,
+                        rec->event, rec->id, rec->ctx);
+            }
+        }
+    }
+    strace_enabled = wasEnabled;
+}
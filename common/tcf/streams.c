@@ -40,15 +40,17 @@ typedef struct {
     char* data;
 } TCF_Streams_Command;
 
-#define TCF_TTY_SIZE 800
+/* Written by any task through write(), read by the TCF task */
+#define TCF_TTY_SIZE 1024u
 
 static boolean tty_initialized = FALSE;
-static CirqBufferType cirqBuf;
+static CirqBuffLfType cirqBuf;
 char tty_buffer[TCF_TTY_SIZE] = "";
+static uint32 tty_seq[TCF_TTY_SIZE];
 
 void init_streams()
 {
-    cirqBuf = CirqBuffStatCreate(tty_buffer, TCF_TTY_SIZE, sizeof(char));
+    (void)CirqBuffLf_Init(&cirqBuf, CIRQBUFF_MPSC, tty_buffer, tty_seq, TCF_TTY_SIZE, sizeof(char));
     tty_initialized = TRUE;
 }
 
@@ -56,7 +58,7 @@ uint8_t TCF_TTY_SendChar (uint8_t ch)
 {
     int rv = 1;
     if(tty_initialized == TRUE){
-        rv = CirqBuffPush(&cirqBuf,&ch);
+        rv = CirqBuffLf_Push(&cirqBuf,&ch);
     }
 
     return rv;
@@ -68,7 +70,7 @@ uint32_t TCF_TTY_ReadString(char *str, uint16_t max_len)
     int len = 0;
     if(tty_initialized == TRUE){
         do{
-            rv = CirqBuffPop(&cirqBuf,&ch);
+            rv = CirqBuffLf_Pop(&cirqBuf,&ch);
             if(rv==0){
                 len++;
                 *str++=ch;
@@ -7,6 +7,7 @@ obj-$(USE_COM) += Com_Com.o
 obj-$(USE_COM) += Com_Sched.o
 obj-$(USE_COM) += Com.o
 obj-$(USE_COM) += Com_misc.o
+obj-$(USE_COM) += Com_Lock.o
 
 inc-$(USE_COM) += $(ROOTDIR)/communication/Com/inc
 inc-$(USE_COM) += $(ROOTDIR)/communication/Com/src
@@ -46,5 +46,28 @@ void Com_UpdateShadowSignal(Com_SignalIdType SignalId, const void *SignalDataPtr
 /* @req COM202 */
 void Com_ReceiveShadowSignal(Com_SignalIdType SignalId, void *SignalDataPtr);
 
+/* Batched Com_SendSignal / Com_ReceiveSignal. The signals of an IPdu are
+ * handled under one exclusive area and, when sending, the transfer properties
+ * are evaluated once for them, wherever they are in the list. A list sorted
+ * by IPdu is handled in one pass, otherwise signals are grouped per IPdu in
+ * parts of COM_ARC_BATCH_MAX entries. Returns E_OK or the error of one of the
+ * signals that failed, the other signals are still handled. */
+uint8 Com_Arc_SendSignals(const Com_Arc_SendSignalType *Signals, uint16 NofSignals);
+uint8 Com_Arc_ReceiveSignals(const Com_Arc_ReceiveSignalType *Signals, uint16 NofSignals);
+
+#if defined(CFG_COM_IPDU_LOCK)
+/* With CFG_COM_IPDU_LOCK each IPdu has a lock of its own instead of all of Com
+ * sharing SchM_Enter_Com_EA_0, so IPdus can be handled in parallel on several
+ * cores or LinuxOs threads. The Tx/Rx scheduling in the main functions has one
+ * more lock. Defining COM_IPDU_LOCK_SHARED maps all IPdus to that lock, as a
+ * reference for the statistics below.
+ * Rx indications, callouts and immediate notifications are called with their
+ * IPdu locked. They may use signals of other IPdus, but only from an Rx IPdu to
+ * a Tx IPdu (as the gateway does), the other way around can deadlock. */
+Std_ReturnType Com_Arc_GetIPduLockStats(PduIdType PduId, Com_Arc_LockStatsType *Stats);
+Std_ReturnType Com_Arc_GetSchedLockStats(Com_Arc_LockStatsType *Stats);
+void Com_Arc_ResetLockStats(void);
+#endif
+
 
 #endif /* COM_COM_H_ */
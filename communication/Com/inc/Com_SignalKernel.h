@@ -0,0 +1,224 @@
+/*-------------------------------- Arctic Core ------------------------------
+ * Copyright (C) 2013, ArcCore AB, Sweden, www.arccore.com.
+ * Contact: <contact@arccore.com>
+ * 
+ * You may ONLY use this file:
+ * 1)if you have a valid commercial ArcCore license and then in accordance with  
+ * the terms contained in the written license agreement between you and ArcCore, 
+ * or alternatively
+ * 2)if you follow the terms found in GNU General Public License version 2 as 
+ * published by the Free Software Foundation and appearing in the file 
+ * LICENSE.GPL included in the packaging of this file or here 
+ * <http://www.gnu.org/licenses/old-licenses/gpl-2.0.txt>
+ *-------------------------------- Arctic Core -----------------------------*/
+
+
+/** @addtogroup Com COM module
+ *  @{ */
+
+/** @file Com_SignalKernel.h
+ * Specialised pack and unpack kernels for signals and group signals.
+ *
+ * The generator emits one COM_SIGNAL_KERNELS() line per signal in
+ * Com_PbCfg.c and sets ComSignalArcPack/ComSignalArcUnpack to the
+ * resulting functions, e.g.
+ *
+ *   COM_SIGNAL_KERNELS(ComSignal_Speed, 12u, 10u, COM_LITTLE_ENDIAN, COM_UINT16)
+ *   ...
+ *   .ComSignalArcPack = ComSignal_Speed_Pack,
+ *   .ComSignalArcUnpack = ComSignal_Speed_Unpack,
+ *
+ * All layout parameters are compile time constants, so the compiler
+ * resolves the lsb index, byte count, endianness and type handling and
+ * what is left is a fixed number of byte loads, shifts and masks.
+ *
+ * The kernels take no exclusive area, the caller is responsible for data
+ * consistency. Dynamic length signals (COM_UINT8_DYN) are not supported
+ * and rejected at compile time.
+ */
+
+#ifndef COM_SIGNALKERNEL_H_
+#define COM_SIGNALKERNEL_H_
+
+#include <string.h>
+#include "Com_Types.h"
+
+/* lsb bit index of a signal, bitPosition is the msb for big endian signals */
+#define COM_SIGNAL_LSB_INDEX(_bitPosition, _bitSize, _endian) \
+    (((_endian) == COM_BIG_ENDIAN) ? (((((uint32)(_bitPosition) ^ 7u) + (uint32)(_bitSize)) - 1u) ^ 7u) : (uint32)(_bitPosition))
+
+static inline uint64 Com_Arc_SignalMask(uint16 bitSize) {
+    return (bitSize >= 64u) ? 0xFFFFFFFFFFFFFFFFULL : ((1ULL << bitSize) - 1ULL);
+}
+
+/* Byte i of the signal, counted from the byte holding the lsb */
+static inline uint32 Com_Arc_SignalByte(uint32 lsbByte, uint32 i, ComSignalEndianess_type endian) {
+    return (endian == COM_BIG_ENDIAN) ? (lsbByte - i) : (lsbByte + i);
+}
+
+/* Written out instead of a loop so that compilers not unrolling at the
+ * used optimization level still end up with straight line code */
+#define COM_SIGNAL_LOAD_BYTE(_i) \
+    if ((_i) < nBytes) { \
+        val |= (uint64)pduDataPtr[Com_Arc_SignalByte(lsbByte, (_i), endian)] << (8u * (_i)); \
+    }
+#define COM_SIGNAL_STORE_BYTE(_i) \
+    if ((_i) < nBytes) { \
+        pduDataPtr[Com_Arc_SignalByte(lsbByte, (_i), endian)] = (uint8)(val >> (8u * (_i))); \
+    }
+
+/* Loads up to 8 bytes starting at the lsb byte into a little endian word */
+static inline uint64 Com_Arc_SignalLoad(const uint8 *pduDataPtr, uint32 lsbByte, uint32 nBytes,
+        ComSignalEndianess_type endian) {
+    uint64 val = 0u;
+    COM_SIGNAL_LOAD_BYTE(0u)
+    COM_SIGNAL_LOAD_BYTE(1u)
+    COM_SIGNAL_LOAD_BYTE(2u)
+    COM_SIGNAL_LOAD_BYTE(3u)
+    COM_SIGNAL_LOAD_BYTE(4u)
+    COM_SIGNAL_LOAD_BYTE(5u)
+    COM_SIGNAL_LOAD_BYTE(6u)
+    COM_SIGNAL_LOAD_BYTE(7u)
+    return val;
+}
+
+static inline void Com_Arc_SignalStore(uint8 *pduDataPtr, uint32 lsbByte, uint32 nBytes,
+        ComSignalEndianess_type endian, uint64 val) {
+    COM_SIGNAL_STORE_BYTE(0u)
+    COM_SIGNAL_STORE_BYTE(1u)
+    COM_SIGNAL_STORE_BYTE(2u)
+    COM_SIGNAL_STORE_BYTE(3u)
+    COM_SIGNAL_STORE_BYTE(4u)
+    COM_SIGNAL_STORE_BYTE(5u)
+    COM_SIGNAL_STORE_BYTE(6u)
+    COM_SIGNAL_STORE_BYTE(7u)
+}
+
+static inline void Com_Arc_UnpackSignal(const uint8 *pduDataPtr, void *SignalDataPtr,
+        Com_BitPositionType bitPosition, uint16 bitSize,
+        ComSignalEndianess_type endian, Com_SignalType signalType) {
+
+    if ((endian == COM_OPAQUE) || (signalType == COM_UINT8_N)) {
+        /* @req COM472 */
+        memcpy(SignalDataPtr, &pduDataPtr[bitPosition / 8u], bitSize / 8u);
+        /*lint -e{904} Nothing more to do for byte arrays */
+        return;
+    }
+
+    uint32 lsbIndex = COM_SIGNAL_LSB_INDEX(bitPosition, bitSize, endian);
+    uint32 lsbByte = lsbIndex / 8u;
+    uint32 bitShift = lsbIndex % 8u;
+    uint32 nBytes = ((bitShift + bitSize) + 7u) / 8u;
+    uint64 val = Com_Arc_SignalLoad(pduDataPtr, lsbByte, (nBytes > 8u) ? 8u : nBytes, endian) >> bitShift;
+
+    if (nBytes > 8u) {
+        /* 64 bit signal not starting on a byte boundary, one more byte */
+        val |= (uint64)pduDataPtr[Com_Arc_SignalByte(lsbByte, 8u, endian)] << (64u - bitShift);
+    }
+    val &= Com_Arc_SignalMask(bitSize);
+
+    if ((signalType == COM_SINT8) || (signalType == COM_SINT16) ||
+        (signalType == COM_SINT32) || (signalType == COM_SINT64)) {
+        /* Sign extension without branching */
+        uint64 signBit = 1ULL << (bitSize - 1u);
+        val = (val ^ signBit) - signBit;
+    }
+
+    switch (signalType) {
+    case COM_BOOLEAN:
+    case COM_UINT8:
+    case COM_SINT8:
+        *(uint8 *)SignalDataPtr = (uint8)val;
+        break;
+    case COM_UINT16:
+    case COM_SINT16:
+        /*lint -e{826} -e{927} pointer cast is required operation*/
+        *(uint16 *)SignalDataPtr = (uint16)val;
+        break;
+    case COM_UINT32:
+    case COM_SINT32:
+        /*lint -e{826} -e{927} pointer cast is required operation*/
+        *(uint32 *)SignalDataPtr = (uint32)val;
+        break;
+    case COM_UINT64:
+    case COM_SINT64:
+        /*lint -e{826} -e{927} pointer cast is required operation*/
+        *(uint64 *)SignalDataPtr = val;
+        break;
+    default:
+        break;
+    }
+}
+
+static inline boolean Com_Arc_PackSignal(const void *SignalDataPtr, uint8 *pduDataPtr,
+        Com_BitPositionType bitPosition, uint16 bitSize,
+        ComSignalEndianess_type endian, Com_SignalType signalType) {
+
+    if ((endian == COM_OPAQUE) || (signalType == COM_UINT8_N)) {
+        /* @req COM472 */
+        uint8 *pduBufferBytes = &pduDataPtr[bitPosition / 8u];
+        boolean dataChanged = (0 != memcmp(pduBufferBytes, SignalDataPtr, bitSize / 8u));
+        memcpy(pduBufferBytes, SignalDataPtr, bitSize / 8u);
+        /*lint -e{904} Nothing more to do for byte arrays */
+        return dataChanged;
+    }
+
+    uint64 sigVal;
+    switch (signalType) {
+    case COM_UINT16:
+    case COM_SINT16:
+        /*lint -e{826} -e{927} pointer cast is required operation*/
+        sigVal = *(const uint16 *)SignalDataPtr;
+        break;
+    case COM_UINT32:
+    case COM_SINT32:
+        /*lint -e{826} -e{927} pointer cast is required operation*/
+        sigVal = *(const uint32 *)SignalDataPtr;
+        break;
+    case COM_UINT64:
+    case COM_SINT64:
+        /*lint -e{826} -e{927} pointer cast is required operation*/
+        sigVal = *(const uint64 *)SignalDataPtr;
+        break;
+    default:
+        sigVal = *(const uint8 *)SignalDataPtr;
+        break;
+    }
+
+    uint32 lsbIndex = COM_SIGNAL_LSB_INDEX(bitPosition, bitSize, endian);
+    uint32 lsbByte = lsbIndex / 8u;
+    uint32 bitShift = lsbIndex % 8u;
+    uint32 nBytes = ((bitShift + bitSize) + 7u) / 8u;
+    uint32 nLoBytes = (nBytes > 8u) ? 8u : nBytes;
+    uint64 mask = Com_Arc_SignalMask(bitSize);
+    uint64 pduData = Com_Arc_SignalLoad(pduDataPtr, lsbByte, nLoBytes, endian);
+    uint64 newPduData;
+    uint64 changed;
+
+    sigVal &= mask;
+    newPduData = (pduData & ~(mask << bitShift)) | (sigVal << bitShift);
+    changed = newPduData ^ pduData;
+    Com_Arc_SignalStore(pduDataPtr, lsbByte, nLoBytes, endian, newPduData);
+    if (nBytes > 8u) {
+        /* 64 bit signal not starting on a byte boundary, one more byte */
+        uint8 *pduByte = &pduDataPtr[Com_Arc_SignalByte(lsbByte, 8u, endian)];
+        uint8 maskHi = (uint8)(mask >> (64u - bitShift));
+        uint8 newByte = (uint8)((*pduByte & (uint8)~maskHi) | (uint8)(sigVal >> (64u - bitShift)));
+        changed |= (uint8)(newByte ^ *pduByte);
+        *pduByte = newByte;
+    }
+    return (changed != 0u) ? TRUE : FALSE;
+}
+
+/* Defines <_name>_Pack() and <_name>_Unpack() for one signal or group signal */
+#define COM_SIGNAL_KERNELS(_name, _bitPosition, _bitSize, _endian, _signalType) \
+    typedef char _name##_NoDynLength[((_signalType) != COM_UINT8_DYN) ? 1 : -1]; \
+    static boolean _name##_Pack(const void *SignalDataPtr, uint8 *pduDataPtr) { \
+        return Com_Arc_PackSignal(SignalDataPtr, pduDataPtr, (_bitPosition), (_bitSize), (_endian), (_signalType)); \
+    } \
+    static void _name##_Unpack(const uint8 *pduDataPtr, void *SignalDataPtr) { \
+        Com_Arc_UnpackSignal(pduDataPtr, SignalDataPtr, (_bitPosition), (_bitSize), (_endian), (_signalType)); \
+    }
+
+#endif /* COM_SIGNALKERNEL_H_ */
+/** @} */
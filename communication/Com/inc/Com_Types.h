@@ -37,6 +37,32 @@ typedef boolean (*ComRxIPduCalloutType)(PduIdType PduId, const uint8 *IPduData);
 /* @req COM700 */
 typedef boolean (*ComTxIPduCalloutType)(PduIdType PduId, uint8 *IPduData);
 
+/* Generated per-signal pack and unpack kernels, see Com_SignalKernel.h.
+ * Pack returns TRUE if the PDU data changed. */
+typedef boolean (*Com_Arc_SignalPackFnType)(const void *SignalDataPtr, uint8 *pduDataPtr);
+typedef void (*Com_Arc_SignalUnpackFnType)(const uint8 *pduDataPtr, void *SignalDataPtr);
+
+/* One signal of Com_Arc_SendSignals / Com_Arc_ReceiveSignals */
+typedef struct {
+    Com_SignalIdType SignalId;
+    const void *SignalDataPtr;
+} Com_Arc_SendSignalType;
+
+typedef struct {
+    Com_SignalIdType SignalId;
+    void *SignalDataPtr;
+} Com_Arc_ReceiveSignalType;
+
+/* Statistics of a Com lock (CFG_COM_IPDU_LOCK), times in ns. Outside LinuxOs
+ * the times are 0 without CFG_TIMER. */
+typedef struct {
+    uint32 acquireCnt;      /* Number of times the lock was taken */
+    uint32 contendedCnt;    /* Number of times it was held by another core or thread */
+    uint32 waitMax;         /* Longest wait for the lock */
+    uint32 holdMax;         /* Longest time the lock was held */
+    uint64 holdSum;         /* Total time the lock was held */
+} Com_Arc_LockStatsType;
+
 /* @req COM555 COM554 COM491 COM556*/
 typedef void (*ComNotificationCalloutType) (void);
 
@@ -229,6 +255,13 @@ typedef struct {
 
     /** Marks the end of list for the configuration array. */
     const uint8 Com_Arc_EOL;
+
+    /** Generated kernels writing/reading this group signal in the shadow buffer.
+     * NULL, or left out of a positional initialiser, to use the generic
+     * Com_Misc_WriteSignalDataToPdu()/Com_Misc_ReadSignalDataFromPdu().
+     */
+    const Com_Arc_SignalPackFnType ComSignalArcPack;
+    const Com_Arc_SignalUnpackFnType ComSignalArcUnpack;
 } ComGroupSignal_type;
 
 
@@ -352,6 +385,13 @@ typedef struct {
 
     /** Marks the end of list for the signal configuration array. */
     const uint8 Com_Arc_EOL;
+
+    /** Generated kernels writing/reading this signal in the IPdu.
+     * NULL, or left out of a positional initialiser, to use the generic
+     * Com_Misc_WriteSignalDataToPdu()/Com_Misc_ReadSignalDataFromPdu().
+     */
+    const Com_Arc_SignalPackFnType ComSignalArcPack;
+    const Com_Arc_SignalUnpackFnType ComSignalArcUnpack;
 } ComSignal_type;
 
 
@@ -130,7 +130,14 @@ void Com_Init(const Com_ConfigType *config ) {
         /*lint -e{904} ARGUMENT CHECK */
         return;
     }
+    if (COM_INIT == initStatus) {
+        /* Init again, the locks are set up for the previous configuration */
+        Com_Lock_DeInit();
+    }
     ComConfig = config;
+    Com_Lock_Init();
+    Com_Sched_RxInit();
+    Com_Sched_TxInit();
 
     boolean dataChanged = FALSE;
 
@@ -187,7 +194,7 @@ void Com_Init(const Com_ConfigType *config ) {
             if (Signal->ComTimeoutFactor > 0){
                 if(IPdu->ComIPduDirection == COM_RECEIVE ){
                     /* Configure the deadline counter */
-                    Arc_Signal->Com_Arc_DeadlineCounter = Signal->ComFirstTimeoutFactor;
+                    Com_Sched_RxDeadlineArm(Signal->ComHandleId, Signal->ComFirstTimeoutFactor);
                 } else {
                     /* @req COM445 */ /* handled in generator */
                     /* @req COM481 */
@@ -301,6 +308,7 @@ void Com_DeInit( void ) {
         Com_Arc_Config.ComIPdu[i].Com_Arc_IpduStarted = FALSE;
     }
     initStatus = COM_UNINIT;
+    Com_Lock_DeInit();
 }
 
 Com_StatusType Com_GetStatus( void )
@@ -324,7 +332,6 @@ void Com_IpduGroupControl(Com_IpduGroupVector ipduGroupVector, boolean Initializ
     /* !req COM714 */
     const ComIPdu_type   * IPdu;
     const ComSignal_type * comSignal;
-    Com_Arc_Signal_type  * Arc_Signal;
     if(COM_INIT != initStatus) {
         DET_REPORTERROR(COM_IPDUGROUPCONTROL_ID, COM_E_UNINIT);
         /*lint -e{904} Return statement is necessary in case of reporting a DET error */
@@ -345,6 +352,11 @@ void Com_IpduGroupControl(Com_IpduGroupVector ipduGroupVector, boolean Initializ
             /* @req COM612 */
             /* @req COM613 */
             /* @req COM615 */
+            Com_Lock_EnterIPdu(i);
+            if (COM_SEND == ComConfig->ComIPdu[i].ComIPduDirection) {
+                /* Catch up the Tx timers while the old state is valid */
+                Com_Sched_TxSync(i);
+            }
             Com_Arc_Config.ComIPdu[i].Com_Arc_IpduStarted = started;
 
 #if(COM_IPDU_COUNTING_ENABLE ==  STD_ON )
@@ -363,7 +375,6 @@ void Com_IpduGroupControl(Com_IpduGroupVector ipduGroupVector, boolean Initializ
             /* !req COM787  party satisfied for DM,If an I-PDU is started as result of a call Com_IpduGroupControl
              2) timeout attributes of I-PDUs for deadline monitoring aspect: all timeout timers (ComFirstTimeout, ComTimeout) shall restart */
             IPdu = GET_IPdu(i);
-            SchM_Enter_Com_EA_0();  /* DM space */
             /* RX PDUS */
             if (IPdu->ComIPduDirection == COM_RECEIVE) {
                if(TRUE == started)		   {
@@ -372,14 +383,10 @@ void Com_IpduGroupControl(Com_IpduGroupVector ipduGroupVector, boolean Initializ
                      *   all timeout timers (ComFirstTimeout, ComTimeout) shall restart */
                        for (uint16 j = 0; IPdu->ComIPduSignalRef[j] != NULL; j++) {
                            comSignal = IPdu->ComIPduSignalRef[j];
-                           Arc_Signal = GET_ArcSignal(comSignal->ComHandleId);
 
                            if(0 < comSignal->ComTimeoutFactor) {
-                               if(0 < comSignal->ComFirstTimeoutFactor) {
-                                 Arc_Signal->Com_Arc_DeadlineCounter = comSignal->ComFirstTimeoutFactor;
-                               } else {
-                                 Arc_Signal->Com_Arc_DeadlineCounter = 0;
-                               }
+                               /* ComFirstTimeoutFactor 0 stops it until the first reception */
+                               Com_Sched_RxDeadlineArm(comSignal->ComHandleId, comSignal->ComFirstTimeoutFactor);
                            }
                        }
                    }
@@ -426,8 +433,9 @@ void Com_IpduGroupControl(Com_IpduGroupVector ipduGroupVector, boolean Initializ
                     }
 
                 }
+                Com_Sched_TxSchedule(i);
             }
-            SchM_Exit_Com_EA_0(); /* DM space */
+            Com_Lock_ExitIPdu(i);
         }
     }
 }
@@ -489,7 +497,7 @@ BufReq_ReturnType Com_CopyTxData(PduIdType PduId, PduInfoType* PduInfoPtr, Retry
     (void)RetryInfoPtr; /* get rid of compiler warning*/
     //lint +estring(920,pointer)  /* cast to void */
 
-    SchM_Enter_Com_EA_0();
+    Com_Lock_EnterIPdu(PduId);
     sizeOk = (IPdu->ComIPduSize >= (Com_BufferPduState[PduId].currentPosition + PduInfoPtr->SduLength))? TRUE : FALSE;
     Com_BufferPduState[PduId].locked = TRUE;
     if ((TRUE == dirOk) && (TRUE == sizeOk)) {
@@ -500,7 +508,7 @@ BufReq_ReturnType Com_CopyTxData(PduIdType PduId, PduInfoType* PduInfoPtr, Retry
     } else {
         r = BUFREQ_NOT_OK;
     }
-    SchM_Exit_Com_EA_0();
+    Com_Lock_ExitIPdu(PduId);
     return r;
 }
 BufReq_ReturnType Com_CopyRxData(PduIdType PduId, const PduInfoType* PduInfoPtr, PduLengthType* RxBufferSizePtr) {
@@ -516,7 +524,7 @@ BufReq_ReturnType Com_CopyRxData(PduIdType PduId, const PduInfoType* PduInfoPtr,
         /*lint -e{904} Return statement is necessary in case of reporting a DET error */
         return BUFREQ_NOT_OK;
     }
-    SchM_Enter_Com_EA_0();
+    Com_Lock_EnterIPdu(PduId);
     /* @req COM658 */ /* Interrupts disabled */
 
     LDEBUG_PRINTF("   Com_CopyRxData: PduId=%d, Size=%d, Pos=%d, sduLength=%d\n",PduId, GET_IPdu(PduId)->ComIPduSize,Com_BufferPduState[PduId].currentPosition, PduInfoPtr->SduLength);
@@ -534,7 +542,7 @@ BufReq_ReturnType Com_CopyRxData(PduIdType PduId, const PduInfoType* PduInfoPtr,
     } else {
         r = BUFREQ_NOT_OK;
     }
-    SchM_Exit_Com_EA_0();
+    Com_Lock_ExitIPdu(PduId);
     return r;
 }
 
@@ -566,7 +574,7 @@ BufReq_ReturnType Com_StartOfReception(PduIdType ComRxPduId, PduLengthType TpSdu
 
     const Com_Arc_IPdu_type *Arc_IPdu = GET_ArcIPdu(ComRxPduId);
 
-    SchM_Enter_Com_EA_0();
+    Com_Lock_EnterIPdu(ComRxPduId);
     if (TRUE == Arc_IPdu->Com_Arc_IpduStarted) {
         if (GET_IPdu(ComRxPduId)->ComIPduDirection == COM_RECEIVE) {
             /* !req COM657 */
@@ -590,7 +598,7 @@ BufReq_ReturnType Com_StartOfReception(PduIdType ComRxPduId, PduLengthType TpSdu
         /* @req COM721 */
         r = BUFREQ_NOT_OK;
     }
-    SchM_Exit_Com_EA_0();
+    Com_Lock_ExitIPdu(ComRxPduId);
     return r;
 }
 
@@ -630,28 +638,22 @@ void Com_ReceptionDMControl(Com_IpduGroupVector ipduGroupVector)
             if ( Com_Arc_Config.ComIPdu[i].Com_Arc_IpduRxDMControl != enabled) {/* change of state check space*/
                 const ComSignal_type *comSignal;
                 const ComIPdu_type *IPdu = GET_IPdu(i);
-                Com_Arc_Signal_type * Arc_Signal;
-                SchM_Enter_Com_EA_0();
+                Com_Lock_EnterIPdu(i);
                 Com_Arc_Config.ComIPdu[i].Com_Arc_IpduRxDMControl = enabled;
                 /* @req COM224 */
                 if(TRUE == enabled)				{
                     for (uint16 j = 0; IPdu->ComIPduSignalRef[j] != NULL; j++) {
                         comSignal = IPdu->ComIPduSignalRef[j];
-                        Arc_Signal = GET_ArcSignal(comSignal->ComHandleId);
                         if(comSignal->ComTimeoutFactor > 0) {
                             /* Reset the deadline monitoring timer */
                             /* @req COM292 */  /* taken care in the generator  */
                             /* @req COM291 */  /* taken care in the generator  */
-                            if(0 < comSignal->ComFirstTimeoutFactor) {
-                               Arc_Signal->Com_Arc_DeadlineCounter = comSignal->ComFirstTimeoutFactor;
-                            }
-                            else{ /* wait for first reception to occur, since first time factor is not configured */
-                                Arc_Signal->Com_Arc_DeadlineCounter = 0;
-                            }
+                            /* ComFirstTimeoutFactor 0: wait for first reception to occur */
+                            Com_Sched_RxDeadlineArm(comSignal->ComHandleId, comSignal->ComFirstTimeoutFactor);
                         }
                     }
                 }
-                SchM_Exit_Com_EA_0();
+                Com_Lock_ExitIPdu(i);
             } /* change of state check space*/
         }
     }
@@ -699,6 +701,8 @@ void Com_SwitchIpduTxMode(PduIdType PduId, boolean Mode)
         else {
             txModePtr = &IPdu->ComTxIPdu.ComTxModeFalse;
         }
+        Com_Lock_EnterIPdu(PduId);
+        Com_Sched_TxSync(PduId);
         Arc_IPdu->Com_Arc_IpduTxMode = Mode;/* @req COM032 */
         Arc_IPdu->Com_Arc_TxIPduTimers.ComTxModeRepetitionPeriodTimer = 0;
         Arc_IPdu->Com_Arc_TxIPduTimers.ComTxIPduNumberOfRepetitionsLeft = 0;
@@ -708,6 +712,8 @@ void Com_SwitchIpduTxMode(PduIdType PduId, boolean Mode)
             /* @req COM244 */
             Arc_IPdu->Com_Arc_TxIPduTimers.ComTxModeTimePeriodTimer = txModePtr->ComTxModeTimePeriodFactor;
         }
+        Com_Sched_TxSchedule(PduId);
+        Com_Lock_ExitIPdu(PduId);
     }
 }
 
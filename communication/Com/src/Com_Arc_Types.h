@@ -18,6 +18,9 @@
 
 #include "Std_Types.h"
 #include "Com_Types.h"
+#if defined(CFG_COM_IPDU_LOCK) && defined(USE_LINUXOS)
+#include <pthread.h>
+#endif
 
 
 typedef struct {
@@ -28,7 +31,13 @@ typedef struct {
 
 typedef struct {
     const void *Com_Arc_ShadowBuffer;
-    uint32 Com_Arc_DeadlineCounter;
+    uint32 Com_Arc_DeadlineExpiry;  /* Com_MainFunctionRx tick when the reception deadline expires */
+    uint16 Com_Arc_DeadlineNext;    /* Next signal in the same deadline wheel slot */
+    uint16 Com_Arc_DeadlinePrev;    /* Previous signal in the same deadline wheel slot */
+    uint16 Com_Arc_DeadlineTimeoutNext; /* Next signal timed out in the current Com_MainFunctionRx tick */
+    boolean Com_Arc_DeadlineArmed;  /* Deadline monitoring running */
+    boolean Com_Arc_DeadlineQueued; /* Linked into the deadline wheel */
+    boolean Com_Arc_DeadlineTimedOut; /* Timed out, handling pending. Cleared when re-armed */
     boolean ComSignalUpdated;
     boolean ComSignalUpdatedGwRouting; /* Indicating signal update for gateway routing. Relevant only to Gateway source signals */
     boolean ComSignalRoutingReq; /* Routing is requested if ComSignalUpdatedGwRouting is set */
@@ -50,6 +59,22 @@ typedef struct {
     uint8  ComTxIPduNumberOfTxConfirmations; /* Tx confirmations from Pdu for the repeted requests(N times) */
 } Com_Arc_TxIPduTimer_type;
 
+#if defined(CFG_COM_IPDU_LOCK)
+/* Lock of an IPdu or of the Tx/Rx scheduling, see Com_Lock.c */
+typedef struct {
+#if defined(USE_LINUXOS)
+    pthread_mutex_t mutex;
+#else
+    uint32 ticketNext;
+    uint32 ticketOwner;
+    uint32 owner;           /* GetCoreID() + 1 of the holder, 0 when free */
+#endif
+    uint32 depth;           /* Nesting of the holder */
+    uint64 holdStart;
+    Com_Arc_LockStatsType stats;
+} Com_Arc_Lock_type;
+#endif
+
 typedef struct {
     /** Reference to the actual pdu data storage */
     void *ComIPduDataPtr;
@@ -58,10 +83,21 @@ typedef struct {
     Com_Arc_TxIPduTimer_type Com_Arc_TxIPduTimers;
     uint32 Com_Arc_TxDeadlineCounter; /* a separate counter storage for Tx deadline monitor,
                                        no need to parse all the signals everytime for the timeout refilling */
+    uint32 Com_Arc_TxTick;          /* Com_MainFunctionTx tick the Tx timers are up to date with */
+    uint32 Com_Arc_TxDue;           /* Com_MainFunctionTx tick the Tx IPdu must be processed */
     uint16 Com_Arc_DynSignalLength;
+    uint16 Com_Arc_RxPendingNext;   /* Next Rx IPdu waiting for Com_MainFunctionRx */
+    uint16 Com_Arc_TxNext;          /* Next Tx IPdu in the same schedule wheel slot */
+    uint16 Com_Arc_TxPrev;          /* Previous Tx IPdu in the same schedule wheel slot */
+    uint16 Com_Arc_TxSlot;          /* Schedule wheel slot the Tx IPdu is linked into */
+    boolean Com_Arc_RxPending;
+    boolean Com_Arc_TxQueued;       /* Linked into the Tx schedule wheel */
     boolean Com_Arc_IpduStarted;
     boolean Com_Arc_IpduRxDMControl;
     boolean Com_Arc_IpduTxMode; /* @req COM605 */
+#if defined(CFG_COM_IPDU_LOCK)
+    Com_Arc_Lock_type Com_Arc_Lock;
+#endif
 
 } Com_Arc_IPdu_type;
 
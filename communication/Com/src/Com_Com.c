@@ -39,7 +39,59 @@ extern const ComNotificationCalloutType ComNotificationCallouts[];
 /*lint -esym(9003, ComTriggerTransmitIPduCallouts)*/ /* ComTriggerTransmitIPduCallouts is defined in com_cfg.c */
 extern const ComTxIPduCalloutType ComTriggerTransmitIPduCallouts[];
 
+/**
+ * Writes a signal into the IPdu buffer and sets its update bit.
+ * Called with the IPdu locked.
+ * @param Signal
+ * @param comIPduDataPtr
+ * @param SignalDataPtr
+ * @return TRUE if the IPdu data changed
+ */
+static boolean Com_Com_PackSignal_Locked(const ComSignal_type *Signal, uint8 *comIPduDataPtr, const void *SignalDataPtr) {
+    boolean dataChanged = FALSE;
+    if (NULL != Signal->ComSignalArcPack) {
+        /* Generated kernel, runs within the exclusive area taken by the caller */
+        dataChanged = Signal->ComSignalArcPack(SignalDataPtr, comIPduDataPtr);
+    } else {
+        Com_Misc_WriteSignalDataToPdu(
+                (const uint8 *)SignalDataPtr,
+                Signal->ComSignalType,
+                comIPduDataPtr,
+                Signal->ComBitPosition,
+                Signal->ComBitSize,
+                Signal->ComSignalEndianess,
+                &dataChanged);
+    }
+    /* If the signal has an update bit. Set it!*/
+    /* @req COM061 */
+    if (TRUE == Signal->ComSignalArcUseUpdateBit) {
+        /*lint -e{926} pointer cast is essential since SETBIT parameters are of different pointer data type*/
+        /*lint -e{9016} Array indexing couldn't be implemented, as parameters are of different data types */
+        SETBIT(comIPduDataPtr, Signal->ComUpdateBitPosition);
+    }
+    return dataChanged;
+}
 
+/**
+ * Reads a signal from an IPdu buffer.
+ * Called with the IPdu locked.
+ * @param Signal
+ * @param pduBuffer
+ * @param SignalDataPtr
+ */
+static void Com_Com_UnpackSignal_Locked(const ComSignal_type *Signal, const void *pduBuffer, void *SignalDataPtr) {
+    if (NULL != Signal->ComSignalArcUnpack) {
+        Signal->ComSignalArcUnpack(pduBuffer, SignalDataPtr);
+    } else {
+        Com_Misc_ReadSignalDataFromPdu(
+                pduBuffer,
+                Signal->ComBitPosition,
+                Signal->ComBitSize,
+                Signal->ComSignalEndianess,
+                Signal->ComSignalType,
+                SignalDataPtr);
+    }
+}
 
 uint8 Com_SendSignal(Com_SignalIdType SignalId, const void *SignalDataPtr) {
     /* @req COM334 */ /* Shall update buffer if pdu stopped, should not store trigger */
@@ -73,35 +125,20 @@ uint8 Com_SendSignal(Com_SignalIdType SignalId, const void *SignalDataPtr) {
         ret = COM_BUSY;
     } else {
 
+        /* @req COM624 */
+        Com_Lock_EnterIPdu(Signal->ComIPduHandleId);
     	if (Signal->ComBitSize != 0) {
             //DEBUG(DEBUG_LOW, "Com_SendSignal: id %d, nBytes %d, BitPosition %d, intVal %d\n", SignalId, nBytes, signal->ComBitPosition, (uint32)*(uint8 *)SignalDataPtr);
             const Com_Arc_IPdu_type *Arc_IPdu = GET_ArcIPdu(Signal->ComIPduHandleId);
 
-            /* @req COM624 */
-            uint8 *comIPduDataPtr = Arc_IPdu->ComIPduDataPtr;
-            SchM_Enter_Com_EA_0();
-            Com_Misc_WriteSignalDataToPdu(
-                    (const uint8 *)SignalDataPtr,
-                    Signal->ComSignalType,
-                    comIPduDataPtr,
-                    Signal->ComBitPosition,
-                    Signal->ComBitSize,
-                    Signal->ComSignalEndianess,
-                    &dataChanged);
-            /* If the signal has an update bit. Set it!*/
-            /* @req COM061 */
-            if (TRUE == Signal->ComSignalArcUseUpdateBit) {
-                /*lint -e{926} pointer cast is essential since SETBIT parameters are of different pointer data type*/
-                /*lint -e{9016} Array indexing couldn't be implemented, as parameters are of different data types */
-                SETBIT(comIPduDataPtr, Signal->ComUpdateBitPosition);
-            }
+            dataChanged = Com_Com_PackSignal_Locked(Signal, Arc_IPdu->ComIPduDataPtr, SignalDataPtr);
     	}
 
         /* Assign the number of repetitions based on Transfer property */
-        if( FALSE == Com_Misc_TriggerTxOnConditions(Signal->ComIPduHandleId, dataChanged, Signal->ComTransferProperty) ) {
+        if( FALSE == Com_Misc_TriggerTxOnConditions_Locked(Signal->ComIPduHandleId, dataChanged, Signal->ComTransferProperty) ) {
             ret = COM_SERVICE_NOT_AVAILABLE;
         }
-        SchM_Exit_Com_EA_0();
+        Com_Lock_ExitIPdu(Signal->ComIPduHandleId);
     }
     return ret;
 }
@@ -141,13 +178,9 @@ uint8 Com_ReceiveSignal(Com_SignalIdType SignalId, void* SignalDataPtr) {
             pduBuffer = Arc_IPdu->ComIPduDataPtr;
         }
         /* @req COM631 */
-        Com_Misc_ReadSignalDataFromPdu(
-                pduBuffer,
-                Signal->ComBitPosition,
-                Signal->ComBitSize,
-                Signal->ComSignalEndianess,
-                Signal->ComSignalType,
-                SignalDataPtr);
+        Com_Lock_EnterIPdu(Signal->ComIPduHandleId);
+        Com_Com_UnpackSignal_Locked(Signal, pduBuffer, SignalDataPtr);
+        Com_Lock_ExitIPdu(Signal->ComIPduHandleId);
         if( (FALSE == Arc_IPdu->Com_Arc_IpduStarted) && (E_OK == ret) ) {
             ret = COM_SERVICE_NOT_AVAILABLE;
         }
@@ -174,7 +207,7 @@ uint8 Com_ReceiveDynSignal(Com_SignalIdType SignalId, void* SignalDataPtr, uint1
     if (signalType != COM_UINT8_DYN) {
         ret = COM_SERVICE_NOT_AVAILABLE;
     } else {
-        SchM_Enter_Com_EA_0();
+        Com_Lock_EnterIPdu(Signal->ComIPduHandleId);
         /* @req COM712 */
         if( *Length >= Arc_IPdu->Com_Arc_DynSignalLength ) {
             if (*Length > Arc_IPdu->Com_Arc_DynSignalLength) {
@@ -199,7 +232,7 @@ uint8 Com_ReceiveDynSignal(Com_SignalIdType SignalId, void* SignalDataPtr, uint1
             *Length = Arc_IPdu->Com_Arc_DynSignalLength;
             ret = E_NOT_OK;
         }
-        SchM_Exit_Com_EA_0();
+        Com_Lock_ExitIPdu(Signal->ComIPduHandleId);
         if( (FALSE == Arc_IPdu->Com_Arc_IpduStarted) && (E_OK == ret) ) {
             ret = COM_SERVICE_NOT_AVAILABLE;
         }
@@ -257,7 +290,7 @@ uint8 Com_SendDynSignal(Com_SignalIdType SignalId, const void* SignalDataPtr, ui
         } else {
             uint16 startFromPduByte = bitPosition / 8;
 
-            SchM_Enter_Com_EA_0();
+            Com_Lock_EnterIPdu(Signal->ComIPduHandleId);
             Arc_IpduDataPtr = (uint8 *)Arc_IPdu->ComIPduDataPtr;
             /*lint -e{9007} Either one of the condition yielding true is sufficient */
             if( (Arc_IPdu->Com_Arc_DynSignalLength != Length) ||
@@ -276,10 +309,10 @@ uint8 Com_SendDynSignal(Com_SignalIdType SignalId, const void* SignalDataPtr, ui
             }
 
             /* Assign the number of repetitions based on Transfer property */
-            if(FALSE == Com_Misc_TriggerTxOnConditions(Signal->ComIPduHandleId, dataChanged, Signal->ComTransferProperty) ) {
+            if(FALSE == Com_Misc_TriggerTxOnConditions_Locked(Signal->ComIPduHandleId, dataChanged, Signal->ComTransferProperty) ) {
                 ret = COM_SERVICE_NOT_AVAILABLE;
             }
-            SchM_Exit_Com_EA_0();
+            Com_Lock_ExitIPdu(Signal->ComIPduHandleId);
 
         }
     }
@@ -310,7 +343,7 @@ Std_ReturnType Com_TriggerTransmit(PduIdType TxPduId, PduInfoType *PduInfoPtr) {
     const ComIPdu_type *IPdu = GET_IPdu(TxPduId);
     const Com_Arc_IPdu_type    *Arc_IPdu   = GET_ArcIPdu(TxPduId);
 
-    SchM_Enter_Com_EA_0();
+    Com_Lock_EnterIPdu(TxPduId);
 
     /* @req COM766 */
     if( (IPdu->ComTriggerTransmitIPduCallout != COM_NO_FUNCTION_CALLOUT) && (ComTriggerTransmitIPduCallouts[IPdu->ComTriggerTransmitIPduCallout] != NULL) ) {
@@ -341,7 +374,7 @@ Std_ReturnType Com_TriggerTransmit(PduIdType TxPduId, PduInfoType *PduInfoPtr) {
         status = E_OK;
     }
 
-    SchM_Exit_Com_EA_0();
+    Com_Lock_ExitIPdu(TxPduId);
 
     return status;
 }
@@ -382,7 +415,7 @@ void Com_RxIndication(PduIdType RxPduId, PduInfoType* PduInfoPtr) {
 
     const ComIPdu_type *IPdu = GET_IPdu(RxPduId);
     const Com_Arc_IPdu_type *Arc_IPdu = GET_ArcIPdu(RxPduId);
-    SchM_Enter_Com_EA_0();
+    Com_Lock_EnterIPdu(RxPduId);
 
 
     /* @req COM649 */ /* Interrups disabled */
@@ -426,7 +459,7 @@ void Com_RxIndication(PduIdType RxPduId, PduInfoType* PduInfoPtr) {
             }
         }
 	}
-    SchM_Exit_Com_EA_0();
+    Com_Lock_ExitIPdu(RxPduId);
 	return;
 }
 
@@ -447,13 +480,13 @@ void Com_TpRxIndication(PduIdType PduId, NotifResultType Result) {
     const ComIPdu_type *IPdu = GET_IPdu(PduId);
     const Com_Arc_IPdu_type *Arc_IPdu = GET_ArcIPdu(PduId);
     /* @req COM651 */ /* Interrups disabled */
-    SchM_Enter_Com_EA_0();
+    Com_Lock_EnterIPdu(PduId);
 
     /* If Ipdu is stopped */
     /* @req COM684 */
     if (FALSE == Arc_IPdu->Com_Arc_IpduStarted) {
         Com_Misc_UnlockTpBuffer(getPduId(IPdu));
-        SchM_Exit_Com_EA_0();
+        Com_Lock_ExitIPdu(PduId);
     } else {
         if (Result == NTFRSLT_OK) {
             if (IPdu->ComIPduSignalProcessing == COM_IMMEDIATE) {
@@ -466,7 +499,7 @@ void Com_TpRxIndication(PduIdType PduId, NotifResultType Result) {
         } else {
             Com_Misc_UnlockTpBuffer(getPduId(IPdu));
         }
-        SchM_Exit_Com_EA_0();
+        Com_Lock_ExitIPdu(PduId);
     }
 }
 
@@ -485,9 +518,9 @@ void Com_TpTxConfirmation(PduIdType PduId, NotifResultType Result) {
     }
     (void)Result; /* touch*/
 
-    SchM_Enter_Com_EA_0();
+    Com_Lock_EnterIPdu(PduId);
     Com_Misc_UnlockTpBuffer(PduId);
-    SchM_Exit_Com_EA_0();
+    Com_Lock_ExitIPdu(PduId);
 }
 
 void Com_TxConfirmation(PduIdType TxPduId) {
@@ -526,12 +559,14 @@ void Com_TxConfirmation(PduIdType TxPduId) {
         /* Clear all update bits for the contained signals*/
         /* @req COM577 */
         if (IPdu->ComTxIPdu.ComTxIPduClearUpdateBit == CONFIRMATION) {
+            Com_Lock_EnterIPdu(TxPduId);
             for (uint16 i = 0; (IPdu->ComIPduSignalRef != NULL) && (IPdu->ComIPduSignalRef[i] != NULL); i++) {
                 if (TRUE == IPdu->ComIPduSignalRef[i]->ComSignalArcUseUpdateBit) {
                     /*lint -e{9016} Array indexing couldn't be implemented, as parameters are of different data types */
                     CLEARBIT(Arc_IPdu->ComIPduDataPtr, IPdu->ComIPduSignalRef[i]->ComUpdateBitPosition);
                 }
             }
+            Com_Lock_ExitIPdu(TxPduId);
         }
 
         if (IPdu->ComIPduSignalProcessing == COM_IMMEDIATE) {
@@ -546,7 +581,10 @@ void Com_TxConfirmation(PduIdType TxPduId) {
         }
         else {
             /* If deferred, set status and let the main function call the notification function */
+            Com_Lock_EnterIPdu(TxPduId);
             Com_Misc_SetTxConfirmationStatus(IPdu, TRUE);
+            Com_Sched_TxSchedule(TxPduId);
+            Com_Lock_ExitIPdu(TxPduId);
         }    	
      }
 }
@@ -575,7 +613,7 @@ uint8 Com_SendSignalGroup(Com_SignalGroupIdType SignalGroupId) {
         } else {
             /* Copy shadow buffer to Ipdu data space*/
 
-            SchM_Enter_Com_EA_0();
+            Com_Lock_EnterIPdu(Signal->ComIPduHandleId);
             /* @req COM635 */
             /* @req COM050 */
             Com_Misc_CopySignalGroupDataFromShadowBufferToPdu(SignalGroupId,
@@ -590,10 +628,10 @@ uint8 Com_SendSignalGroup(Com_SignalGroupIdType SignalGroupId) {
                 SETBIT(Arc_IPdu->ComIPduDataPtr, Signal->ComUpdateBitPosition);
             }
             /* Assign the number of repetitions based on Transfer property */
-            if( FALSE == Com_Misc_TriggerTxOnConditions(Signal->ComIPduHandleId, dataChanged, Signal->ComTransferProperty) ) {
+            if( FALSE == Com_Misc_TriggerTxOnConditions_Locked(Signal->ComIPduHandleId, dataChanged, Signal->ComTransferProperty) ) {
                 ret = COM_SERVICE_NOT_AVAILABLE;
             }
-            SchM_Exit_Com_EA_0();
+            Com_Lock_ExitIPdu(Signal->ComIPduHandleId);
         }
     }
     return ret;
@@ -624,9 +662,9 @@ uint8 Com_ReceiveSignalGroup(Com_SignalGroupIdType SignalGroupId) {
             /* @req COM638 */
             /* @req COM461 */
             /* @req COM051 */
-        	SchM_Enter_Com_EA_0();
+        	Com_Lock_EnterIPdu(Signal->ComIPduHandleId);
             Com_Misc_CopySignalGroupDataFromPduToShadowBuffer(SignalGroupId);
-            SchM_Exit_Com_EA_0();
+            Com_Lock_ExitIPdu(Signal->ComIPduHandleId);
 
             if( FALSE == GET_ArcIPdu(Signal->ComIPduHandleId)->Com_Arc_IpduStarted ) {
                 status = COM_SERVICE_NOT_AVAILABLE;
@@ -681,17 +719,260 @@ void Com_ReceiveShadowSignal(Com_SignalIdType SignalId, void *SignalDataPtr) {
         memcpy(SignalDataPtr, GroupSignal->ComSignalInitValue, SignalTypeToSize(GroupSignal->ComSignalType, (GroupSignal->ComBitSize/8)));
     }
     else {
+        /* The shadow buffer is protected by the lock of the signal group's IPdu */
+        uint16 pduId = GET_Signal(GroupSignal->ComSigGrpHandleId)->ComIPduHandleId;
     /* @req COM640 */
-        Com_Misc_ReadSignalDataFromPdu(
-                Arc_GroupSignal->Com_Arc_ShadowBuffer,
-                GroupSignal->ComBitPosition,
-                GroupSignal->ComBitSize,
-                GroupSignal->ComSignalEndianess,
-                GroupSignal->ComSignalType,
-                SignalDataPtr);
+        Com_Lock_EnterIPdu(pduId);
+        if (NULL != GroupSignal->ComSignalArcUnpack) {
+            GroupSignal->ComSignalArcUnpack(Arc_GroupSignal->Com_Arc_ShadowBuffer, SignalDataPtr);
+        } else {
+            Com_Misc_ReadSignalDataFromPdu(
+                    Arc_GroupSignal->Com_Arc_ShadowBuffer,
+                    GroupSignal->ComBitPosition,
+                    GroupSignal->ComBitSize,
+                    GroupSignal->ComSignalEndianess,
+                    GroupSignal->ComSignalType,
+                    SignalDataPtr);
+        }
+        Com_Lock_ExitIPdu(pduId);
+    }
+
+}
+
+/* Strength of a transfer property once the signal is written, the strongest
+ * of the signals of an IPdu is evaluated for the whole batch */
+static uint8 Com_Com_TransferRank(ComTransferPropertyType transferProperty, boolean dataChanged) {
+    uint8 rank = 0;
+    switch (transferProperty) {
+        case COM_TRIGGERED:
+            rank = 2;
+            break;
+        case COM_TRIGGERED_ON_CHANGE:
+            rank = (TRUE == dataChanged) ? 2 : 0;
+            break;
+        case COM_TRIGGERED_WITHOUT_REPETITION:
+            rank = 1;
+            break;
+        case COM_TRIGGERED_ON_CHANGE_WITHOUT_REPETITION:
+            rank = (TRUE == dataChanged) ? 1 : 0;
+            break;
+        default:
+            break;
+    }
+    return rank;
+}
+
+static const ComTransferPropertyType Com_Com_RankTransfer[] = {
+    COM_PENDING,
+    COM_TRIGGERED_WITHOUT_REPETITION,
+    COM_TRIGGERED
+};
+
+/* TRUE if the signal is valid and belongs to the IPdu, extends a batch run */
+static boolean Com_Com_InIPdu(Com_SignalIdType SignalId, uint16 pduId) {
+    return ((SignalId < ComConfig->ComNofSignals) && (GET_Signal(SignalId)->ComIPduHandleId == pduId));
+}
+
+/* Com_Arc_SendSignals/Com_Arc_ReceiveSignals group this many entries at a
+ * time, longer lists are handled in parts */
+#ifndef COM_ARC_BATCH_MAX
+#define COM_ARC_BATCH_MAX   64u
+#endif
+
+/* Signal id of entry i of a Com_Arc_SendSignalType or Com_Arc_ReceiveSignalType
+ * list, SignalId is the first member of both */
+static Com_SignalIdType Com_Com_BatchSignalId(const void *Signals, size_t stride, uint16 i) {
+    return *(const Com_SignalIdType *)((const uint8 *)Signals + ((size_t)i * stride));
+}
+
+/* Orders the cnt entries from first so that the signals of an IPdu are next
+ * to each other, order[] gets the entry indexes. A list where this already
+ * holds is kept as is, that check is one pass plus a look-up among the IPdus
+ * seen so far at each change of IPdu. Otherwise every IPdu costs one pass
+ * over the entries not yet taken. Invalid signals are left on their own. */
+static void Com_Com_BatchGroup(const void *Signals, size_t stride, uint16 first, uint16 cnt, uint16 *order) {
+    uint32 taken[(COM_ARC_BATCH_MAX + 31u) / 32u] = {0};
+    boolean grouped = TRUE;
+    uint16 runs = 0;
+    uint16 n = 0;
+
+    /* order[] holds the IPdu of each run until the check is done */
+    for (uint16 i = 0; (i < cnt) && (TRUE == grouped); i++) {
+        Com_SignalIdType SignalId = Com_Com_BatchSignalId(Signals, stride, first + i);
+        if (SignalId >= ComConfig->ComNofSignals) {
+            grouped = FALSE;
+        } else {
+            uint16 pduId = GET_Signal(SignalId)->ComIPduHandleId;
+            if ((runs == 0u) || (order[runs - 1u] != pduId)) {
+                for (uint16 r = 0; r < runs; r++) {
+                    if (order[r] == pduId) {
+                        grouped = FALSE;
+                    }
+                }
+                order[runs] = pduId;
+                runs++;
+            }
+        }
+    }
+    if (TRUE == grouped) {
+        for (uint16 i = 0; i < cnt; i++) {
+            order[i] = first + i;
+        }
+        /*lint -e{904} Nothing to reorder */
+        return;
     }
 
+    for (uint16 i = 0; i < cnt; i++) {
+        if (0u == (taken[i / 32u] & (1uL << (i % 32u)))) {
+            Com_SignalIdType SignalId = Com_Com_BatchSignalId(Signals, stride, first + i);
+            order[n] = first + i;
+            n++;
+            if (SignalId < ComConfig->ComNofSignals) {
+                uint16 pduId = GET_Signal(SignalId)->ComIPduHandleId;
+                for (uint16 j = i + 1u; j < cnt; j++) {
+                    if ((0u == (taken[j / 32u] & (1uL << (j % 32u)))) &&
+                        (TRUE == Com_Com_InIPdu(Com_Com_BatchSignalId(Signals, stride, first + j), pduId))) {
+                        taken[j / 32u] |= (1uL << (j % 32u));
+                        order[n] = first + j;
+                        n++;
+                    }
+                }
+            }
+        }
+    }
 }
 
+uint8 Com_Arc_SendSignals(const Com_Arc_SendSignalType *Signals, uint16 NofSignals) {
+    uint8 ret = E_OK;
+    if( COM_INIT != Com_GetStatus() ) {
+        DET_REPORTERROR(COM_ARC_SENDSIGNALS_ID, COM_E_UNINIT);
+        /*lint -e{904} Return statement is necessary in case of reporting a DET error */
+        return COM_SERVICE_NOT_AVAILABLE;
+    }
+    if( (NULL == Signals) && (0 < NofSignals) ) {
+        DET_REPORTERROR(COM_ARC_SENDSIGNALS_ID, COM_E_PARAM_POINTER);
+        /*lint -e{904} ARGUMENT CHECK */
+        return COM_SERVICE_NOT_AVAILABLE;
+    }
+
+    uint16 order[COM_ARC_BATCH_MAX];
+    uint16 first = 0;
+    while (first < NofSignals) {
+        uint16 cnt = (uint16)MIN((uint32)NofSignals - first, COM_ARC_BATCH_MAX);
+        Com_Com_BatchGroup(Signals, sizeof(Signals[0]), first, cnt, order);
+        uint16 i = 0;
+        while (i < cnt) {
+            uint8 status = E_OK;
+            uint16 n = 1;
+            if (Signals[order[i]].SignalId >= ComConfig->ComNofSignals) {
+                DET_REPORTERROR(COM_ARC_SENDSIGNALS_ID, COM_E_PARAM);
+                status = COM_SERVICE_NOT_AVAILABLE;
+            } else {
+                uint16 pduId = GET_Signal(Signals[order[i]].SignalId)->ComIPduHandleId;
+                while (((i + n) < cnt) && (TRUE == Com_Com_InIPdu(Signals[order[i + n]].SignalId, pduId))) {
+                    n++;
+                }
+                if (pduId == NO_PDU_REFERENCE) {
+                    /* Return error if signal is not connected to an IPdu*/
+                    status = COM_SERVICE_NOT_AVAILABLE;
+                } else if (TRUE == isPduBufferLocked(pduId)) {
+                    status = COM_BUSY;
+                } else {
+                    /* @req COM624 */
+                    uint8 *comIPduDataPtr = GET_ArcIPdu(pduId)->ComIPduDataPtr;
+                    uint8 rank = 0;
+                    Com_Lock_EnterIPdu(pduId);
+                    for (uint16 j = i; j < (i + n); j++) {
+                        const ComSignal_type *Signal = GET_Signal(Signals[order[j]].SignalId);
+                        boolean dataChanged = FALSE;
+                        if (Signal->ComBitSize != 0) {
+                            dataChanged = Com_Com_PackSignal_Locked(Signal, comIPduDataPtr, Signals[order[j]].SignalDataPtr);
+                        }
+                        rank = MAX(rank, Com_Com_TransferRank(Signal->ComTransferProperty, dataChanged));
+                    }
+                    /* Transmission and repetitions once for the IPdu */
+                    if( FALSE == Com_Misc_TriggerTxOnConditions_Locked(pduId, TRUE, Com_Com_RankTransfer[rank]) ) {
+                        status = COM_SERVICE_NOT_AVAILABLE;
+                    }
+                    Com_Lock_ExitIPdu(pduId);
+                }
+            }
+            if ((E_OK == ret) && (E_OK != status)) {
+                ret = status;
+            }
+            i += n;
+        }
+        first += cnt;
+    }
+    return ret;
+}
 
+uint8 Com_Arc_ReceiveSignals(const Com_Arc_ReceiveSignalType *Signals, uint16 NofSignals) {
+    uint8 ret = E_OK;
+    if( COM_INIT != Com_GetStatus() ) {
+        DET_REPORTERROR(COM_ARC_RECEIVESIGNALS_ID, COM_E_UNINIT);
+        /*lint -e{904} Return statement is necessary in case of reporting a DET error */
+        return COM_SERVICE_NOT_AVAILABLE;
+    }
+    if( (NULL == Signals) && (0 < NofSignals) ) {
+        DET_REPORTERROR(COM_ARC_RECEIVESIGNALS_ID, COM_E_PARAM_POINTER);
+        /*lint -e{904} ARGUMENT CHECK */
+        return COM_SERVICE_NOT_AVAILABLE;
+    }
 
+    uint16 order[COM_ARC_BATCH_MAX];
+    uint16 first = 0;
+    while (first < NofSignals) {
+        uint16 cnt = (uint16)MIN((uint32)NofSignals - first, COM_ARC_BATCH_MAX);
+        Com_Com_BatchGroup(Signals, sizeof(Signals[0]), first, cnt, order);
+        uint16 i = 0;
+        while (i < cnt) {
+            uint8 status = E_OK;
+            uint16 n = 1;
+            if (Signals[order[i]].SignalId >= ComConfig->ComNofSignals) {
+                DET_REPORTERROR(COM_ARC_RECEIVESIGNALS_ID, COM_E_PARAM);
+                status = COM_SERVICE_NOT_AVAILABLE;
+            } else {
+                uint16 pduId = GET_Signal(Signals[order[i]].SignalId)->ComIPduHandleId;
+                while (((i + n) < cnt) && (TRUE == Com_Com_InIPdu(Signals[order[i + n]].SignalId, pduId))) {
+                    n++;
+                }
+                if (pduId == NO_PDU_REFERENCE) {
+                    /* Init value if signal is not connected to an IPdu*/
+                    for (uint16 j = i; j < (i + n); j++) {
+                        const ComSignal_type *Signal = GET_Signal(Signals[order[j]].SignalId);
+                        memcpy(Signals[order[j]].SignalDataPtr, Signal->ComSignalInitValue, SignalTypeToSize(Signal->ComSignalType, Signal->ComBitSize/8));
+                    }
+                } else {
+                    const ComIPdu_type *IPdu = GET_IPdu(pduId);
+                    const Com_Arc_IPdu_type *Arc_IPdu = GET_ArcIPdu(pduId);
+                    const void* pduBuffer;
+                    if ((IPdu->ComIPduSignalProcessing == COM_DEFERRED) && (IPdu->ComIPduDirection == COM_RECEIVE)) {
+                        pduBuffer = Arc_IPdu->ComIPduDeferredDataPtr;
+                    } else {
+                        if (TRUE == isPduBufferLocked(pduId)) {
+                            status = COM_BUSY;
+                        }
+                        pduBuffer = Arc_IPdu->ComIPduDataPtr;
+                    }
+                    /* @req COM631 */
+                    /* The signals are read consistently with each other */
+                    Com_Lock_EnterIPdu(pduId);
+                    for (uint16 j = i; j < (i + n); j++) {
+                        Com_Com_UnpackSignal_Locked(GET_Signal(Signals[order[j]].SignalId), pduBuffer, Signals[order[j]].SignalDataPtr);
+                    }
+                    Com_Lock_ExitIPdu(pduId);
+                    if( (FALSE == Arc_IPdu->Com_Arc_IpduStarted) && (E_OK == status) ) {
+                        status = COM_SERVICE_NOT_AVAILABLE;
+                    }
+                }
+            }
+            if ((E_OK == ret) && (E_OK != status)) {
+                ret = status;
+            }
+            i += n;
+        }
+        first += cnt;
+    }
+    return ret;
+}
@@ -95,6 +95,10 @@ extern const Com_Arc_Config_type Com_Arc_Config;
 #define COM_TXCONFIRMATION_ID				0x40
 #define COM_TRIGGERTRANSMIT_ID				0x41
 #define COM_RXINDICATION_ID					0x42
+#define COM_ARC_SENDSIGNALS_ID				0x80
+#define COM_ARC_RECEIVESIGNALS_ID			0x81
+#define COM_ARC_GETIPDULOCKSTATS_ID			0x82
+#define COM_ARC_GETSCHEDLOCKSTATS_ID		0x83
 
 
 
@@ -130,8 +134,51 @@ extern const Com_Arc_Config_type Com_Arc_Config;
 #define GET_GwDestnSigDesc(SignalId) \
     (&ComConfig->ComGwDestnDesc[SignalId])
 
+/* Exclusive areas. By default all of Com is the one exclusive area
+ * SchM_Enter_Com_EA_0. With CFG_COM_IPDU_LOCK (see Com_Com.h and Com_Lock.c)
+ * the buffers, timers and TP state of an IPdu are protected by the lock of the
+ * IPdu, the lists and wheels of Com_Sched.c by the sched lock. Both nest for
+ * the same caller. The sched lock is taken within an IPdu lock, never the
+ * other way around. */
+#if defined(CFG_COM_IPDU_LOCK)
+void Com_Lock_Init(void);
+void Com_Lock_DeInit(void);
+void Com_Lock_IPduAcquire(PduIdType PduId);
+void Com_Lock_IPduRelease(PduIdType PduId);
+void Com_Lock_SchedAcquire(void);
+void Com_Lock_SchedRelease(void);
+#define Com_Lock_EnterIPdu(_pduId)  Com_Lock_IPduAcquire(_pduId)
+#define Com_Lock_ExitIPdu(_pduId)   Com_Lock_IPduRelease(_pduId)
+#define Com_Lock_EnterSched()       Com_Lock_SchedAcquire()
+#define Com_Lock_ExitSched()        Com_Lock_SchedRelease()
+#else
+#define Com_Lock_Init()
+#define Com_Lock_DeInit()
+#define Com_Lock_EnterIPdu(_pduId)  do { (void)(_pduId); SchM_Enter_Com_EA_0(); } while (0)
+#define Com_Lock_ExitIPdu(_pduId)   do { (void)(_pduId); SchM_Exit_Com_EA_0(); } while (0)
+#define Com_Lock_EnterSched()       SchM_Enter_Com_EA_0()
+#define Com_Lock_ExitSched()        SchM_Exit_Com_EA_0()
+#endif
+
+/* Reception deadline monitoring and deferred Rx processing, see Com_Sched.c.
+ * Must be called with the IPdu of the signal or the IPdu locked (except
+ * Com_Sched_RxInit), they take the sched lock themselves. */
+void Com_Sched_RxInit(void);
+void Com_Sched_RxDeadlineArm(Com_SignalIdType SignalId, uint32 timeout);
+void Com_Sched_RxPendingAdd(PduIdType PduId);
+
+/* Tx IPdu scheduling, see Com_Sched.c. Com_Sched_TxSync must be called before
+ * the Tx timers, mode or started state of an IPdu are changed and
+ * Com_Sched_TxSchedule after. Must be called with the IPdu locked (except
+ * Com_Sched_TxInit), they take the sched lock themselves. */
+void Com_Sched_TxInit(void);
+void Com_Sched_TxSync(PduIdType PduId);
+void Com_Sched_TxSchedule(PduIdType PduId);
+
+/* The _Locked functions must be called with the IPdu locked */
 ComTxTriggerStatusType Com_Misc_TriggerIPDUSend(PduIdType PduId);
-boolean Com_Misc_TriggerTxOnConditions(uint16 pduHandleId, boolean dataChanged, ComTransferPropertyType transferProperty);
+ComTxTriggerStatusType Com_Misc_TriggerIPDUSend_Locked(PduIdType PduId);
+boolean Com_Misc_TriggerTxOnConditions_Locked(uint16 pduHandleId, boolean dataChanged, ComTransferPropertyType transferProperty);
 boolean Com_Misc_validateIPduCounter(const ComIPduCounter_type *CounterCfgRef, const uint8 * sduPtr);
 
 #if(COM_IPDU_COUNTING_ENABLE ==  STD_ON )
@@ -0,0 +1,262 @@
+/*-------------------------------- Arctic Core ------------------------------
+ * Copyright (C) 2013, ArcCore AB, Sweden, www.arccore.com.
+ * Contact: <contact@arccore.com>
+ * 
+ * You may ONLY use this file:
+ * 1)if you have a valid commercial ArcCore license and then in accordance with  
+ * the terms contained in the written license agreement between you and ArcCore, 
+ * or alternatively
+ * 2)if you follow the terms found in GNU General Public License version 2 as 
+ * published by the Free Software Foundation and appearing in the file 
+ * LICENSE.GPL included in the packaging of this file or here 
+ * <http://www.gnu.org/licenses/old-licenses/gpl-2.0.txt>
+ *-------------------------------- Arctic Core -----------------------------*/
+
+/* The locks of CFG_COM_IPDU_LOCK, replacing SchM_Enter_Com_EA_0 by one lock per
+ * IPdu and one for the Tx/Rx scheduling, see Com_Internal.h.
+ *
+ * On LinuxOs the tasks are threads and SuspendOSInterrupts() is empty. A lock is
+ * a recursive mutex with priority inheritance, so a SCHED_FIFO task does not
+ * spin on a preempted holder of lower priority.
+ * Otherwise it is a ticket lock taken with the OS interrupts suspended. The
+ * holder can't be preempted on its core, only other cores wait for it, and a
+ * core that finds itself as the owner is nesting.
+ *
+ * The statistics are updated by the holder of the lock. Outside LinuxOs the
+ * times need the free running timer (CFG_TIMER), without it they stay 0.
+ */
+
+#include <string.h>
+#include "Com_Arc_Types.h"
+#include "Com.h"
+#include "Com_Internal.h"
+#include "SchM_Com.h"
+
+#if defined(CFG_COM_IPDU_LOCK)
+
+#if defined(USE_LINUXOS)
+#include <time.h>
+#elif defined(__GNUC__)
+#if defined(CFG_TIMER)
+#include "timer.h"
+#endif
+#else
+#error CFG_COM_IPDU_LOCK needs LinuxOs or the GCC atomic builtins
+#endif
+
+#define COM_START_SEC_VAR_CLEARED_UNSPECIFIED
+#include "Com_MemMap.h"  /*lint !e9019 OTHER [MISRA 2012 Rule 20.1, advisory] OTHER AUTOSAR specified way of using MemMap*/
+static Com_Arc_Lock_type Com_Lock_Sched;
+#define COM_STOP_SEC_VAR_CLEARED_UNSPECIFIED
+#include "Com_MemMap.h"  /*lint !e9019 OTHER [MISRA 2012 Rule 20.1, advisory] OTHER AUTOSAR specified way of using MemMap*/
+
+/* Time stamps, CLOCK_MONOTONIC_RAW in ns on LinuxOs, else the free running timer */
+static inline uint64 Com_Lock_Stamp(void) {
+#if defined(USE_LINUXOS)
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return ((uint64)ts.tv_sec * 1000000000uLL) + (uint64)ts.tv_nsec;
+#elif defined(CFG_TIMER)
+    return Timer_GetTicks();
+#else
+    return 0;
+#endif
+}
+
+static inline uint32 Com_Lock_Ns(uint64 start, uint64 end) {
+#if defined(USE_LINUXOS)
+    return (uint32)(end - start);
+#elif defined(CFG_TIMER)
+    /* Not TIMER_TICK2NS, it divides by zero for timers below 1 MHz */
+    uint64 ticks = (TimerTick)((TimerTick)end - (TimerTick)start);
+    return (0u == Timer_Freq) ? 0u : (uint32)((ticks * 1000000000uLL) / Timer_Freq);
+#else
+    (void)start;
+    (void)end;
+    return 0;
+#endif
+}
+
+static Com_Arc_Lock_type *Com_Lock_OfIPdu(PduIdType PduId) {
+#if defined(COM_IPDU_LOCK_SHARED)
+    (void)PduId;
+    return &Com_Lock_Sched;
+#else
+    return &GET_ArcIPdu(PduId)->Com_Arc_Lock;
+#endif
+}
+
+static void Com_Lock_Setup(Com_Arc_Lock_type *lock) {
+#if defined(USE_LINUXOS)
+    pthread_mutexattr_t attr;
+
+    (void)pthread_mutexattr_init(&attr);
+    (void)pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    (void)pthread_mutexattr_setprotocol(&attr, PTHREAD_PRIO_INHERIT);
+    (void)pthread_mutex_init(&lock->mutex, &attr);
+    (void)pthread_mutexattr_destroy(&attr);
+#else
+    lock->ticketNext = 0;
+    lock->ticketOwner = 0;
+    lock->owner = 0;
+#endif
+    lock->depth = 0;
+    memset(&lock->stats, 0, sizeof(lock->stats));
+}
+
+static void Com_Lock_Acquire(Com_Arc_Lock_type *lock) {
+    boolean contended = FALSE;
+    uint64 start = 0;
+#if defined(USE_LINUXOS)
+    if (0 != pthread_mutex_trylock(&lock->mutex)) {
+        contended = TRUE;
+        start = Com_Lock_Stamp();
+        (void)pthread_mutex_lock(&lock->mutex);
+    }
+#else
+    uint32 self = (uint32)GetCoreID() + 1u;
+    uint32 ticket;
+
+    SchM_Enter_Com_EA_0();
+    if (__atomic_load_n(&lock->owner, __ATOMIC_RELAXED) != self) {
+        ticket = __atomic_fetch_add(&lock->ticketNext, 1u, __ATOMIC_RELAXED);
+        if (__atomic_load_n(&lock->ticketOwner, __ATOMIC_ACQUIRE) != ticket) {
+            contended = TRUE;
+            start = Com_Lock_Stamp();
+            while (__atomic_load_n(&lock->ticketOwner, __ATOMIC_ACQUIRE) != ticket) {
+                ;
+            }
+        }
+        __atomic_store_n(&lock->owner, self, __ATOMIC_RELAXED);
+    }
+#endif
+
+    lock->depth++;
+    if (1u == lock->depth) {
+        lock->holdStart = Com_Lock_Stamp();
+        lock->stats.acquireCnt++;
+        if (TRUE == contended) {
+            uint32 wait = Com_Lock_Ns(start, lock->holdStart);
+            lock->stats.contendedCnt++;
+            if (wait > lock->stats.waitMax) {
+                lock->stats.waitMax = wait;
+            }
+        }
+    }
+}
+
+static void Com_Lock_Release(Com_Arc_Lock_type *lock) {
+    lock->depth--;
+    if (0u == lock->depth) {
+        uint32 hold = Com_Lock_Ns(lock->holdStart, Com_Lock_Stamp());
+        lock->stats.holdSum += hold;
+        if (hold > lock->stats.holdMax) {
+            lock->stats.holdMax = hold;
+        }
+#if !defined(USE_LINUXOS)
+        __atomic_store_n(&lock->owner, 0u, __ATOMIC_RELAXED);
+        __atomic_store_n(&lock->ticketOwner, lock->ticketOwner + 1u, __ATOMIC_RELEASE);
+#endif
+    }
+#if defined(USE_LINUXOS)
+    (void)pthread_mutex_unlock(&lock->mutex);
+#else
+    SchM_Exit_Com_EA_0();
+#endif
+}
+
+/**
+ * Sets up the locks, called from Com_Init before Com is used
+ * @param void
+ * @return none
+ */
+void Com_Lock_Init(void) {
+    Com_Lock_Setup(&Com_Lock_Sched);
+    for (uint16 i = 0; i < ComConfig->ComNofIPdus; i++) {
+        Com_Lock_Setup(&GET_ArcIPdu(i)->Com_Arc_Lock);
+    }
+}
+
+/**
+ * Frees the locks, called from Com_DeInit and from Com_Init before the locks
+ * of an initialized Com are set up again
+ * @param void
+ * @return none
+ */
+void Com_Lock_DeInit(void) {
+#if defined(USE_LINUXOS)
+    (void)pthread_mutex_destroy(&Com_Lock_Sched.mutex);
+    for (uint16 i = 0; i < ComConfig->ComNofIPdus; i++) {
+        (void)pthread_mutex_destroy(&GET_ArcIPdu(i)->Com_Arc_Lock.mutex);
+    }
+#endif
+}
+
+void Com_Lock_IPduAcquire(PduIdType PduId) {
+    Com_Lock_Acquire(Com_Lock_OfIPdu(PduId));
+}
+
+void Com_Lock_IPduRelease(PduIdType PduId) {
+    Com_Lock_Release(Com_Lock_OfIPdu(PduId));
+}
+
+void Com_Lock_SchedAcquire(void) {
+    Com_Lock_Acquire(&Com_Lock_Sched);
+}
+
+void Com_Lock_SchedRelease(void) {
+    Com_Lock_Release(&Com_Lock_Sched);
+}
+
+Std_ReturnType Com_Arc_GetIPduLockStats(PduIdType PduId, Com_Arc_LockStatsType *Stats) {
+    if( COM_INIT != Com_GetStatus() ) {
+        DET_REPORTERROR(COM_ARC_GETIPDULOCKSTATS_ID, COM_E_UNINIT);
+        /*lint -e{904} Return statement is necessary in case of reporting a DET error */
+        return E_NOT_OK;
+    }
+    if( PduId >= ComConfig->ComNofIPdus ) {
+        DET_REPORTERROR(COM_ARC_GETIPDULOCKSTATS_ID, COM_E_PARAM);
+        /*lint -e{904} ARGUMENT CHECK */
+        return E_NOT_OK;
+    }
+    if( NULL == Stats ) {
+        DET_REPORTERROR(COM_ARC_GETIPDULOCKSTATS_ID, COM_E_PARAM_POINTER);
+        /*lint -e{904} ARGUMENT CHECK */
+        return E_NOT_OK;
+    }
+    *Stats = Com_Lock_OfIPdu(PduId)->stats;
+    return E_OK;
+}
+
+Std_ReturnType Com_Arc_GetSchedLockStats(Com_Arc_LockStatsType *Stats) {
+    if( COM_INIT != Com_GetStatus() ) {
+        DET_REPORTERROR(COM_ARC_GETSCHEDLOCKSTATS_ID, COM_E_UNINIT);
+        /*lint -e{904} Return statement is necessary in case of reporting a DET error */
+        return E_NOT_OK;
+    }
+    if( NULL == Stats ) {
+        DET_REPORTERROR(COM_ARC_GETSCHEDLOCKSTATS_ID, COM_E_PARAM_POINTER);
+        /*lint -e{904} ARGUMENT CHECK */
+        return E_NOT_OK;
+    }
+    *Stats = Com_Lock_Sched.stats;
+    return E_OK;
+}
+
+/**
+ * Clears the statistics of all locks. Not synchronized with the holders, a
+ * lock held meanwhile may keep a sample of the old period.
+ * @param void
+ * @return none
+ */
+void Com_Arc_ResetLockStats(void) {
+    if( COM_INIT == Com_GetStatus() ) {
+        memset(&Com_Lock_Sched.stats, 0, sizeof(Com_Lock_Sched.stats));
+        for (uint16 i = 0; i < ComConfig->ComNofIPdus; i++) {
+            memset(&GET_ArcIPdu(i)->Com_Arc_Lock.stats, 0, sizeof(Com_Lock_Sched.stats));
+        }
+    }
+}
+
+#endif /* CFG_COM_IPDU_LOCK */
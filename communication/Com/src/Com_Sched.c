@@ -32,6 +32,488 @@
 /* Declared in Com_Cfg.c */
 extern const ComNotificationCalloutType ComNotificationCallouts[];
 
+/* Reception deadline monitoring uses a hashed timer wheel with one slot per
+ * Com_MainFunctionRx tick (modulo the wheel size). A signal is linked into the
+ * slot of its expiry tick, re-arming moves it in O(1). Each tick only visits
+ * the signals of one slot, i.e. those expiring now or a whole number of wheel
+ * revolutions later. */
+#if !defined(COM_RX_DEADLINE_WHEEL_SIZE)
+#define COM_RX_DEADLINE_WHEEL_SIZE  64u     /* Must be a power of 2 */
+#endif
+#define COM_RX_DEADLINE_WHEEL_MASK  (COM_RX_DEADLINE_WHEEL_SIZE - 1u)
+#define COM_RX_NONE                 0xFFFFu
+
+#if ((COM_RX_DEADLINE_WHEEL_SIZE & COM_RX_DEADLINE_WHEEL_MASK) != 0)
+#error COM_RX_DEADLINE_WHEEL_SIZE must be a power of 2
+#endif
+
+/* Tx IPdus are kept in a wheel of Com_MainFunctionTx ticks, linked into the
+ * slot of the next tick where something happens: a periodic or repeated
+ * transmission, a Tx deadline timeout or a deferred confirmation to notify.
+ * The timers of an IPdu are only brought up to date (Com_Sched_TxSync) when
+ * it is processed or changed, between those ticks they would only have been
+ * decremented. IPdus due beyond the wheel are parked in the last slot and
+ * re-linked when it comes around. */
+#if !defined(COM_TX_SCHED_WHEEL_SIZE)
+#define COM_TX_SCHED_WHEEL_SIZE     64u     /* Must be a power of 2 */
+#endif
+#define COM_TX_SCHED_WHEEL_MASK     (COM_TX_SCHED_WHEEL_SIZE - 1u)
+#define COM_TX_NONE                 0xFFFFu
+
+#if ((COM_TX_SCHED_WHEEL_SIZE & COM_TX_SCHED_WHEEL_MASK) != 0)
+#error COM_TX_SCHED_WHEEL_SIZE must be a power of 2
+#endif
+
+#define timerSub(timer, ticks) \
+    if (timer > ticks) { \
+        timer = timer - ticks; \
+    } else { \
+        timer = 0; \
+    } \
+
+#define COM_START_SEC_VAR_CLEARED_UNSPECIFIED
+#include "Com_MemMap.h"  /*lint !e9019 OTHER [MISRA 2012 Rule 20.1, advisory] OTHER AUTOSAR specified way of using MemMap*/
+static uint32 Com_RxTick;
+static uint16 Com_RxDeadlineWheel[COM_RX_DEADLINE_WHEEL_SIZE];
+/* Rx IPdus with deferred signals or gateway routing waiting for Com_MainFunctionRx */
+static uint16 Com_RxPendingHead;
+static uint16 Com_RxPendingTail;
+static uint32 Com_TxTick;
+static boolean Com_TxTickRunning;
+static uint16 Com_TxWheel[COM_TX_SCHED_WHEEL_SIZE];
+#define COM_STOP_SEC_VAR_CLEARED_UNSPECIFIED
+#include "Com_MemMap.h"  /*lint !e9019 OTHER [MISRA 2012 Rule 20.1, advisory] OTHER AUTOSAR specified way of using MemMap*/
+
+static void Com_Sched_RxDeadlineLink(Com_SignalIdType SignalId, Com_Arc_Signal_type *Arc_Signal) {
+    uint32 slot = Arc_Signal->Com_Arc_DeadlineExpiry & COM_RX_DEADLINE_WHEEL_MASK;
+    uint16 head = Com_RxDeadlineWheel[slot];
+    Arc_Signal->Com_Arc_DeadlineNext = head;
+    Arc_Signal->Com_Arc_DeadlinePrev = COM_RX_NONE;
+    if (COM_RX_NONE != head) {
+        GET_ArcSignal(head)->Com_Arc_DeadlinePrev = SignalId;
+    }
+    Com_RxDeadlineWheel[slot] = SignalId;
+    Arc_Signal->Com_Arc_DeadlineQueued = TRUE;
+}
+
+static void Com_Sched_RxDeadlineUnlink(Com_Arc_Signal_type *Arc_Signal) {
+    uint16 next = Arc_Signal->Com_Arc_DeadlineNext;
+    uint16 prev = Arc_Signal->Com_Arc_DeadlinePrev;
+    if (COM_RX_NONE != prev) {
+        GET_ArcSignal(prev)->Com_Arc_DeadlineNext = next;
+    } else {
+        Com_RxDeadlineWheel[Arc_Signal->Com_Arc_DeadlineExpiry & COM_RX_DEADLINE_WHEEL_MASK] = next;
+    }
+    if (COM_RX_NONE != next) {
+        GET_ArcSignal(next)->Com_Arc_DeadlinePrev = prev;
+    }
+    Arc_Signal->Com_Arc_DeadlineQueued = FALSE;
+}
+
+void Com_Sched_RxInit(void) {
+    Com_RxTick = 0;
+    for (uint32 i = 0; i < COM_RX_DEADLINE_WHEEL_SIZE; i++) {
+        Com_RxDeadlineWheel[i] = COM_RX_NONE;
+    }
+    Com_RxPendingHead = COM_RX_NONE;
+    Com_RxPendingTail = COM_RX_NONE;
+    for (uint16 i = 0; i < ComConfig->ComNofSignals; i++) {
+        Com_Arc_Signal_type *Arc_Signal = GET_ArcSignal(i);
+        Arc_Signal->Com_Arc_DeadlineArmed = FALSE;
+        Arc_Signal->Com_Arc_DeadlineQueued = FALSE;
+        Arc_Signal->Com_Arc_DeadlineTimedOut = FALSE;
+    }
+    for (uint16 i = 0; i < ComConfig->ComNofIPdus; i++) {
+        GET_ArcIPdu(i)->Com_Arc_RxPending = FALSE;
+    }
+}
+
+/**
+ * (Re)starts the reception deadline of a signal, O(1)
+ * @param SignalId
+ * @param timeout Number of Com_MainFunctionRx calls until timeout, 0 stops monitoring
+ */
+void Com_Sched_RxDeadlineArm(Com_SignalIdType SignalId, uint32 timeout) {
+    Com_Arc_Signal_type *Arc_Signal = GET_ArcSignal(SignalId);
+    Com_Lock_EnterSched();
+    if (TRUE == Arc_Signal->Com_Arc_DeadlineQueued) {
+        Com_Sched_RxDeadlineUnlink(Arc_Signal);
+    }
+    /* A timeout not handled yet is superseded */
+    Arc_Signal->Com_Arc_DeadlineTimedOut = FALSE;
+    if (0 == timeout) {
+        Arc_Signal->Com_Arc_DeadlineArmed = FALSE;
+    } else {
+        Arc_Signal->Com_Arc_DeadlineExpiry = Com_RxTick + timeout;
+        Arc_Signal->Com_Arc_DeadlineArmed = TRUE;
+        Com_Sched_RxDeadlineLink(SignalId, Arc_Signal);
+    }
+    Com_Lock_ExitSched();
+}
+
+void Com_Sched_RxPendingAdd(PduIdType PduId) {
+    Com_Arc_IPdu_type *Arc_IPdu = GET_ArcIPdu(PduId);
+    Com_Lock_EnterSched();
+    if (FALSE == Arc_IPdu->Com_Arc_RxPending) {
+        Arc_IPdu->Com_Arc_RxPending = TRUE;
+        Arc_IPdu->Com_Arc_RxPendingNext = COM_RX_NONE;
+        if (COM_RX_NONE == Com_RxPendingTail) {
+            Com_RxPendingHead = PduId;
+        } else {
+            GET_ArcIPdu(Com_RxPendingTail)->Com_Arc_RxPendingNext = PduId;
+        }
+        Com_RxPendingTail = PduId;
+    }
+    Com_Lock_ExitSched();
+}
+
+/**
+ * Handles an expired reception deadline
+ * @param signal
+ * @param Arc_Signal
+ * @return none
+ */
+static void Com_Sched_RxDeadlineTimeout(const ComSignal_type *signal, Com_Arc_Signal_type *Arc_Signal) {
+    const Com_Arc_IPdu_type *Arc_IPdu = GET_ArcIPdu(signal->ComIPduHandleId);
+    /* @req COM500 */
+    /* @req COM744 */
+    boolean signalChanged = FALSE;
+    if (signal->Com_Arc_IsSignalGroup != FALSE) {
+        if (signal->ComRxDataTimeoutAction == COM_TIMEOUT_DATA_ACTION_REPLACE) {
+
+            for (uint32 i=0;signal->ComGroupSignal[i]!=NULL; i++)
+            {
+                Com_Misc_WriteSignalDataToPdu(
+                    signal->ComGroupSignal[i]->ComSignalInitValue,
+                    signal->ComGroupSignal[i]->ComSignalType,
+                    Arc_IPdu->ComIPduDataPtr,
+                    signal->ComGroupSignal[i]->ComBitPosition,
+                    signal->ComGroupSignal[i]->ComBitSize,
+                    signal->ComGroupSignal[i]->ComSignalEndianess,
+                    &signalChanged);
+            }
+            Arc_Signal->ComSignalUpdated = TRUE;
+            Com_Sched_RxPendingAdd(signal->ComIPduHandleId);
+        }
+    }
+    else if (signal->ComRxDataTimeoutAction == COM_TIMEOUT_DATA_ACTION_REPLACE) {
+        /* Replace signal data.*/
+        /* @req COM470 */
+        Arc_Signal->ComSignalUpdated = TRUE;
+        Com_Sched_RxPendingAdd(signal->ComIPduHandleId);
+        Com_Misc_WriteSignalDataToPdu(
+            signal->ComSignalInitValue,
+            signal->ComSignalType,
+            Arc_IPdu->ComIPduDataPtr,
+            signal->ComBitPosition,
+            signal->ComBitSize,
+            signal->ComSignalEndianess,
+            &signalChanged);
+    }
+    else {
+        /*intentionally left blank, else part is for lint exception*/
+    }
+    /* A timeout has occurred.*/
+    /* @req COM556 */
+    /* take out this out of resource protection mechanism ?*/
+    if ((signal->ComTimeoutNotification != COM_NO_FUNCTION_CALLOUT) && (ComNotificationCallouts[signal->ComTimeoutNotification] != NULL) ) {
+        ComNotificationCallouts[signal->ComTimeoutNotification]();
+    }
+#if (COM_OSEKNM_SUPPORT == STD_ON)
+    if (signal->ComOsekNmNetId != COM_OSEKNM_INVALID_NET_ID) {
+        OsekNm_TimeoutNotification(signal->ComOsekNmNetId, signal->ComOsekNmNodeId);
+    }
+#endif
+}
+
+/**
+ * Advances the deadline wheel one tick and handles the signals in the new slot.
+ * The wheel is walked with the sched lock, the timeouts are collected and
+ * handled afterwards with the lock of their IPdu.
+ * @param void
+ * @return none
+ */
+static void Com_Sched_RxDeadlineTick(void) {
+    uint16 timeoutHead = COM_RX_NONE;
+    uint16 timeoutTail = COM_RX_NONE;
+    Com_Lock_EnterSched();
+    Com_RxTick++;
+    uint32 slot = Com_RxTick & COM_RX_DEADLINE_WHEEL_MASK;
+    uint16 sigId = Com_RxDeadlineWheel[slot];
+    /* Detach the slot, signals due in a later revolution are linked in again */
+    Com_RxDeadlineWheel[slot] = COM_RX_NONE;
+    while (COM_RX_NONE != sigId) {
+        const ComSignal_type *signal = GET_Signal(sigId);
+        Com_Arc_Signal_type *Arc_Signal = GET_ArcSignal(sigId);
+        const Com_Arc_IPdu_type *Arc_IPdu = GET_ArcIPdu(signal->ComIPduHandleId);
+        uint16 nextId = Arc_Signal->Com_Arc_DeadlineNext;
+
+        Arc_Signal->Com_Arc_DeadlineQueued = FALSE;
+        /* Monitor signal reception deadline*/
+        /* @req COM685 */
+        /* @req COM292 */
+        /* @req COM290 */
+        /* @req COM716 */
+        /* @req COM617 */
+        if ((TRUE == Arc_IPdu->Com_Arc_IpduStarted) &&
+            (TRUE == Arc_IPdu->Com_Arc_IpduRxDMControl)) {
+            if (Arc_Signal->Com_Arc_DeadlineExpiry == Com_RxTick) {
+                if (FALSE == Arc_Signal->Com_Arc_DeadlineTimedOut) {
+                    Arc_Signal->Com_Arc_DeadlineTimedOut = TRUE;
+                    Arc_Signal->Com_Arc_DeadlineTimeoutNext = COM_RX_NONE;
+                    if (COM_RX_NONE == timeoutTail) {
+                        timeoutHead = sigId;
+                    } else {
+                        GET_ArcSignal(timeoutTail)->Com_Arc_DeadlineTimeoutNext = sigId;
+                    }
+                    timeoutTail = sigId;
+                }
+                /* Restart timer*/
+                Arc_Signal->Com_Arc_DeadlineExpiry = Com_RxTick + signal->ComTimeoutFactor;
+            }
+            Com_Sched_RxDeadlineLink(sigId, Arc_Signal);
+        }
+        /* else: stopped. Starting the IPdu or enabling DM re-arms the deadline */
+        sigId = nextId;
+    }
+    Com_Lock_ExitSched();
+
+    sigId = timeoutHead;
+    while (COM_RX_NONE != sigId) {
+        const ComSignal_type *signal = GET_Signal(sigId);
+        Com_Arc_Signal_type *Arc_Signal = GET_ArcSignal(sigId);
+        uint16 nextId = Arc_Signal->Com_Arc_DeadlineTimeoutNext;
+        Com_Lock_EnterIPdu(signal->ComIPduHandleId);
+        /* Not if a reception re-armed the deadline in between */
+        if (TRUE == Arc_Signal->Com_Arc_DeadlineTimedOut) {
+            Arc_Signal->Com_Arc_DeadlineTimedOut = FALSE;
+            Com_Sched_RxDeadlineTimeout(signal, Arc_Signal);
+        }
+        Com_Lock_ExitIPdu(signal->ComIPduHandleId);
+        sigId = nextId;
+    }
+}
+
+/**
+ * Deferred signal processing and gateway indications of one received IPdu
+ * @param pduId
+ * @return TRUE if gateway routing was requested, the IPdu needs another pass
+ *         to clear the request
+ */
+static boolean Com_Sched_RxProcessPdu(uint16 pduId) {
+    const ComIPdu_type *IPdu = GET_IPdu(pduId);
+    const Com_Arc_IPdu_type *Arc_IPdu = GET_ArcIPdu(pduId);
+    boolean pduUpdated = false;
+    boolean routingReq = false;
+
+    for (uint16 sri = 0; (IPdu->ComIPduSignalRef != NULL) && (IPdu->ComIPduSignalRef[sri] != NULL); sri++) {
+        const ComSignal_type *signal = IPdu->ComIPduSignalRef[sri];
+        Com_Arc_Signal_type * Arc_Signal = GET_ArcSignal(signal->ComHandleId);
+        if (TRUE == Arc_Signal->ComSignalUpdated) {
+            pduUpdated = true;
+        }
+#if (COM_SIG_GATEWAY_ENABLE == STD_ON)
+
+        /* Use ComSignalRoutingReq variable for updated signal indication to avoid data consistency problems */
+        Arc_Signal->ComSignalRoutingReq =  Arc_Signal->ComSignalUpdatedGwRouting;
+        Arc_Signal->ComSignalUpdatedGwRouting = FALSE;
+        routingReq |= Arc_Signal->ComSignalRoutingReq;
+#endif
+    }
+    if ((TRUE == pduUpdated) && (IPdu->ComIPduSignalProcessing == COM_DEFERRED) ) {
+        Com_Misc_UnlockTpBuffer(getPduId(IPdu));
+        memcpy(Arc_IPdu->ComIPduDeferredDataPtr,Arc_IPdu->ComIPduDataPtr,IPdu->ComIPduSize);
+        for (uint16 i = 0; (IPdu->ComIPduSignalRef != NULL) && (IPdu->ComIPduSignalRef[i] != NULL); i++) {
+            const ComSignal_type *signal = IPdu->ComIPduSignalRef[i];
+            Com_Arc_Signal_type * Arc_Signal = GET_ArcSignal(signal->ComHandleId);
+            if (TRUE == Arc_Signal->ComSignalUpdated) {
+                /* take out this out of resource protection mechanism ?*/
+                if ((signal->ComNotification != COM_NO_FUNCTION_CALLOUT) && (ComNotificationCallouts[signal->ComNotification] != NULL) ) {
+                    ComNotificationCallouts[signal->ComNotification]();
+                }
+                Arc_Signal->ComSignalUpdated = FALSE;
+            }
+        }
+    }
+#if (COM_SIG_GATEWAY_ENABLE == STD_ON)
+    Com_Arc_GwSrcDesc_type * gwSrcPtr;
+    uint16 srcSigDescHandle;
+    uint8 j;
+    /* Indicate new source description value */
+    if ((TRUE == IPdu->ComIPduGwRoutingReq) && (NULL != IPdu->ComIPduGwMapSigDescHandle)) {
+
+        for (j=0; IPdu->ComIPduGwMapSigDescHandle[j] != INVALID_GWSIGNAL_DESCRIPTION_HANDLE; j++){
+            srcSigDescHandle = IPdu->ComIPduGwMapSigDescHandle[j];
+            gwSrcPtr = GET_ArcGwSrcSigDesc(srcSigDescHandle);
+            /* Use ComSignalRoutingReq variable for updated signal indication to avoid data consistency problems */
+            gwSrcPtr->ComSignalRoutingReq= gwSrcPtr->ComSignalUpdatedGwRouting;
+            gwSrcPtr->ComSignalUpdatedGwRouting = FALSE;
+            routingReq |= gwSrcPtr->ComSignalRoutingReq;
+        }
+    }
+#endif
+    return routingReq;
+}
+
+static const ComTxMode_type *Com_Sched_TxMode(const ComIPdu_type *IPdu, const Com_Arc_IPdu_type *Arc_IPdu) {
+    const ComTxMode_type *txModePtr;
+    if( TRUE == Arc_IPdu->Com_Arc_IpduTxMode ) {
+        txModePtr = &IPdu->ComTxIPdu.ComTxModeTrue;
+    }
+    else {
+        txModePtr = &IPdu->ComTxIPdu.ComTxModeFalse;
+    }
+    return txModePtr;
+}
+
+static void Com_Sched_TxLink(uint16 pduId, Com_Arc_IPdu_type *Arc_IPdu) {
+    uint32 tick = Arc_IPdu->Com_Arc_TxDue;
+    if ((tick - Com_TxTick) >= COM_TX_SCHED_WHEEL_SIZE) {
+        /* Never the slot of the current tick, it may be being processed */
+        tick = Com_TxTick + COM_TX_SCHED_WHEEL_MASK;
+    }
+    uint16 slot = (uint16)(tick & COM_TX_SCHED_WHEEL_MASK);
+    uint16 head = Com_TxWheel[slot];
+    Arc_IPdu->Com_Arc_TxNext = head;
+    Arc_IPdu->Com_Arc_TxPrev = COM_TX_NONE;
+    if (COM_TX_NONE != head) {
+        GET_ArcIPdu(head)->Com_Arc_TxPrev = pduId;
+    }
+    Com_TxWheel[slot] = pduId;
+    Arc_IPdu->Com_Arc_TxSlot = slot;
+    Arc_IPdu->Com_Arc_TxQueued = TRUE;
+}
+
+static void Com_Sched_TxUnlink(Com_Arc_IPdu_type *Arc_IPdu) {
+    uint16 next = Arc_IPdu->Com_Arc_TxNext;
+    uint16 prev = Arc_IPdu->Com_Arc_TxPrev;
+    if (COM_TX_NONE != prev) {
+        GET_ArcIPdu(prev)->Com_Arc_TxNext = next;
+    } else {
+        Com_TxWheel[Arc_IPdu->Com_Arc_TxSlot] = next;
+    }
+    if (COM_TX_NONE != next) {
+        GET_ArcIPdu(next)->Com_Arc_TxPrev = prev;
+    }
+    Arc_IPdu->Com_Arc_TxQueued = FALSE;
+}
+
+/**
+ * Applies the Com_MainFunctionTx ticks up to and including tick to the Tx
+ * timers. There must not be a transmission or timeout within these ticks,
+ * the timers are just decremented as Com_MainFunctionTx would have done.
+ * @param IPdu
+ * @param Arc_IPdu
+ * @param tick
+ * @return none
+ */
+static void Com_Sched_TxAdvance(const ComIPdu_type *IPdu, Com_Arc_IPdu_type *Arc_IPdu, uint32 tick) {
+    uint32 ticks = tick - Arc_IPdu->Com_Arc_TxTick;
+    if ((0 < ticks) && (COM_SEND == IPdu->ComIPduDirection) && (TRUE == Arc_IPdu->Com_Arc_IpduStarted)) {
+        Com_Arc_TxIPduTimer_type *timers = &Arc_IPdu->Com_Arc_TxIPduTimers;
+        ComTxModeModeType txMode = Com_Sched_TxMode(IPdu, Arc_IPdu)->ComTxModeMode;
+        timerSub(timers->ComTxIPduMinimumDelayTimer, ticks);
+        if (0 < Arc_IPdu->Com_Arc_TxDeadlineCounter) {
+            timerSub(timers->ComTxDMTimer, ticks);
+        }
+        if ((COM_PERIODIC == txMode) || (COM_MIXED == txMode)) {
+            timerSub(timers->ComTxModeTimePeriodTimer, ticks);
+        }
+        if ((0 < timers->ComTxIPduNumberOfRepetitionsLeft) &&
+            ((COM_DIRECT == txMode) || (COM_MIXED == txMode))) {
+            timerSub(timers->ComTxModeRepetitionPeriodTimer, ticks);
+        }
+    }
+    Arc_IPdu->Com_Arc_TxTick = tick;
+}
+
+void Com_Sched_TxInit(void) {
+    Com_TxTick = 0;
+    Com_TxTickRunning = FALSE;
+    for (uint32 i = 0; i < COM_TX_SCHED_WHEEL_SIZE; i++) {
+        Com_TxWheel[i] = COM_TX_NONE;
+    }
+    for (uint16 i = 0; i < ComConfig->ComNofIPdus; i++) {
+        Com_Arc_IPdu_type *Arc_IPdu = GET_ArcIPdu(i);
+        Arc_IPdu->Com_Arc_TxTick = 0;
+        Arc_IPdu->Com_Arc_TxQueued = FALSE;
+    }
+}
+
+/**
+ * Brings the Tx timers of an IPdu up to date with the last Com_MainFunctionTx
+ * call, O(1)
+ * @param PduId
+ * @return none
+ */
+void Com_Sched_TxSync(PduIdType PduId) {
+    Com_Arc_IPdu_type *Arc_IPdu = GET_ArcIPdu(PduId);
+    Com_Lock_EnterSched();
+    uint32 tick = Com_TxTick;
+    if ((TRUE == Com_TxTickRunning) && (Arc_IPdu->Com_Arc_TxTick != tick)) {
+        /* Called from Com_MainFunctionTx, e.g. a notification, and the IPdu is
+         * not processed in this tick yet. Its timers stay before the tick, if
+         * scheduled for it it is processed in this call. */
+        tick--;
+    }
+    Com_Lock_ExitSched();
+    Com_Sched_TxAdvance(GET_IPdu(PduId), Arc_IPdu, tick);
+}
+
+/**
+ * Links a Tx IPdu into the wheel for the next tick it must be processed,
+ * or takes it out if it is stopped or idle. Rx IPdus are never linked. O(1)
+ * @param PduId
+ * @return none
+ */
+void Com_Sched_TxSchedule(PduIdType PduId) {
+    const ComIPdu_type *IPdu = GET_IPdu(PduId);
+    Com_Arc_IPdu_type *Arc_IPdu = GET_ArcIPdu(PduId);
+    const Com_Arc_TxIPduTimer_type *timers = &Arc_IPdu->Com_Arc_TxIPduTimers;
+    boolean idle = TRUE;
+    uint32 wait = 0xFFFFFFFFu;
+
+    Com_Sched_TxSync(PduId);
+    if ((COM_SEND == IPdu->ComIPduDirection) && (TRUE == Arc_IPdu->Com_Arc_IpduStarted)) {
+        ComTxModeModeType txMode = Com_Sched_TxMode(IPdu, Arc_IPdu)->ComTxModeMode;
+        uint32 minDelay = timers->ComTxIPduMinimumDelayTimer;
+        if ((COM_PERIODIC == txMode) || (COM_MIXED == txMode)) {
+            wait = MAX(timers->ComTxModeTimePeriodTimer, minDelay);
+            idle = FALSE;
+        }
+        if ((0 < timers->ComTxIPduNumberOfRepetitionsLeft) &&
+            ((COM_DIRECT == txMode) || (COM_MIXED == txMode))) {
+            wait = MIN(wait, MAX(timers->ComTxModeRepetitionPeriodTimer, minDelay));
+            idle = FALSE;
+        }
+        if ((0 < Arc_IPdu->Com_Arc_TxDeadlineCounter) && (0 < timers->ComTxDMTimer)) {
+            wait = MIN(wait, timers->ComTxDMTimer);
+            idle = FALSE;
+        }
+        if (TRUE == Com_Misc_GetTxConfirmationStatus(IPdu)) {
+            wait = 1;
+            idle = FALSE;
+        }
+    }
+
+    Com_Lock_EnterSched();
+    if (TRUE == idle) {
+        if (TRUE == Arc_IPdu->Com_Arc_TxQueued) {
+            Com_Sched_TxUnlink(Arc_IPdu);
+        }
+    } else {
+        uint32 due = Arc_IPdu->Com_Arc_TxTick + MAX(wait, 1u);
+        if ((FALSE == Arc_IPdu->Com_Arc_TxQueued) || (Arc_IPdu->Com_Arc_TxDue != due)) {
+            if (TRUE == Arc_IPdu->Com_Arc_TxQueued) {
+                Com_Sched_TxUnlink(Arc_IPdu);
+            }
+            Arc_IPdu->Com_Arc_TxDue = due;
+            Com_Sched_TxLink(PduId, Arc_IPdu);
+        }
+    }
+    Com_Lock_ExitSched();
+}
+
 /**
  * Tx sub main function- routed from Com_MainFunctionTx
  * Processes mixed or periodic tx pdus
@@ -168,124 +650,121 @@ void Com_MainFunctionRx(void) {
         /*lint -e{904} Return statement is necessary in case of reporting a DET error */
         return;
     }
-    for (uint16 pduId = 0; 0 == ComConfig->ComIPdu[pduId].Com_Arc_EOL; pduId++) {
-        const ComIPdu_type *IPdu = GET_IPdu(pduId);
-        const Com_Arc_IPdu_type *Arc_IPdu = GET_ArcIPdu(pduId);
-        if((IPdu->ComIPduDirection == COM_RECEIVE) && (TRUE == Arc_IPdu->Com_Arc_IpduStarted)){
-            boolean pduUpdated = false;
-            SchM_Enter_Com_EA_0();
-            for (uint16 sri = 0; (IPdu->ComIPduSignalRef != NULL) && (IPdu->ComIPduSignalRef[sri] != NULL); sri++) {
-                const ComSignal_type *signal = IPdu->ComIPduSignalRef[sri];
-                Com_Arc_Signal_type * Arc_Signal = GET_ArcSignal(signal->ComHandleId);
-                /* Monitor signal reception deadline*/
-                /* @req COM685 */
-                /* @req COM292 */
-                /* @req COM290 */
-                /* @req COM716 */
-                /* @req COM617 */
-                if ( (TRUE == Arc_IPdu->Com_Arc_IpduRxDMControl)&&
-                     (signal->ComTimeoutFactor > 0) ) {
-                   /* @req COM716 */
-                   /* deadline timer can be zero for some signals as well hence the check for valid counter */
-                    if(Arc_Signal->Com_Arc_DeadlineCounter != 0){
-                        /* Decrease deadline monitoring timer.*/
-                        timerDec(Arc_Signal->Com_Arc_DeadlineCounter);
-                        /* Check if a timeout has occurred.*/
-                        if (Arc_Signal->Com_Arc_DeadlineCounter == 0) {
-                            /* @req COM500 */
-                            /* @req COM744 */
-                            boolean signalChanged = FALSE;
-                            if (signal->Com_Arc_IsSignalGroup != FALSE) {
-                                if (signal->ComRxDataTimeoutAction == COM_TIMEOUT_DATA_ACTION_REPLACE) {
-
-                                    for (uint32 i=0;signal->ComGroupSignal[i]!=NULL; i++)
-                                    {
-                                        Com_Misc_WriteSignalDataToPdu(
-                                            signal->ComGroupSignal[i]->ComSignalInitValue,
-                                            signal->ComGroupSignal[i]->ComSignalType,
-                                            Arc_IPdu->ComIPduDataPtr,
-                                            signal->ComGroupSignal[i]->ComBitPosition,
-                                            signal->ComGroupSignal[i]->ComBitSize,
-                                            signal->ComGroupSignal[i]->ComSignalEndianess,
-                                            &signalChanged);
-                                    }
-                                    Arc_Signal->ComSignalUpdated = TRUE;
-                                }
-                            }
-                            else if (signal->ComRxDataTimeoutAction == COM_TIMEOUT_DATA_ACTION_REPLACE) {
-                                /* Replace signal data.*/
-                                /* @req COM470 */
-                                Arc_Signal->ComSignalUpdated = TRUE;
-                                Com_Misc_WriteSignalDataToPdu(
-                                    signal->ComSignalInitValue,
-                                    signal->ComSignalType,
-                                    Arc_IPdu->ComIPduDataPtr,
-                                    signal->ComBitPosition,
-                                    signal->ComBitSize,
-                                    signal->ComSignalEndianess,
-                                    &signalChanged);
-                            }
-                            else {
-                                /*intentionally left blank, else part is for lint exception*/
-                            }
-                            /* A timeout has occurred.*/
-                            /* @req COM556 */
-                            /* take out this out of resource protection mechanism ?*/
-                            if ((signal->ComTimeoutNotification != COM_NO_FUNCTION_CALLOUT) && (ComNotificationCallouts[signal->ComTimeoutNotification] != NULL) ) {
-                                ComNotificationCallouts[signal->ComTimeoutNotification]();
-                            }
-#if (COM_OSEKNM_SUPPORT == STD_ON)
-                            if (signal->ComOsekNmNetId != COM_OSEKNM_INVALID_NET_ID) {
-                                OsekNm_TimeoutNotification(signal->ComOsekNmNetId, signal->ComOsekNmNodeId);
-                            }
-#endif
-                            /* Restart timer*/
-                            Arc_Signal->Com_Arc_DeadlineCounter = signal->ComTimeoutFactor;
-                        }
-                    }
-                }
-                if (TRUE == Arc_Signal->ComSignalUpdated) {
-                    pduUpdated = true;
-                }
-    #if (COM_SIG_GATEWAY_ENABLE == STD_ON)
 
-                /* Use ComSignalRoutingReq variable for updated signal indication to avoid data consistency problems */
-                Arc_Signal->ComSignalRoutingReq =  Arc_Signal->ComSignalUpdatedGwRouting;
-                Arc_Signal->ComSignalUpdatedGwRouting = FALSE;
-    #endif
+    Com_Sched_RxDeadlineTick();
+
+    /* Only the IPdus received (or timed out) since the last call */
+    Com_Lock_EnterSched();
+    uint16 pduId = Com_RxPendingHead;
+    Com_RxPendingHead = COM_RX_NONE;
+    Com_RxPendingTail = COM_RX_NONE;
+    Com_Lock_ExitSched();
+
+    while (COM_RX_NONE != pduId) {
+        Com_Arc_IPdu_type *Arc_IPdu = GET_ArcIPdu(pduId);
+        Com_Lock_EnterIPdu(pduId);
+        Com_Lock_EnterSched();
+        uint16 nextId = Arc_IPdu->Com_Arc_RxPendingNext;
+        Arc_IPdu->Com_Arc_RxPending = FALSE;
+        Com_Lock_ExitSched();
+        if (FALSE == Arc_IPdu->Com_Arc_IpduStarted) {
+            /* Stopped before it was processed, keep it until the IPdu is started again */
+            Com_Sched_RxPendingAdd(pduId);
+        } else if (TRUE == Com_Sched_RxProcessPdu(pduId)) {
+            /* Routing requests are valid for one call, come back to clear them */
+            Com_Sched_RxPendingAdd(pduId);
+        } else {
+            /* Done */
+        }
+        Com_Lock_ExitIPdu(pduId);
+        pduId = nextId;
+    }
+}
+
+/**
+ * Processes a Tx IPdu due in this Com_MainFunctionTx tick: handles the tx
+ * timers, transmissions and notifications and schedules the IPdu again.
+ * Takes the IPdu lock, which is left for the notifications. If the IPdu was
+ * scheduled again before the lock was taken, that is overridden here.
+ * @param pduId
+ * @return none
+ */
+static void Com_Sched_TxProcessPdu(uint16 pduId) {
+    const ComIPdu_type *IPdu = GET_IPdu(pduId);
+    Com_Arc_IPdu_type *Arc_IPdu = GET_ArcIPdu(pduId);
+    Com_Lock_EnterIPdu(pduId);
+    const ComTxMode_type *txModePtr = Com_Sched_TxMode(IPdu, Arc_IPdu);
+    boolean dmTimeOut = FALSE;
+
+    /* The ticks since the IPdu was last touched, then this one as below */
+    Com_Sched_TxAdvance(IPdu, Arc_IPdu, Com_TxTick - 1u);
+    Arc_IPdu->Com_Arc_TxTick = Com_TxTick;
+
+    /* Decrease minimum delay timer*/
+    timerDec(Arc_IPdu->Com_Arc_TxIPduTimers.ComTxIPduMinimumDelayTimer);
+
+    if(0 < Arc_IPdu->Com_Arc_TxDeadlineCounter) /* if DM configured for this TX pdu */
+    {
+        /* Decrement Tx deadline monitoring timer.*/
+        if(0 < Arc_IPdu->Com_Arc_TxIPduTimers.ComTxDMTimer){ /* if DM timer is running */
+            timerDec(Arc_IPdu->Com_Arc_TxIPduTimers.ComTxDMTimer);
+            if(Arc_IPdu->Com_Arc_TxIPduTimers.ComTxDMTimer == 0){/* if timed out */
+                dmTimeOut = TRUE;
+                /*NOTE : it could happen that a new request arrive via Com_SendSignalGroup() or Com_SendSignal() or
+                 * Com_SendDynamicSignal() during wait for last request(at this time) hence DM timer would be restarted there
+                 * */
             }
-            if ((TRUE == pduUpdated) && (IPdu->ComIPduSignalProcessing == COM_DEFERRED) ) {
-                Com_Misc_UnlockTpBuffer(getPduId(IPdu));
-                memcpy(Arc_IPdu->ComIPduDeferredDataPtr,Arc_IPdu->ComIPduDataPtr,IPdu->ComIPduSize);
-                for (uint16 i = 0; (IPdu->ComIPduSignalRef != NULL) && (IPdu->ComIPduSignalRef[i] != NULL); i++) {
-                    const ComSignal_type *signal = IPdu->ComIPduSignalRef[i];
-                    Com_Arc_Signal_type * Arc_Signal = GET_ArcSignal(signal->ComHandleId);
-                    if (TRUE == Arc_Signal->ComSignalUpdated) {
-                        /* take out this out of resource protection mechanism ?*/
-                        if ((signal->ComNotification != COM_NO_FUNCTION_CALLOUT) && (ComNotificationCallouts[signal->ComNotification] != NULL) ) {
-                            ComNotificationCallouts[signal->ComNotification]();
-                        }
-                        Arc_Signal->ComSignalUpdated = FALSE;
-                    }
-                }
+        }
+    }
+
+    /* If IPDU has periodic or mixed transmission mode.*/
+    if ( (txModePtr->ComTxModeMode == COM_PERIODIC)
+        || (txModePtr->ComTxModeMode == COM_MIXED) ) {
+        Com_ProcessMixedOrPeriodicTxMode(pduId,dmTimeOut);
+
+    /* If IPDU has direct transmission mode.*/
+    } else if (txModePtr->ComTxModeMode == COM_DIRECT) {
+        Com_ProcessDirectTxMode(pduId,dmTimeOut);
+    }
+    /* The IDPU has NONE transmission mode.*/
+    /* @req COM135 */
+    /* !req  COM835 */
+    else {
+        /* Don't send!*/
+    }
+
+    /* Check notifications */
+    boolean confirmationStatus = Com_Misc_GetTxConfirmationStatus(IPdu);
+    Com_Misc_SetTxConfirmationStatus(IPdu, FALSE);
+
+    Com_Sched_TxSchedule(pduId);
+    Com_Lock_ExitIPdu(pduId);
+
+    /* !req  COM708 */
+    for (uint16 signalIndex = 0;  (IPdu->ComIPduSignalRef != NULL) &&
+        (IPdu->ComIPduSignalRef[signalIndex] != NULL); signalIndex++)
+    {
+        const ComSignal_type *signal = IPdu->ComIPduSignalRef[signalIndex];
+        if(TRUE == confirmationStatus)
+        {
+            if ((signal->ComNotification != COM_NO_FUNCTION_CALLOUT) &&
+                (ComNotificationCallouts[signal->ComNotification] != NULL) ) {
+                 ComNotificationCallouts[signal->ComNotification]();
             }
-#if (COM_SIG_GATEWAY_ENABLE == STD_ON)
-            Com_Arc_GwSrcDesc_type * gwSrcPtr;
-            uint16 srcSigDescHandle;
-            uint8 j;
-            /* Indicate new source description value */
-            if ((TRUE == IPdu->ComIPduGwRoutingReq) && (NULL != IPdu->ComIPduGwMapSigDescHandle)) {
-
-                for (j=0; IPdu->ComIPduGwMapSigDescHandle[j] != INVALID_GWSIGNAL_DESCRIPTION_HANDLE; j++){
-                    srcSigDescHandle = IPdu->ComIPduGwMapSigDescHandle[j];
-                    gwSrcPtr = GET_ArcGwSrcSigDesc(srcSigDescHandle);
-                    /* Use ComSignalRoutingReq variable for updated signal indication to avoid data consistency problems */
-                    gwSrcPtr->ComSignalRoutingReq= gwSrcPtr->ComSignalUpdatedGwRouting;
-                    gwSrcPtr->ComSignalUpdatedGwRouting = FALSE;
-                }
+        }
+        /* notify with the DM callbacks registered */
+        /* @req  COM554 */
+        /* @req  COM304 */
+        if(TRUE == dmTimeOut){
+            if ((signal->ComTimeoutNotification != COM_NO_FUNCTION_CALLOUT) &&
+                (ComNotificationCallouts[signal->ComTimeoutNotification] != NULL) ) {
+                 ComNotificationCallouts[signal->ComTimeoutNotification]();
+            }
+#if (COM_OSEKNM_SUPPORT == STD_ON)
+            if (signal->ComOsekNmNetId != COM_OSEKNM_INVALID_NET_ID) {
+                OsekNm_TimeoutNotification(signal->ComOsekNmNetId, signal->ComOsekNmNodeId);
             }
 #endif
-            SchM_Exit_Com_EA_0();
         }
     }
 }
@@ -293,101 +772,40 @@ void Com_MainFunctionRx(void) {
 /**
  * Tx Main function- called from the task context
  * Processes the PDUS of all the tx modes, handles the timing functionalities/timers
+ * Only the started Tx IPdus with something to do in this tick are visited.
  * @param void
  * @return none
  */
 void Com_MainFunctionTx(void) {
     /* !req	COM789 */
-    boolean dmTimeOut;
     /* @req COM665 */
     if( COM_INIT != Com_GetStatus() ) {
         DET_REPORTERROR(COM_MAINFUNCTIONTX_ID, COM_E_UNINIT);
         /*lint -e{904} Return statement is necessary in case of reporting a DET error */
         return;
     }
-    const ComIPdu_type *IPdu;
-    for (uint16 i = 0; 0 == ComConfig->ComIPdu[i].Com_Arc_EOL; i++) {
-        IPdu = &ComConfig->ComIPdu[i];
-        Com_Arc_IPdu_type *Arc_IPdu = GET_ArcIPdu(i);
-        dmTimeOut  = FALSE;
-        /* Is this a IPdu that should be transmitted?*/
-        if ( (IPdu->ComIPduDirection == COM_SEND) && (TRUE == Arc_IPdu->Com_Arc_IpduStarted) ) {
-            const ComTxMode_type *txModePtr;
-            if( TRUE == Arc_IPdu->Com_Arc_IpduTxMode ) {
-                txModePtr = &IPdu->ComTxIPdu.ComTxModeTrue;
-            }
-            else {
-                txModePtr = &IPdu->ComTxIPdu.ComTxModeFalse;
-            }
-            SchM_Enter_Com_EA_0();
-            /* Decrease minimum delay timer*/
-            timerDec(Arc_IPdu->Com_Arc_TxIPduTimers.ComTxIPduMinimumDelayTimer);
-
-             if(0 < Arc_IPdu->Com_Arc_TxDeadlineCounter) /* if DM configured for this TX pdu */
-             {
-               /* Decrement Tx deadline monitoring timer.*/
-                 if(0 < Arc_IPdu->Com_Arc_TxIPduTimers.ComTxDMTimer){ /* if DM timer is running */
-                     timerDec(Arc_IPdu->Com_Arc_TxIPduTimers.ComTxDMTimer);
-                     if(Arc_IPdu->Com_Arc_TxIPduTimers.ComTxDMTimer == 0){/* if timed out */
-                         dmTimeOut = TRUE;
-                         /*NOTE : it could happen that a new request arrive via Com_SendSignalGroup() or Com_SendSignal() or
-                          * Com_SendDynamicSignal() during wait for last request(at this time) hence DM timer would be restarted there
-                          * */
-                     }
-                 }
-             }
-
-            /* If IPDU has periodic or mixed transmission mode.*/
-            if ( (txModePtr->ComTxModeMode == COM_PERIODIC)
-                || (txModePtr->ComTxModeMode == COM_MIXED) ) {
-                Com_ProcessMixedOrPeriodicTxMode(i,dmTimeOut);
-
-            /* If IPDU has direct transmission mode.*/
-            } else if (txModePtr->ComTxModeMode == COM_DIRECT) {
-                Com_ProcessDirectTxMode(i,dmTimeOut);
-            }
-            /* The IDPU has NONE transmission mode.*/
-            /* @req COM135 */
-            /* !req  COM835 */
-            else {
-                /* Don't send!*/
-            }
-
-            SchM_Exit_Com_EA_0();
-
-            /* Check notifications */
-            boolean confirmationStatus = Com_Misc_GetTxConfirmationStatus(IPdu);
-            Com_Misc_SetTxConfirmationStatus(IPdu, FALSE);
-
-            /* !req  COM708 */
-            for (uint16 signalIndex = 0;  (IPdu->ComIPduSignalRef != NULL) &&
-                (IPdu->ComIPduSignalRef[signalIndex] != NULL); signalIndex++)
-            {
-                const ComSignal_type *signal = IPdu->ComIPduSignalRef[signalIndex];
-                if(TRUE == confirmationStatus)
-                {
-                    if ((signal->ComNotification != COM_NO_FUNCTION_CALLOUT) &&
-                        (ComNotificationCallouts[signal->ComNotification] != NULL) ) {
-                         ComNotificationCallouts[signal->ComNotification]();
-                    }
-                }
-                /* notify with the DM callbacks registered */
-                /* @req  COM554 */
-                /* @req  COM304 */
-                if(TRUE == dmTimeOut){
-                    if ((signal->ComTimeoutNotification != COM_NO_FUNCTION_CALLOUT) &&
-                        (ComNotificationCallouts[signal->ComTimeoutNotification] != NULL) ) {
-                         ComNotificationCallouts[signal->ComTimeoutNotification]();
-                    }
-#if (COM_OSEKNM_SUPPORT == STD_ON)
-                    if (signal->ComOsekNmNetId != COM_OSEKNM_INVALID_NET_ID) {
-                        OsekNm_TimeoutNotification(signal->ComOsekNmNetId, signal->ComOsekNmNodeId);
-                    }
-#endif
-                }
-            }
+    Com_Lock_EnterSched();
+    Com_TxTick++;
+    Com_TxTickRunning = TRUE;
+    uint32 slot = Com_TxTick & COM_TX_SCHED_WHEEL_MASK;
+    /* IPdus linked into this slot while processing it are due in this tick too */
+    uint16 pduId = Com_TxWheel[slot];
+    while (COM_TX_NONE != pduId) {
+        Com_Arc_IPdu_type *Arc_IPdu = GET_ArcIPdu(pduId);
+        Com_Sched_TxUnlink(Arc_IPdu);
+        if (Arc_IPdu->Com_Arc_TxDue == Com_TxTick) {
+            /* The IPdu lock is taken before the sched lock, never after */
+            Com_Lock_ExitSched();
+            Com_Sched_TxProcessPdu(pduId);
+            Com_Lock_EnterSched();
+        } else {
+            /* Due beyond the wheel */
+            Com_Sched_TxLink(pduId, Arc_IPdu);
         }
+        pduId = Com_TxWheel[slot];
     }
+    Com_TxTickRunning = FALSE;
+    Com_Lock_ExitSched();
 }
 
 
@@ -443,9 +861,10 @@ void Com_MainFunctionRouteSignals( void ) {
 
             if (TRUE == isUpdated) {
 
-                SchM_Enter_Com_EA_0();
+                iPduHandle = ((const ComSignal_type *)comSignalSrc)->ComIPduHandleId;
+                Com_Lock_EnterIPdu(iPduHandle);
                 Com_Misc_CopySignalGroupDataFromPduToShadowBuffer(sigHandle);
-                SchM_Exit_Com_EA_0();
+                Com_Lock_ExitIPdu(iPduHandle);
 
                 for (j=0;j < ComConfig->ComGwMappingRef[i].ComGwNoOfDesitnationRoutes;j++) {
 
@@ -460,14 +879,17 @@ void Com_MainFunctionRouteSignals( void ) {
                     destDataPtr = (uint8 *)((arcSignalDest)->Com_Arc_ShadowBuffer);
                     /* Manage Signal group routing as one consistent block by utilizing shadow buffer */
                     /* @req COM383 */
-                    SchM_Enter_Com_EA_0();
+                    /* Source (Rx) before destination (Tx) IPdu, see Com_Com.h */
+                    Com_Lock_EnterIPdu(iPduHandle);
+                    Com_Lock_EnterIPdu(comSignalDest->ComIPduHandleId);
 
                     for (byteCnt=0; byteCnt<noOfBytes; byteCnt++){
                         destDataPtr[destByteNo] = srcDataPtr[srcByteNo];
                         destByteNo++;
                         srcByteNo++;
                     }
-                    SchM_Exit_Com_EA_0();
+                    Com_Lock_ExitIPdu(comSignalDest->ComIPduHandleId);
+                    Com_Lock_ExitIPdu(iPduHandle);
                     (void)Com_SendSignalGroup(sigHandle); /*Update destination IPdu ram buffer*/
                 }
             }
@@ -158,14 +158,15 @@ boolean Com_Misc_validateIPduCounter(const ComIPduCounter_type *CounterCfgRef, c
 
 /**
  * Routine to handle new repetitions based on Transfer property if some transmit repetitions are already in progress
- * correspondingly tx deadline counter is embedded with repetitions
+ * correspondingly tx deadline counter is embedded with repetitions.
+ * Called with the IPdu locked.
  * @param iPdu
  * @param arcIPdu
  * @param dataChanged
  * @param transferProperty
  * @return TRUE: Operation sucessful, FALSE: operation failed
  */
-boolean Com_Misc_TriggerTxOnConditions(uint16 pduHandleId, boolean dataChanged, ComTransferPropertyType transferProperty)
+boolean Com_Misc_TriggerTxOnConditions_Locked(uint16 pduHandleId, boolean dataChanged, ComTransferPropertyType transferProperty)
 {
     const ComIPdu_type *IPdu = GET_IPdu(pduHandleId);
     Com_Arc_IPdu_type *Arc_IPdu = GET_ArcIPdu(pduHandleId);
@@ -181,6 +182,7 @@ boolean Com_Misc_TriggerTxOnConditions(uint16 pduHandleId, boolean dataChanged,
         else {
             txModePtr = &IPdu->ComTxIPdu.ComTxModeFalse;
         }
+        Com_Sched_TxSync(pduHandleId);
         /* If signal has triggered transmit property, trigger a transmission!*/
         /** Signal Requirements */
         /* @req COM767 */
@@ -227,7 +229,7 @@ boolean Com_Misc_TriggerTxOnConditions(uint16 pduHandleId, boolean dataChanged,
                 if (nofReps > 0) {
                     /* @req COM625 */
                     /* @req COM701 *//* Routing is independent of DM. A new Transmission cycle is started for GW routing request */
-                    txTrigSts = Com_Misc_TriggerIPDUSend(pduHandleId);
+                    txTrigSts = Com_Misc_TriggerIPDUSend_Locked(pduHandleId);
 
                     if(COM_TX_TRIGGERED ==  txTrigSts) {
                         /* Transmission triggered */
@@ -264,6 +266,7 @@ boolean Com_Misc_TriggerTxOnConditions(uint16 pduHandleId, boolean dataChanged,
                 }
             }
         }
+        Com_Sched_TxSchedule(pduHandleId);
         ret = TRUE;
     }
 
@@ -717,7 +720,7 @@ void Com_Misc_RxProcessSignals(const ComIPdu_type *IPdu,const Com_Arc_IPdu_type
             if (comSignal->ComTimeoutFactor > 0) { /* If reception deadline monitoring is used.*/
                 /* Reset the deadline monitoring timer.*/
                 /* @req COM715 */
-                Arc_Signal->Com_Arc_DeadlineCounter = comSignal->ComTimeoutFactor;
+                Com_Sched_RxDeadlineArm(comSignal->ComHandleId, comSignal->ComTimeoutFactor);
             }
 
 #if (COM_SIG_GATEWAY_ENABLE == STD_ON)
@@ -764,7 +767,14 @@ void Com_Misc_RxProcessSignals(const ComIPdu_type *IPdu,const Com_Arc_IPdu_type
             }
         }
     }
+    if (TRUE == IPdu->ComIPduGwRoutingReq) {
+        Com_Sched_RxPendingAdd(getPduId(IPdu));
+    }
 #endif
+    if (IPdu->ComIPduSignalProcessing == COM_DEFERRED) {
+        /* Signals are notified from Com_MainFunctionRx */
+        Com_Sched_RxPendingAdd(getPduId(IPdu));
+    }
 }
 
 /**
@@ -786,7 +796,8 @@ void Com_Misc_TxHandleDM(const ComIPdu_type *IPdu, Com_Arc_IPdu_type *Arc_IPdu)
         else {
             txModePtr = &IPdu->ComTxIPdu.ComTxModeFalse;
         }
-        SchM_Enter_Com_EA_0();
+        Com_Lock_EnterIPdu(getPduId(IPdu));
+        Com_Sched_TxSync(getPduId(IPdu));
         switch( txModePtr->ComTxModeMode ) {
             /* @req COM308 */
             /* @req COM305.3 */
@@ -824,7 +835,8 @@ void Com_Misc_TxHandleDM(const ComIPdu_type *IPdu, Com_Arc_IPdu_type *Arc_IPdu)
                 break;
 
         }
-        SchM_Exit_Com_EA_0();
+        Com_Sched_TxSchedule(getPduId(IPdu));
+        Com_Lock_ExitIPdu(getPduId(IPdu));
     }
 }
 
@@ -840,14 +852,22 @@ void Com_Misc_UpdateShadowSignal(Com_SignalIdType SignalId, const void *SignalDa
     /* @req COM632 */
     /* @req COM633 */ /* Sign extension? */
     boolean dataChanged = FALSE;
-    Com_Misc_WriteSignalDataToPdu(
-            SignalDataPtr,
-            GroupSignal->ComSignalType,
-            Arc_GroupSignal->Com_Arc_ShadowBuffer,
-            GroupSignal->ComBitPosition,
-            GroupSignal->ComBitSize,
-            GroupSignal->ComSignalEndianess,
-            &dataChanged);
+    /* The shadow buffer is protected by the lock of the signal group's IPdu */
+    uint16 pduId = GET_Signal(GroupSignal->ComSigGrpHandleId)->ComIPduHandleId;
+    Com_Lock_EnterIPdu(pduId);
+    if (NULL != GroupSignal->ComSignalArcPack) {
+        (void)GroupSignal->ComSignalArcPack(SignalDataPtr, Arc_GroupSignal->Com_Arc_ShadowBuffer);
+    } else {
+        Com_Misc_WriteSignalDataToPdu(
+                SignalDataPtr,
+                GroupSignal->ComSignalType,
+                Arc_GroupSignal->Com_Arc_ShadowBuffer,
+                GroupSignal->ComBitPosition,
+                GroupSignal->ComBitSize,
+                GroupSignal->ComSignalEndianess,
+                &dataChanged);
+    }
+    Com_Lock_ExitIPdu(pduId);
 }
 
 /* Helpers for getting and setting that a TX PDU confirmation status
@@ -887,11 +907,12 @@ boolean Com_Misc_GetTxConfirmationStatus(const ComIPdu_type *IPdu) {
 
 /**
  * Implements functionality for Com_TriggerIPDUSend but returns
- * wether transmission was triggered or not
+ * wether transmission was triggered or not.
+ * Called with the IPdu locked.
  * @param PduId
  * @return COM_TX_TRIGGERED: Tx was triggered, COM_TX_NOT_TRIGGERED: Not triggered
  */
-ComTxTriggerStatusType Com_Misc_TriggerIPDUSend(PduIdType PduId) {
+ComTxTriggerStatusType Com_Misc_TriggerIPDUSend_Locked(PduIdType PduId) {
 #if(COM_IPDU_COUNTING_ENABLE ==  STD_ON )
     uint16 cntrIdx = 0;
     uint8 cntrVal = 0;
@@ -901,7 +922,7 @@ ComTxTriggerStatusType Com_Misc_TriggerIPDUSend(PduIdType PduId) {
     ComTxTriggerStatusType txTriggerStatus = COM_TX_NOT_TRIGGERED;
     const ComIPdu_type *IPdu = GET_IPdu(PduId);
     Com_Arc_IPdu_type *Arc_IPdu = GET_ArcIPdu(PduId);
-    SchM_Enter_Com_EA_0();
+    Com_Sched_TxSync(PduId);
 
     /* Is the IPdu ready for transmission?*/
     /* @req COM388 */
@@ -983,13 +1004,21 @@ ComTxTriggerStatusType Com_Misc_TriggerIPDUSend(PduIdType PduId) {
             /* @req COM471 */
             /* @req COM698 */
             Arc_IPdu->Com_Arc_TxIPduTimers.ComTxIPduMinimumDelayTimer = IPdu->ComTxIPdu.ComTxIPduMinimumDelayFactor;
+            Com_Sched_TxSchedule(PduId);
         }
     } else {
         /* Not time for transmission */
         txTriggerStatus = COM_TX_MIN_DELAY_NOT_FULFILLED;
     }
 
-    SchM_Exit_Com_EA_0();
+    return txTriggerStatus;
+}
+
+ComTxTriggerStatusType Com_Misc_TriggerIPDUSend(PduIdType PduId) {
+    ComTxTriggerStatusType txTriggerStatus;
+    Com_Lock_EnterIPdu(PduId);
+    txTriggerStatus = Com_Misc_TriggerIPDUSend_Locked(PduId);
+    Com_Lock_ExitIPdu(PduId);
     return txTriggerStatus;
 }
 
@@ -1078,6 +1107,7 @@ void Com_Misc_RouteGwDestnSignals(uint8 gwMapidx, const uint8 * SignalDataPtr,Co
             break;
         }
 
+        Com_Lock_EnterIPdu(iPduHandle);
         /* Endianness conversion is handled by Com_Misc_WriteSignalDataToPdu() */
         /* @req COM360 */
         /* @req COM362 */
@@ -1098,8 +1128,6 @@ void Com_Misc_RouteGwDestnSignals(uint8 gwMapidx, const uint8 * SignalDataPtr,Co
             SETBIT(comIPduDataPtr, ubitPos);
         }
 
-        SchM_Enter_Com_EA_0();
-
         if (COM_GROUP_SIGNAL_REFERENCE == gwSignalRef) {
             /* Copy from shadow buffer to IPdu ram buffer */
             Com_Misc_CopySignalGroupDataFromShadowBufferToPdu(sigHandle,FALSE,&dataChanged);
@@ -1112,8 +1140,8 @@ void Com_Misc_RouteGwDestnSignals(uint8 gwMapidx, const uint8 * SignalDataPtr,Co
             }
         }
         /* Assign the number of repetitions based on Transfer property */
-        (void)Com_Misc_TriggerTxOnConditions(iPduHandle, dataChanged, transferProperty);
-        SchM_Exit_Com_EA_0();
+        (void)Com_Misc_TriggerTxOnConditions_Locked(iPduHandle, dataChanged, transferProperty);
+        Com_Lock_ExitIPdu(iPduHandle);
         /*lint -restore */
     }
 }
@@ -1137,6 +1165,7 @@ void Com_Misc_ExtractGwSrcSigData(const void* comSignalSrc, uint16 iPduHandle,ui
         pduDataPtr = arcIPduSrc->ComIPduDataPtr;
     }
 
+    Com_Lock_EnterIPdu(iPduHandle);
     if ((COM_UINT8_N != pduInfo->ComSignalType) && (COM_UINT8_DYN != pduInfo->ComSignalType)) {
 
         Com_Misc_ReadSignalDataFromPdu(
@@ -1149,10 +1178,9 @@ void Com_Misc_ExtractGwSrcSigData(const void* comSignalSrc, uint16 iPduHandle,ui
     } else {
 
         startFromPduByte = (pduInfo->ComBitPosition) / 8;
-        SchM_Enter_Com_EA_0();
         memcpy(SigDataPtr, (&pduDataPtr[startFromPduByte]), (pduInfo->ComBitSize)/8);
-        SchM_Exit_Com_EA_0();
     }
+    Com_Lock_ExitIPdu(iPduHandle);
 
 }
 #endif
@@ -39,6 +39,7 @@
 #include "Std_Types.h"
 #include "arch/sys_arch.h"
 #include "Mcu.h"
+#include "arena.h"
 #include <string.h>
 
 static void (*tcpip_thread)(void *arg) = NULL;
@@ -134,9 +135,9 @@ err_t sys_mbox_new(sys_mbox_t *mbox, int size)
     lwip_port_stats.mbox_new++;
 
     if(size==0){size=20;}
-    *mbox = malloc( sizeof(OsMBoxType) + sizeof(OsMBoxMsg) * size );
+    *mbox = Arena_Alloc( sizeof(OsMBoxType) + sizeof(OsMBoxMsg) * size );
 
-    if( mbox == NULL ) {
+    if( *mbox == NULL ) {
         rv = ERR_MEM;
         lwip_port_stats.mbox_new_err++;
     } else {
@@ -159,7 +160,7 @@ err_t sys_mbox_new(sys_mbox_t *mbox, int size)
 void sys_mbox_free(sys_mbox_t *mbox)
 {
     lwip_port_stats.sem_free++;
-    free(*mbox);
+    Arena_Free(*mbox);
     *mbox = SYS_MBOX_NULL;
 }
 
@@ -274,7 +275,7 @@ u32_t sys_arch_mbox_fetch(sys_mbox_t *mbox, void **msg, u32_t timeout_ms)
 err_t sys_sem_new(sys_sem_t *sem, u8_t count)
 {
     lwip_port_stats.sem_new++;
-    *sem = malloc( sizeof(OsSemType) );
+    *sem = Arena_Alloc( sizeof(OsSemType) );
 
     if( *sem == NULL ) {
         lwip_port_stats.sem_new_err++;
@@ -349,7 +350,7 @@ void sys_sem_signal(sys_sem_t *sem)
 void sys_sem_free(sys_sem_t *sem)
 {
     lwip_port_stats.sem_free++;
-    free(*sem);
+    Arena_Free(*sem);
     *sem = SYS_SEM_NULL;
 }
 
@@ -1,5 +1,6 @@
 ifneq ($(filter y,$(USE_RTE) $(USE_QUEUE)),)
 obj-$(USE_QUEUE) += Queue.o
+obj-$(USE_QUEUE) += PrioQueue.o
 
 
 inc-y += $(ROOTDIR)/datastructures/Queue/inc
@@ -0,0 +1,138 @@
+/*-------------------------------- Arctic Core ------------------------------
+ * Copyright (C) 2013, ArcCore AB, Sweden, www.arccore.com.
+ * Contact: <contact@arccore.com>
+ *
+ * You may ONLY use this file:
+ * 1)if you have a valid commercial ArcCore license and then in accordance with
+ * the terms contained in the written license agreement between you and ArcCore,
+ * or alternatively
+ * 2)if you follow the terms found in GNU General Public License version 2 as
+ * published by the Free Software Foundation and appearing in the file
+ * LICENSE.GPL included in the packaging of this file or here
+ * <http://www.gnu.org/licenses/old-licenses/gpl-2.0.txt>
+ *-------------------------------- Arctic Core -----------------------------*/
+
+#ifndef PRIOQUEUE_H_
+#define PRIOQUEUE_H_
+
+/*
+ * Priority queue, a binary heap.
+ *
+ * - Add and Next are O(log N), Peek is O(1).
+ * - Contains is O(1) with a key index, see PrioQueue_SetKeyIndex().
+ * - Elements with the same priority are not kept in FIFO order.
+ * - With a stage, see PrioQueue_SetStage(), Add is lock-free from any
+ *   number of producers and Next/Peek/Contains are called from one
+ *   consumer only, no locks are taken. Otherwise all calls suspend OS
+ *   interrupts like Queue.c.
+ */
+
+#include "Queue.h"
+#include "cirq_buffer.h"
+
+typedef struct prio_queue {
+    /* The max number of elements in the heap */
+    uint16 max_count;
+    uint16 count;
+
+    /* Error flag, without a stage */
+    boolean bufFullFlag;
+
+    /* If queue is initiated */
+    boolean isInit;
+
+    /* Size of the elements in the heap */
+    size_t dataSize;
+
+    /* The heap, element 0 is served next */
+    uint8 *buf;
+
+    /* < 0 if the first element shall be served before the second */
+    cmpFunc prio_func;
+
+    /* Optional key index */
+    keyFunc key_func;
+    uint16 *keyCnt;
+    uint16 keyRange;
+
+    /* Optional lock-free stage */
+    CirqBuffLfType *stage;
+    uint32 stageFull;       /* Error flag of the stage, atomic */
+} PrioQueue_t;
+
+/**
+ * @brief Initiates the queue
+ *
+ * @param queue         Address of the queue to be initialized
+ * @param buffer        max_count * dataSize bytes for the heap
+ * @param max_count     Maximum number of elements that the queue can contain
+ * @param dataSize      The size of each element in the queue.
+ * @param prio_func     Returns < 0 if the first element shall be served before the second
+ *
+ * @return      QUEUE_E_OK - if successfully initialized.
+ * @return      QUEUE_E_ALREADY_INIT - queue already initiated
+ */
+Queue_ReturnType PrioQueue_Init(PrioQueue_t *queue, void *buffer, uint16 max_count,
+        size_t dataSize, cmpFunc prio_func);
+
+/**
+ * @brief Keep a count of queued elements per key, makes PrioQueue_Contains() O(1).
+ *        Must be called on an empty queue.
+ *
+ * @param key_func  Key of an element, elements with equal keys are equal
+ * @param keyCnt    keyRange counters, owned by the queue
+ * @param keyRange  Number of keys
+ *
+ * @return      QUEUE_E_OK, QUEUE_E_NULL, QUEUE_E_NO_INIT or QUEUE_E_FALSE if not empty
+ */
+Queue_ReturnType PrioQueue_SetKeyIndex(PrioQueue_t *queue, keyFunc key_func,
+        uint16 *keyCnt, uint16 keyRange);
+
+/**
+ * @brief Lock-free single consumer mode. PrioQueue_Add() pushes to the
+ *        stage and the consumer moves staged elements into the heap.
+ *        Must be called on an empty queue before any producer runs.
+ *
+ * @param stage     Buffer initialized with CirqBuffLf_Init(CIRQBUFF_MPSC, ..., dataSize)
+ *
+ * @return      QUEUE_E_OK, QUEUE_E_NULL, QUEUE_E_NO_INIT or QUEUE_E_FALSE if not empty
+ */
+Queue_ReturnType PrioQueue_SetStage(PrioQueue_t *queue, CirqBuffLfType *stage);
+
+/**
+ * @brief Add an element to the queue
+ *
+ * @return      QUEUE_E_OK - if successfully added.
+ * @return      QUEUE_E_NO_INIT - the queue pointed to has not been initiated by PrioQueue_Init()
+ * @return      QUEUE_E_FULL    - Queue (or stage) is full.
+ */
+Queue_ReturnType PrioQueue_Add(PrioQueue_t *queue, void const *dataPtr);
+
+/**
+ * @brief Get the element with the highest priority. This removes it from the queue.
+ *
+ * @return      QUEUE_E_OK - if successfully popped.
+ * @return      QUEUE_E_NO_INIT - the queue pointed to has not been initiated by PrioQueue_Init()
+ * @return      QUEUE_E_NO_DATA - nothing popped (it was empty)
+ * @return      QUEUE_E_LOST_DATA - if a buffer overflow has occurred previously
+ */
+Queue_ReturnType PrioQueue_Next(PrioQueue_t *queue, void *dataPtr);
+
+/**
+ * @brief Peek at the element with the highest priority.
+ *
+ * @return      QUEUE_E_OK, QUEUE_E_NO_INIT or QUEUE_E_NO_DATA
+ */
+Queue_ReturnType PrioQueue_Peek(PrioQueue_t *queue, void *dataPtr);
+
+/**
+ * @brief Checks if an element with the same key is queued.
+ *
+ * @return      QUEUE_E_TRUE - if queue contains the element
+ * @return      QUEUE_E_FALSE - if the element could not be found in the queue
+ * @return      QUEUE_E_NO_INIT - the queue pointed to has not been initiated by PrioQueue_Init()
+ * @return      QUEUE_E_NO_CONTAINS - no key index set
+ */
+Queue_ReturnType PrioQueue_Contains(PrioQueue_t *queue, void const *dataPtr);
+
+#endif /* PRIOQUEUE_H_ */
@@ -43,6 +43,9 @@ typedef uint8 Queue_ReturnType;
 /* @req ARC_SWS_Queue_00008*/
 typedef int (*cmpFunc)(void *, void *, size_t);
 
+/* Key of an element, 0..keyRange-1, for Contains() in O(1) */
+typedef uint16 (*keyFunc)(void const *);
+
 #define QUEUE_DEFS
 #endif
 
@@ -58,8 +61,8 @@ typedef int (*cmpFunc)(void *, void *, size_t);
 
 typedef struct queue {
     /* The max number of elements in the list */
-    uint8 max_count;
-    uint8 count;
+    uint16 max_count;
+    uint16 count;
 
     /* Error flag */
     boolean bufFullFlag;
@@ -96,7 +99,7 @@ typedef struct queue {
  * @return      QUEUE_E_OK - if successfully initialized.
  * @return      QUEUE_E_ALREADY_INIT - queue already initiated
  */
-Queue_ReturnType Queue_Init(Queue_t *queue, void *buffer, uint8 max_count,
+Queue_ReturnType Queue_Init(Queue_t *queue, void *buffer, uint16 max_count,
         size_t dataSize, cmpFunc compare_func);
 /**
  * @brief Add an element to the queue
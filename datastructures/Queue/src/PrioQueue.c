@@ -0,0 +1,307 @@
+/*-------------------------------- Arctic Core ------------------------------
+ * Copyright (C) 2013, ArcCore AB, Sweden, www.arccore.com.
+ * Contact: <contact@arccore.com>
+ *
+ * You may ONLY use this file:
+ * 1)if you have a valid commercial ArcCore license and then in accordance with
+ * the terms contained in the written license agreement between you and ArcCore,
+ * or alternatively
+ * 2)if you follow the terms found in GNU General Public License version 2 as
+ * published by the Free Software Foundation and appearing in the file
+ * LICENSE.GPL included in the packaging of this file or here
+ * <http://www.gnu.org/licenses/old-licenses/gpl-2.0.txt>
+ *-------------------------------- Arctic Core -----------------------------*/
+#include "PrioQueue.h"
+#include "arc_atomic.h"
+
+/*
+ *  A binary heap implementation of a priority queue, see PrioQueue.h.
+ */
+
+/* Locks are only needed when producers and consumer share the heap */
+#define PRIOQUEUE_LOCK(_q)      if ((_q)->stage == NULL_PTR) { SYS_CALL_SuspendOSInterrupts(); }
+#define PRIOQUEUE_UNLOCK(_q)    if ((_q)->stage == NULL_PTR) { SYS_CALL_ResumeOSInterrupts(); }
+
+/* stageFull is set by any producer and cleared by the consumer */
+#if defined(__GNUC__)
+#define PRIOQUEUE_STAGE_FULL_SET(_q)    __atomic_store_n(&(_q)->stageFull, 1u, __ATOMIC_RELAXED)
+#define PRIOQUEUE_STAGE_FULL_TAKE(_q)   (__atomic_exchange_n(&(_q)->stageFull, 0u, __ATOMIC_RELAXED) != 0u)
+#else
+static inline boolean prioqueue_stage_full_take(PrioQueue_t *queue) {
+    uint32 old = 1u;
+    return Arc_AtomicCas32(&queue->stageFull, &old, 0u);
+}
+#define PRIOQUEUE_STAGE_FULL_SET(_q)    Arc_AtomicStoreRel32(&(_q)->stageFull, 1u)
+#define PRIOQUEUE_STAGE_FULL_TAKE(_q)   prioqueue_stage_full_take(_q)
+#endif
+
+static inline uint8 *prioqueue_elem(PrioQueue_t const *queue, uint32 idx) {
+    return &queue->buf[idx * queue->dataSize];
+}
+
+static void prioqueue_swap(uint8 *a, uint8 *b, size_t size) {
+    for (size_t i = 0u; i < size; i++) {
+        uint8 t = a[i];
+        a[i] = b[i];
+        b[i] = t;
+    }
+}
+
+static void prioqueue_key_update(PrioQueue_t *queue, void const *dataPtr, boolean add) {
+    if (queue->key_func != NULL_PTR) {
+        uint16 key = queue->key_func(dataPtr);
+        if (key < queue->keyRange) {
+            if (add == TRUE) {
+                queue->keyCnt[key]++;
+            } else if (queue->keyCnt[key] > 0u) {
+                queue->keyCnt[key]--;
+            } else {
+                /* Not counted */
+            }
+        }
+    }
+}
+
+/* Insert the element already copied to the first free slot */
+static void prioqueue_insert(PrioQueue_t *queue) {
+    uint32 idx = queue->count;
+
+    queue->count++;
+    prioqueue_key_update(queue, prioqueue_elem(queue, idx), TRUE);
+
+    /* Sift up */
+    while (idx > 0u) {
+        uint32 parent = (idx - 1u) / 2u;
+        if (queue->prio_func(prioqueue_elem(queue, idx), prioqueue_elem(queue, parent), queue->dataSize) >= 0) {
+            break;
+        }
+        prioqueue_swap(prioqueue_elem(queue, idx), prioqueue_elem(queue, parent), queue->dataSize);
+        idx = parent;
+    }
+}
+
+/* Insert into the heap, the caller has checked that there is room */
+static void prioqueue_push(PrioQueue_t *queue, void const *dataPtr) {
+    MEMCPY(prioqueue_elem(queue, queue->count), dataPtr, queue->dataSize);
+    prioqueue_insert(queue);
+}
+
+/* Remove the top of the heap, the caller has checked that there is one */
+static void prioqueue_pop(PrioQueue_t *queue, void *dataPtr) {
+    uint32 idx = 0u;
+
+    MEMCPY(dataPtr, prioqueue_elem(queue, 0u), queue->dataSize);
+    prioqueue_key_update(queue, dataPtr, FALSE);
+    queue->count--;
+    if (queue->count == 0u) {
+        return;
+    }
+    MEMCPY(prioqueue_elem(queue, 0u), prioqueue_elem(queue, queue->count), queue->dataSize);
+
+    /* Sift down */
+    for (;;) {
+        uint32 left = (2u * idx) + 1u;
+        uint32 best = idx;
+
+        if ((left < queue->count) &&
+            (queue->prio_func(prioqueue_elem(queue, left), prioqueue_elem(queue, best), queue->dataSize) < 0)) {
+            best = left;
+        }
+        if (((left + 1u) < queue->count) &&
+            (queue->prio_func(prioqueue_elem(queue, left + 1u), prioqueue_elem(queue, best), queue->dataSize) < 0)) {
+            best = left + 1u;
+        }
+        if (best == idx) {
+            break;
+        }
+        prioqueue_swap(prioqueue_elem(queue, idx), prioqueue_elem(queue, best), queue->dataSize);
+        idx = best;
+    }
+}
+
+/* Consumer side, move staged elements into the heap */
+static void prioqueue_drain(PrioQueue_t *queue) {
+    if (queue->stage != NULL_PTR) {
+        /* The free heap slot is used as landing area */
+        while ((queue->count < queue->max_count) &&
+               (CirqBuffLf_Pop(queue->stage, prioqueue_elem(queue, queue->count)) == 0)) {
+            prioqueue_insert(queue);
+        }
+    }
+}
+
+Queue_ReturnType PrioQueue_Init(PrioQueue_t *queue, void *buffer, uint16 max_count,
+        size_t dataSize, cmpFunc prio_func) {
+    SYS_CALL_SuspendOSInterrupts();
+
+    if ((queue == NULL_PTR) || (buffer == NULL_PTR) || (prio_func == NULL_PTR)) {
+        SYS_CALL_ResumeOSInterrupts();
+        /*lint -e904 MISRA:OTHER:Validation of parameters, if failure, function will return.This is not inline with Table 8, ISO26262-6-2011, Req 1a:[MISRA 2012 Rule 15.5, advisory]*/
+        return QUEUE_E_NULL;
+    }
+
+    if (queue->isInit == TRUE) {
+        SYS_CALL_ResumeOSInterrupts();
+        return QUEUE_E_ALREADY_INIT;
+    }
+
+    queue->buf = buffer;
+    queue->dataSize = dataSize;
+    queue->count = 0u;
+    queue->max_count = max_count;
+    queue->prio_func = prio_func;
+    queue->key_func = NULL_PTR;
+    queue->keyCnt = NULL_PTR;
+    queue->keyRange = 0u;
+    queue->stage = NULL_PTR;
+    queue->bufFullFlag = FALSE;
+    queue->stageFull = 0u;
+    queue->isInit = TRUE;
+
+    SYS_CALL_ResumeOSInterrupts();
+    return QUEUE_E_OK;
+}
+
+Queue_ReturnType PrioQueue_SetKeyIndex(PrioQueue_t *queue, keyFunc key_func,
+        uint16 *keyCnt, uint16 keyRange) {
+    Queue_ReturnType rv = QUEUE_E_OK;
+
+    if ((queue == NULL_PTR) || (key_func == NULL_PTR) || (keyCnt == NULL_PTR)) {
+        return QUEUE_E_NULL;
+    }
+
+    SYS_CALL_SuspendOSInterrupts();
+    if (queue->isInit != TRUE) {
+        rv = QUEUE_E_NO_INIT;
+    } else if (queue->count != 0u) {
+        rv = QUEUE_E_FALSE;
+    } else {
+        for (uint16 i = 0u; i < keyRange; i++) {
+            keyCnt[i] = 0u;
+        }
+        queue->key_func = key_func;
+        queue->keyCnt = keyCnt;
+        queue->keyRange = keyRange;
+    }
+    SYS_CALL_ResumeOSInterrupts();
+    return rv;
+}
+
+Queue_ReturnType PrioQueue_SetStage(PrioQueue_t *queue, CirqBuffLfType *stage) {
+    Queue_ReturnType rv = QUEUE_E_OK;
+
+    if ((queue == NULL_PTR) || (stage == NULL_PTR)) {
+        return QUEUE_E_NULL;
+    }
+
+    SYS_CALL_SuspendOSInterrupts();
+    if (queue->isInit != TRUE) {
+        rv = QUEUE_E_NO_INIT;
+    } else if ((queue->count != 0u) || (stage->mode != CIRQBUFF_MPSC) || (stage->dataSize != queue->dataSize)) {
+        rv = QUEUE_E_FALSE;
+    } else {
+        queue->stage = stage;
+    }
+    SYS_CALL_ResumeOSInterrupts();
+    return rv;
+}
+
+Queue_ReturnType PrioQueue_Add(PrioQueue_t *queue, void const *dataPtr) {
+    if ((queue == NULL_PTR) || (dataPtr == NULL_PTR)) {
+        /*lint -e904 MISRA:OTHER:Validation of parameters, if failure, function will return.This is not inline with Table 8, ISO26262-6-2011, Req 1a:[MISRA 2012 Rule 15.5, advisory]*/
+        return QUEUE_E_NULL;
+    }
+    if (queue->isInit != TRUE) {
+        return QUEUE_E_NO_INIT;
+    }
+
+    if (queue->stage != NULL_PTR) {
+        if (CirqBuffLf_Push(queue->stage, dataPtr) != 0) {
+            PRIOQUEUE_STAGE_FULL_SET(queue);
+            return QUEUE_E_FULL;
+        }
+        return QUEUE_E_OK;
+    }
+
+    SYS_CALL_SuspendOSInterrupts();
+    if (queue->count == queue->max_count) {
+        queue->bufFullFlag = TRUE;
+        SYS_CALL_ResumeOSInterrupts();
+        return QUEUE_E_FULL;
+    }
+    prioqueue_push(queue, dataPtr);
+    SYS_CALL_ResumeOSInterrupts();
+    return QUEUE_E_OK;
+}
+
+Queue_ReturnType PrioQueue_Next(PrioQueue_t *queue, void *dataPtr) {
+    if ((queue == NULL_PTR) || (dataPtr == NULL_PTR)) {
+        /*lint -e904 MISRA:OTHER:Validation of parameters, if failure, function will return.This is not inline with Table 8, ISO26262-6-2011, Req 1a:[MISRA 2012 Rule 15.5, advisory]*/
+        return QUEUE_E_NULL;
+    }
+    if (queue->isInit != TRUE) {
+        return QUEUE_E_NO_INIT;
+    }
+
+    PRIOQUEUE_LOCK(queue);
+    prioqueue_drain(queue);
+    if (queue->count == 0u) {
+        PRIOQUEUE_UNLOCK(queue);
+        return QUEUE_E_NO_DATA;
+    }
+    prioqueue_pop(queue, dataPtr);
+
+    if ((queue->stage != NULL_PTR) && PRIOQUEUE_STAGE_FULL_TAKE(queue)) {
+        return QUEUE_E_LOST_DATA;
+    }
+    if (queue->bufFullFlag == TRUE) {
+        queue->bufFullFlag = FALSE;
+        PRIOQUEUE_UNLOCK(queue);
+        return QUEUE_E_LOST_DATA;
+    }
+    PRIOQUEUE_UNLOCK(queue);
+    return QUEUE_E_OK;
+}
+
+Queue_ReturnType PrioQueue_Peek(PrioQueue_t *queue, void *dataPtr) {
+    if ((queue == NULL_PTR) || (dataPtr == NULL_PTR)) {
+        /*lint -e904 MISRA:OTHER:Validation of parameters, if failure, function will return.This is not inline with Table 8, ISO26262-6-2011, Req 1a:[MISRA 2012 Rule 15.5, advisory]*/
+        return QUEUE_E_NULL;
+    }
+    if (queue->isInit != TRUE) {
+        return QUEUE_E_NO_INIT;
+    }
+
+    PRIOQUEUE_LOCK(queue);
+    prioqueue_drain(queue);
+    if (queue->count == 0u) {
+        PRIOQUEUE_UNLOCK(queue);
+        return QUEUE_E_NO_DATA;
+    }
+    MEMCPY(dataPtr, prioqueue_elem(queue, 0u), queue->dataSize);
+    PRIOQUEUE_UNLOCK(queue);
+    return QUEUE_E_OK;
+}
+
+Queue_ReturnType PrioQueue_Contains(PrioQueue_t *queue, void const *dataPtr) {
+    Queue_ReturnType rv;
+    uint16 key;
+
+    if ((queue == NULL_PTR) || (dataPtr == NULL_PTR)) {
+        /*lint -e904 MISRA:OTHER:Validation of parameters, if failure, function will return.This is not inline with Table 8, ISO26262-6-2011, Req 1a:[MISRA 2012 Rule 15.5, advisory]*/
+        return QUEUE_E_NULL;
+    }
+    if (queue->isInit != TRUE) {
+        return QUEUE_E_NO_INIT;
+    }
+    if (queue->key_func == NULL_PTR) {
+        return QUEUE_E_NO_CONTAINS;
+    }
+
+    key = queue->key_func(dataPtr);
+    PRIOQUEUE_LOCK(queue);
+    prioqueue_drain(queue);
+    rv = ((key < queue->keyRange) && (queue->keyCnt[key] > 0u)) ? QUEUE_E_TRUE : QUEUE_E_FALSE;
+    PRIOQUEUE_UNLOCK(queue);
+    return rv;
+}
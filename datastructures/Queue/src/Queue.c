@@ -23,7 +23,7 @@
  *  A circular buffer implementation of fifo queue.*
  */
 /* @req ARC_SWS_Queue_00003 */
-Queue_ReturnType Queue_Init(Queue_t *queue, void *buffer, uint8 max_count,
+Queue_ReturnType Queue_Init(Queue_t *queue, void *buffer, uint16 max_count,
         size_t dataSize, cmpFunc cmp) {
     SYS_CALL_SuspendOSInterrupts();
 
@@ -150,7 +150,7 @@ Queue_ReturnType Queue_Peek(Queue_t const *queue, void *dataPtr) {
 }
 /* @req ARC_SWS_Queue_00007 */
 Queue_ReturnType Queue_Contains(Queue_t const *queue, void const *dataPtr) {
-    uint8 i;
+    uint16 i;
 
     SYS_CALL_SuspendOSInterrupts();
 
@@ -178,6 +178,9 @@ Queue_ReturnType Queue_Contains(Queue_t const *queue, void const *dataPtr) {
             return QUEUE_E_TRUE;
         }
         iter = iter + queue->dataSize; /*lint !e9016 MISRA:OTHER:correct arithmetic even if Array index is not used:[MISRA 2012 Rule 18.4, advisory]*/
+        if (iter == queue->bufEnd) {
+            iter = queue->bufStart;
+        }
     }
 
     SYS_CALL_ResumeOSInterrupts();
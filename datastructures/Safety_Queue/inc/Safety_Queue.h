@@ -44,6 +44,9 @@ typedef uint8 Queue_ReturnType;
 /* Compare function for contains */
 typedef int (*cmpFunc)(void *, void *, size_t);
 
+/* Key of an element, 0..keyRange-1, for Contains() in O(1) */
+typedef uint16 (*keyFunc)(void const *);
+
 #define QUEUE_DEFS
 #endif /* QUEUE_DEFS */
 
@@ -60,8 +63,8 @@ typedef int (*cmpFunc)(void *, void *, size_t);
 
 typedef struct safety_queue {
     /* The max number of elements in the list */
-    uint8 max_count;
-    uint8 count;
+    uint16 max_count;
+    uint16 count;
 
     /* Error flag */
     boolean bufFullFlag;
@@ -83,6 +86,13 @@ typedef struct safety_queue {
     /* Function pointer to compare function */
     cmpFunc compare_func;
 
+    /* Optional key index, see Safety_Queue_SetKeyIndex() */
+    keyFunc key_func;
+    uint16 *keyCnt;
+    uint16 keyRange;
+    /* CRC of keyCnt[], part of the queue struct CRC */
+    uint8 keyCrc;
+
     /* CRC Value, one for the buffer and one for the queue struct */
     uint8 bufferCrc;
     uint8 queueCrc;
@@ -103,7 +113,7 @@ typedef struct safety_queue {
  * @return      QUEUE_E_ALREADY_INIT - queue already initiated
  */
 Queue_ReturnType Safety_Queue_Init(Safety_Queue_t *queue, void *buffer,
-        uint8 max_count, size_t dataSize, cmpFunc compare_func);
+        uint16 max_count, size_t dataSize, cmpFunc compare_func);
 /**
  * @brief Add an element to the queue
  *
@@ -156,6 +166,23 @@ Queue_ReturnType Safety_Queue_Peek(Safety_Queue_t const *queue, void *dataPtr);
  */
 Queue_ReturnType Safety_Queue_Contains(Safety_Queue_t const *queue,
         void const *dataPtr);
+/**
+ * @brief Makes Safety_Queue_Contains() O(1). The queue counts the queued
+ *        elements per key and Contains() compares keys instead of scanning
+ *        with compare_func. Must be called on an empty queue.
+ *
+ * @param queue    Pointer to the queue that has been initialized with Safety_Queue_Init()
+ * @param key_func Key of an element, elements with equal keys are equal
+ * @param keyCnt   keyRange counters, owned by the queue and protected by its own CRC
+ * @param keyRange Number of keys
+ *
+ * @return      QUEUE_E_OK - if successfully set.
+ * @return      QUEUE_E_NO_INIT - the queue pointed to has not been initiated by Safety_Queue_Init()
+ * @return      QUEUE_E_CRC_ERR - CRC error indicates that the memory the queue resides in was compromised.
+ * @return      QUEUE_E_FALSE - the queue is not empty
+ */
+Queue_ReturnType Safety_Queue_SetKeyIndex(Safety_Queue_t *queue, keyFunc key_func,
+        uint16 *keyCnt, uint16 keyRange);
 
 #endif /* SAFETY_QUEUE_H_ */
 
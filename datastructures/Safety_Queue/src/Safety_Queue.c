@@ -23,10 +23,38 @@
  *  A circular buffer implementation of FIFO queue.*
  */
 
+/* CRC of the key index counters, 0 without a key index */
+static uint8 safety_queue_key_crc(Safety_Queue_t const *queue) {
+    uint8 crc = 0u;
+    if (queue->key_func != NULL_PTR) {
+        crc = Crc_CalculateCRC8((uint8 const *) queue->keyCnt, /*lint !e9087 MISRA:OTHER:counters are checked as bytes:[MISRA 2012 Rule 11.3, required]*/
+                queue->keyRange * sizeof(uint16), 0u, 1u);
+    }
+    return crc;
+}
+
+/* Count an added (TRUE) or removed element of the key index. The caller
+ * updates queueCrc afterwards. */
+static void safety_queue_key_update(Safety_Queue_t *queue, void const *dataPtr, boolean add) {
+    if (queue->key_func != NULL_PTR) {
+        uint16 key = queue->key_func(dataPtr);
+        if (key < queue->keyRange) {
+            if (add == TRUE) {
+                queue->keyCnt[key]++;
+            } else if (queue->keyCnt[key] > 0u) {
+                queue->keyCnt[key]--;
+            } else {
+                /* Not counted */
+            }
+            queue->keyCrc = safety_queue_key_crc(queue);
+        }
+    }
+}
+
 /* @req ARC_SWS_SafeQueue_00004*/
 /*lint -e{9016} MISRA:OTHER:correct arithmetic even if Array index is not used:[MISRA 2012 Rule 18.45, advisory]*/
 Queue_ReturnType Safety_Queue_Init(Safety_Queue_t *queue, void *buffer,
-        uint8 max_count, size_t dataSize, cmpFunc compare_func) {
+        uint16 max_count, size_t dataSize, cmpFunc compare_func) {
     SYS_CALL_SuspendOSInterrupts();
 
     if ((queue == NULL_PTR) || (buffer == NULL_PTR) || (compare_func == NULL_PTR)) {
@@ -50,6 +78,10 @@ Queue_ReturnType Safety_Queue_Init(Safety_Queue_t *queue, void *buffer,
     queue->count = 0u;
     queue->max_count = max_count;
     queue->compare_func = *compare_func;
+    queue->key_func = NULL_PTR;
+    queue->keyCnt = NULL_PTR;
+    queue->keyRange = 0u;
+    queue->keyCrc = 0u;
     queue->bufferCrc = Crc_CalculateCRC8(queue->bufStart,
             queue->dataSize * queue->max_count, 0u, 1u);
     queue->isInit = TRUE;
@@ -91,7 +123,8 @@ Queue_ReturnType Safety_Queue_Add(Safety_Queue_t *queue, void const *dataPtr) {
             0u, 0u);
     /* @req ARC_SWS_SafeQueue_00001*/
     if ((queue->bufferCrc != currBufferCrc)
-            || (queue->queueCrc != currQueueCrc)) {
+            || (queue->queueCrc != currQueueCrc)
+            || (queue->keyCrc != safety_queue_key_crc(queue))) {
         SYS_CALL_ResumeOSInterrupts();
         /* @req ARC_SWS_SafeQueue_00003*/
         /*lint -e904 MISRA:OTHER:Validation of parameters, if failure, function will return.This is not inline with Table 8, ISO26262-6-2011, Req 1a:[MISRA 2012 Rule 15.5, advisory]*/
@@ -109,6 +142,7 @@ Queue_ReturnType Safety_Queue_Add(Safety_Queue_t *queue, void const *dataPtr) {
         return QUEUE_E_FULL;
     }
     MEMCPY(queue->head, dataPtr, queue->dataSize);
+    safety_queue_key_update(queue, dataPtr, TRUE);
     /*lint -e{970} MISRA:OTHER:correct arithmetic even if Array index is not used:[MISRA 2012 Directive 4.6, advisory]*/
     queue->head = (char *) queue->head + queue->dataSize; /*lint !e9016 MISRA:OTHER:correct arithmetic even if Array index is not used:[MISRA 2012 Rule 18.4, advisory]*/
 
@@ -162,11 +196,13 @@ Queue_ReturnType Safety_Queue_Next(Safety_Queue_t *queue, void *dataPtr) {
     uint8 currQueueCrc = Crc_CalculateCRC8((void*) queue, without_buffer_size,
             0u, 0u);
     if ((queue->bufferCrc != currBufferCrc)
-            || (queue->queueCrc != currQueueCrc)) {
+            || (queue->queueCrc != currQueueCrc)
+            || (queue->keyCrc != safety_queue_key_crc(queue))) {
         SYS_CALL_ResumeOSInterrupts();
         return QUEUE_E_CRC_ERR;
     }
     MEMCPY((void*) dataPtr, queue->tail, queue->dataSize); /*lint !e9005 MISRA:PERFORMANCE:casting away const is okay:[MISRA 2012 Rule 11.8, required]*/
+    safety_queue_key_update(queue, dataPtr, FALSE);
     /*lint -e970 MISRA:OTHER:Need pointer arithmetic to determine size of struct - crc value:[MISRA 2012 Directive 4.6, advisory]*/
     /*lint -e{9016} MISRA:OTHER:correct arithmetic even if Array index is not used:[MISRA 2004 Info,advisory]*/
     queue->tail = (char *) queue->tail + queue->dataSize; /*lint !e960 MISRA:OTHER:correct arithmetic even if Array index is not used:[MISRA 2004 Info,advisory]*/
@@ -258,7 +294,8 @@ Queue_ReturnType Safety_Queue_Contains(Safety_Queue_t const *queue,
     uint8 currQueueCrc = Crc_CalculateCRC8((void*) queue, without_buffer_size,
             0u, 0u); /*lint !e9005 MISRA:PERFORMANCE:casting away const is okay:[MISRA 2012 Rule 11.8, required]*/
     if ((queue->bufferCrc != currBufferCrc)
-            || (queue->queueCrc != currQueueCrc)) {
+            || (queue->queueCrc != currQueueCrc)
+            || (queue->keyCrc != safety_queue_key_crc(queue))) {
         SYS_CALL_ResumeOSInterrupts();
         return QUEUE_E_CRC_ERR;
     }
@@ -267,6 +304,13 @@ Queue_ReturnType Safety_Queue_Contains(Safety_Queue_t const *queue,
         return QUEUE_E_NO_DATA;
     }
 
+    if (queue->key_func != NULL_PTR) {
+        uint16 key = queue->key_func(dataPtr);
+        boolean found = (key < queue->keyRange) && (queue->keyCnt[key] > 0u);
+        SYS_CALL_ResumeOSInterrupts();
+        return (found == TRUE) ? QUEUE_E_TRUE : QUEUE_E_FALSE;
+    }
+
     iter = queue->tail;
     //Loop through queue
     for (i = 0u; i < queue->count; i++) {
@@ -277,8 +321,53 @@ Queue_ReturnType Safety_Queue_Contains(Safety_Queue_t const *queue,
             return QUEUE_E_TRUE;
         }
         iter = iter + queue->dataSize; /*lint !e9016 MISRA:OTHER:correct arithmetic even if Array index is not used:[MISRA 2012 Rule 18.4, advisory]*/
+        if (iter == queue->bufEnd) {
+            iter = queue->bufStart;
+        }
 
     }
     SYS_CALL_ResumeOSInterrupts();
     return QUEUE_E_FALSE;
 }
+
+Queue_ReturnType Safety_Queue_SetKeyIndex(Safety_Queue_t *queue, keyFunc key_func,
+        uint16 *keyCnt, uint16 keyRange) {
+    SYS_CALL_SuspendOSInterrupts();
+
+    if ((queue == NULL_PTR) || (key_func == NULL_PTR) || (keyCnt == NULL_PTR)) {
+        SYS_CALL_ResumeOSInterrupts();
+        /*lint -e904 MISRA:OTHER:Validation of parameters, if failure, function will return.This is not inline with Table 8, ISO26262-6-2011, Req 1a:[MISRA 2012 Rule 15.5, advisory]*/
+        return QUEUE_E_NULL;
+    }
+
+    if (queue->isInit != TRUE) {
+        SYS_CALL_ResumeOSInterrupts();
+        return QUEUE_E_NO_INIT;
+    }
+
+    size_t without_buffer_size = (char*) &(queue->queueCrc) - (char*) queue; /*lint !e970 MISRA:OTHER:Pointer arithmetic:[MISRA 2012 Directive 4.6, advisory]*/
+    uint8 currQueueCrc = Crc_CalculateCRC8((void*) queue, without_buffer_size,
+            0u, 0u);
+    if ((queue->queueCrc != currQueueCrc)
+            || (queue->keyCrc != safety_queue_key_crc(queue))) {
+        SYS_CALL_ResumeOSInterrupts();
+        return QUEUE_E_CRC_ERR;
+    }
+    if (queue->count != 0u) {
+        SYS_CALL_ResumeOSInterrupts();
+        return QUEUE_E_FALSE;
+    }
+
+    for (uint16 i = 0u; i < keyRange; i++) {
+        keyCnt[i] = 0u;
+    }
+    queue->key_func = key_func;
+    queue->keyCnt = keyCnt;
+    queue->keyRange = keyRange;
+    queue->keyCrc = safety_queue_key_crc(queue);
+    queue->queueCrc = Crc_CalculateCRC8((void*) queue, without_buffer_size, 0u,
+            1u);
+
+    SYS_CALL_ResumeOSInterrupts();
+    return QUEUE_E_OK;
+}
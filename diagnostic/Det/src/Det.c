@@ -29,6 +29,10 @@
 #include "Dlt.h"
 #endif
 
+#if ( DET_USE_RAMLOG == STD_ON ) && defined(USE_RAMLOG)
+#include "Ramlog.h"
+#endif
+
 /* ----------------------------[Version check]------------------------------*/
 #if !(((DET_SW_MAJOR_VERSION == 2) && (DET_SW_MINOR_VERSION == 0)) )
 #error Det: Expected BSW module version to be 2.0.*
@@ -264,6 +268,10 @@ Std_ReturnType Det_ReportError(uint16 ModuleId, uint8 InstanceId, uint8 ApiId, u
 #endif
         }
         SchM_Exit_Det_EA_0();
+#if defined(USE_RAMLOG)
+        /* Lock-free, time stamped trace of all errors */
+        ramlog_det(ModuleId, InstanceId, ApiId, ErrorId);
+#endif
 #endif
 
 #if (DET_SAFETYMONITOR_API == STD_ON)
@@ -16,19 +16,40 @@
 #define RAMLOG_H_
 
 #include <stdint.h>
+#include <stddef.h>
 #include "device_serial.h"
 #include "xtoa.h"
 
+/* Record types, see common/ramlog.c */
+#define RAMLOG_REC_TEXT     0u
+#define RAMLOG_REC_DET      1u  /* uint16 moduleId, uint8 instanceId, apiId, errorId */
+#define RAMLOG_REC_USER     16u /* First free for the application */
+
 #if !defined(USE_RAMLOG)
 #define ramlog_str( _x)
 #define ramlog_dec( _x)
 #define ramlog_hex( _x)
+#define ramlog_write( _buf, _len)
+#define ramlog_bin( _type, _data, _len)
+#define ramlog_det( _mod, _inst, _api, _err)
 
 #else
 
 void ramlog_fputs( char *str );
 void ramlog_puts( char *str );
 void ramlog_chr( char c );
+void ramlog_write( const char *buf, size_t len );
+void ramlog_bin( uint8_t type, const void *data, uint32_t len );
+
+static inline void ramlog_det( uint16_t moduleId, uint8_t instanceId, uint8_t apiId, uint8_t errorId ) {
+  uint8_t rec[5];
+  rec[0] = (uint8_t)moduleId;
+  rec[1] = (uint8_t)(moduleId >> 8u);
+  rec[2] = instanceId;
+  rec[3] = apiId;
+  rec[4] = errorId;
+  ramlog_bin(RAMLOG_REC_DET, rec, sizeof(rec));
+}
 
 /*
  * Fast ramlog functions
@@ -0,0 +1,98 @@
+/*-------------------------------- Arctic Core ------------------------------
+ * Copyright (C) 2013, ArcCore AB, Sweden, www.arccore.com.
+ * Contact: <contact@arccore.com>
+ * 
+ * You may ONLY use this file:
+ * 1)if you have a valid commercial ArcCore license and then in accordance with  
+ * the terms contained in the written license agreement between you and ArcCore, 
+ * or alternatively
+ * 2)if you follow the terms found in GNU General Public License version 2 as 
+ * published by the Free Software Foundation and appearing in the file 
+ * LICENSE.GPL included in the packaging of this file or here 
+ * <http://www.gnu.org/licenses/old-licenses/gpl-2.0.txt>
+ *-------------------------------- Arctic Core -----------------------------*/
+
+#ifndef ARC_ATOMIC_H_
+#define ARC_ATOMIC_H_
+
+/*
+ * Atomic helpers for compilers without the GCC __atomic builtins, used by the
+ * lock-free code in common/ (arena.c, cirq_buffer.c). They disable interrupts,
+ * so they are only atomic on a single core.
+ */
+
+#include "Std_Types.h"
+#include "Cpu.h"
+
+#if !defined(__GNUC__)
+#include "Os.h"
+
+/* Irq_Save() does not exclude the other cores, and there is no portable
+ * memory barrier to order the plain loads and stores between them. */
+#if defined(OS_NUM_CORES) && (OS_NUM_CORES > 1)
+#error "arc_atomic.h: multicore builds need a compiler with the __atomic builtins"
+#endif
+
+/**
+ * Load with acquire semantics. Later accesses are not moved before it.
+ */
+static inline uint32 Arc_AtomicLoadAcq32( const uint32 *p ) {
+    imask_t flags;
+    uint32 rv;
+
+    Irq_Save(flags);
+    rv = *(const volatile uint32 *)p;
+    Irq_Restore(flags);
+    return rv;
+}
+
+/**
+ * Store with release semantics. Earlier accesses are not moved after it.
+ */
+static inline void Arc_AtomicStoreRel32( uint32 *p, uint32 v ) {
+    imask_t flags;
+
+    Irq_Save(flags);
+    *(volatile uint32 *)p = v;
+    Irq_Restore(flags);
+}
+
+/**
+ * Compare and swap.
+ *
+ * @param p     The variable
+ * @param old   Expected value, set to the current value on failure
+ * @param new   Stored when *p equals *old
+ * @return TRUE if new was stored
+ */
+static inline boolean Arc_AtomicCas32( uint32 *p, uint32 *old, uint32 new ) {
+    imask_t flags;
+    boolean rv;
+
+    Irq_Save(flags);
+    rv = (*p == *old);
+    if (rv) {
+        *p = new;
+    } else {
+        *old = *p;
+    }
+    Irq_Restore(flags);
+    return rv;
+}
+
+/**
+ * Add and return the new value.
+ */
+static inline uint32 Arc_AtomicAdd32( uint32 *p, uint32 v ) {
+    imask_t flags;
+    uint32 rv;
+
+    Irq_Save(flags);
+    *p += v;
+    rv = *p;
+    Irq_Restore(flags);
+    return rv;
+}
+#endif
+
+#endif /* ARC_ATOMIC_H_ */
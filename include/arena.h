@@ -0,0 +1,78 @@
+/*-------------------------------- Arctic Core ------------------------------
+ * Copyright (C) 2013, ArcCore AB, Sweden, www.arccore.com.
+ * Contact: <contact@arccore.com>
+ * 
+ * You may ONLY use this file:
+ * 1)if you have a valid commercial ArcCore license and then in accordance with  
+ * the terms contained in the written license agreement between you and ArcCore, 
+ * or alternatively
+ * 2)if you follow the terms found in GNU General Public License version 2 as 
+ * published by the Free Software Foundation and appearing in the file 
+ * LICENSE.GPL included in the packaging of this file or here 
+ * <http://www.gnu.org/licenses/old-licenses/gpl-2.0.txt>
+ *-------------------------------- Arctic Core -----------------------------*/
+
+#ifndef ARENA_H_
+#define ARENA_H_
+
+/*
+ * Static memory arena with fixed-size block pools, used instead of
+ * malloc()/free() by the BSW (CirqBuffDynCreate(), Arc_MBoxCreate(), ...).
+ *
+ * The pools are given by ARENA_POOLS(_P), one _P(blockSize, blockCnt) per
+ * pool in ascending block size. The block size must be a multiple of 8 and
+ * the block count less than 65535.
+ * Define CFG_ARENA_USER_CFG and an ARENA_POOLS in Arena_Cfg.h to replace
+ * the default pools.
+ */
+
+#include "Std_Types.h"
+
+#if defined(CFG_ARENA_USER_CFG)
+#include "Arena_Cfg.h"
+#endif
+
+#if !defined(ARENA_POOLS)
+#define ARENA_POOLS(_P) \
+    _P(16,   32)        \
+    _P(32,   32)        \
+    _P(64,   16)        \
+    _P(128,  16)        \
+    _P(256,  8)         \
+    _P(512,  8)         \
+    _P(1024, 4)
+#endif
+
+#define ARENA_POOL_CNT_ONE(_size, _cnt)     +1u
+#define ARENA_POOL_CNT                      (0u ARENA_POOLS(ARENA_POOL_CNT_ONE))
+
+typedef struct {
+    uint32 blockSize;
+    uint32 blockCnt;
+    uint32 used;        /* Blocks allocated now */
+    uint32 highWater;   /* Max blocks allocated at the same time */
+    uint32 failCnt;     /* Requests that found the pool empty */
+} Arena_PoolStatsType;
+
+/**
+ * Allocate a block from the smallest pool that fits size, or the next
+ * larger one if that pool is empty. O(1), lock-free.
+ *
+ * @param size
+ * @return The block, NULL if no pool could serve the request
+ */
+void *Arena_Alloc( uint32 size );
+
+/**
+ * Return a block allocated with Arena_Alloc(). NULL is ignored.
+ *
+ * @param ptr
+ */
+void Arena_Free( void *ptr );
+
+Std_ReturnType Arena_GetPoolStats( uint32 pool, Arena_PoolStatsType *stats );
+
+/* Number of Arena_Alloc() calls that returned NULL */
+uint32 Arena_GetFailCnt( void );
+
+#endif /* ARENA_H_ */
@@ -33,9 +33,11 @@ typedef struct {
     void *bufEnd;
 } CirqBufferType;
 
-/* Dynamic implementation */
+/* Dynamic implementation, memory from the arena (CFG_ARENA) */
+#if defined(CFG_ARENA)
 CirqBufferType *CirqBuffDynCreate( uint32 size, uint32 dataSize );
 int CirqBuffDynDestroy(CirqBufferType *cPtr );
+#endif
 
 /* Static implementation */
 CirqBufferType CirqBuffStatCreate(void *buffer, uint32 maxCnt, uint32 dataSize);
@@ -67,5 +69,70 @@ static inline void CirqBuff_PopRelease( CirqBufferType *cPtr) {
     --cPtr->currCnt;
 }
 
+/*
+ * Lock-free implementation
+ *
+ * CIRQBUFF_SPSC - One producer and one consumer, wait-free.
+ * CIRQBUFF_MPSC - Any number of producers, one consumer. Producers reserve
+ *                 a slot with compare-and-swap and publish it through a
+ *                 per-slot sequence number.
+ *
+ * head and tail are free running indexes, maxCnt must be a power of 2.
+ * Producer and consumer data are kept on separate cache lines.
+ */
+#if !defined(CIRQBUFF_CACHE_LINE)
+#define CIRQBUFF_CACHE_LINE     64u
+#endif
+
+typedef enum {
+    CIRQBUFF_SPSC,
+    CIRQBUFF_MPSC,
+} CirqBuffLfModeType;
+
+typedef struct {
+    /* Producer side */
+    uint32 head;
+    uint32 tailCache;       /* SPSC, last tail seen by the producer */
+    uint8 padProd[CIRQBUFF_CACHE_LINE - (2u * sizeof(uint32))];
+
+    /* Consumer side */
+    uint32 tail;
+    uint32 headCache;       /* SPSC, last head seen by the consumer */
+    uint8 padCons[CIRQBUFF_CACHE_LINE - (2u * sizeof(uint32))];
+
+    /* Constant after init */
+    uint8 *buf;
+    uint32 *seq;            /* MPSC, one per element */
+    uint32 mask;
+    uint32 dataSize;
+    CirqBuffLfModeType mode;
+} CirqBuffLfType;
+
+/**
+ * @param cPtr
+ * @param mode
+ * @param buffer    maxCnt elements of size dataSize
+ * @param seq       CIRQBUFF_MPSC: maxCnt uint32, CIRQBUFF_SPSC: NULL
+ * @param maxCnt    Power of 2
+ * @param dataSize
+ * @return 0 - ok, 1 - bad arguments
+ */
+int CirqBuffLf_Init( CirqBuffLfType *cPtr, CirqBuffLfModeType mode, void *buffer, uint32 *seq, uint32 maxCnt, uint32 dataSize );
+int CirqBuffLf_Push( CirqBuffLfType *cPtr, const void *dataPtr );
+int CirqBuffLf_Pop( CirqBuffLfType *cPtr, void *dataPtr );
+
+/* Approximate while producers or consumer are active */
+static inline uint32 CirqBuffLf_Size( const CirqBuffLfType *cPtr ) {
+    return cPtr->head - cPtr->tail;
+}
+
+static inline boolean CirqBuffLf_Empty( const CirqBuffLfType *cPtr ) {
+    return (CirqBuffLf_Size(cPtr) == 0u);
+}
+
+static inline boolean CirqBuffLf_Full( const CirqBuffLfType *cPtr ) {
+    return (CirqBuffLf_Size(cPtr) > cPtr->mask);
+}
+
 
 #endif /* CIRQ_BUFFER_H_ */
@@ -19,7 +19,7 @@
 
 typedef struct
 {
-    CirqBufferType *cirqPtr;
+    CirqBuffLfType *cirqPtr;
 } Arc_MBoxType;
 
 
@@ -21,8 +21,25 @@
  *     OsOS->OsHooks->OsPreTaskHook = TRUE
  *     OsOS->OsHooks->OsPostTaskHook = TRUE
  *     OsOS->OsHooks->OsStartupHook = TRUE
+ *
+ *   Function profiling (CFG_PERF_FUNC), sizes can be overridden from the build:
+ *     PERF_FUNCTION_CNT_MAX  - number of function indexes
+ *     PERF_NEST_DEPTH_MAX    - nested Perf_PreFunctionHook() calls per task
+ *     PERF_HIST_BUCKETS      - log2 histogram buckets, bucket n holds [2^(n-1), 2^n) ns
  */
 
+#if defined CFG_PERF_FUNC
+#if !defined(PERF_FUNCTION_CNT_MAX)
+#define PERF_FUNCTION_CNT_MAX   16u
+#endif
+#if !defined(PERF_NEST_DEPTH_MAX)
+#define PERF_NEST_DEPTH_MAX     8u
+#endif
+#if !defined(PERF_HIST_BUCKETS)
+#define PERF_HIST_BUCKETS       32u
+#endif
+#endif
+
 
 /**
  * Call cyclic to calculate load on the system
@@ -37,17 +54,23 @@ void Perf_Init( void );
 /**
  * Call whenever you want to install a name to an index.
  */
-void Perf_InstallFunctionName(uint8 PerfFuncIdx, char *PerfNamePtr, uint8 PerfNameLen);
+void Perf_InstallFunctionName(uint16 PerfFuncIdx, char *PerfNamePtr, uint8 PerfNameLen);
 
 /**
- * Call before the function
+ * Call before the function. Calls may be nested, the time spent in a nested
+ * function is not counted as active time of the calling function.
  */
-void Perf_PreFunctionHook(uint8 PerfFuncIdx);
+void Perf_PreFunctionHook(uint16 PerfFuncIdx);
 
 /**
  * Call after the function
  */
-void Perf_PostFunctionHook(uint8 PerfFuncIdx);
+void Perf_PostFunctionHook(uint16 PerfFuncIdx);
+
+/**
+ * Print the function and ISR statistics, including the histograms, as CSV
+ */
+void Perf_PrintCsv(void);
 
 /**
  * Readout of CPU load
@@ -58,6 +81,7 @@ uint8 Perf_ReadCpuLoad();
 #define Perf_InstallFunctionName
 #define Perf_PreFunctionHook
 #define Perf_PostFunctionHook
+#define Perf_PrintCsv()
 #endif
 
 
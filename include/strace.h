@@ -29,10 +29,78 @@
 #ifndef STRACE_H_
 #define STRACE_H_
 
+/*
+ * System trace. Events are written as fixed size binary records into one
+ * ring buffer per core. The oldest records are overwritten, the buffer holds
+ * the last STRACE_RING_SIZE events of each core.
+ *
+ * strace_dump() writes the rings to a file, scripts/strace_convert.py turns
+ * that into Chrome trace_event JSON (chrome://tracing, Perfetto) or CTF.
+ */
+
+#include <stdint.h>
+
+#if !defined(STRACE_RING_SIZE)
+#define STRACE_RING_SIZE    4096u   /* Records per core, power of 2 */
+#endif
+#if !defined(STRACE_CORE_MAX)
+#define STRACE_CORE_MAX     8u
+#endif
+#if !defined(STRACE_NAME_MAX)
+#define STRACE_NAME_MAX     64u     /* Named user scopes, e.g. main functions */
+#endif
+
+#define STRACE_ID_NONE      0xFFFFu
+
+typedef enum {
+    STRACE_EV_ISR_START = 0,
+    STRACE_EV_ISR_STOP,
+    STRACE_EV_TASK_START,
+    STRACE_EV_TASK_STOP,
+    STRACE_EV_TASK_ACTIVATE,
+    STRACE_EV_TASK_WAIT,        /* Task blocks in WaitEvent */
+    STRACE_EV_TASK_RELEASE,     /* Waiting task made ready */
+    STRACE_EV_TASK_RESUME,      /* Task continues after WaitEvent */
+    STRACE_EV_USER_START,       /* id from strace_register() */
+    STRACE_EV_USER_STOP,
+    STRACE_EV_EXCL_ENTER,       /* Outermost SuspendOSInterrupts() */
+    STRACE_EV_EXCL_EXIT,
+} strace_ev_t;
+
+/* One event, 16 bytes. Stored in host byte order. */
+typedef struct {
+    uint64_t timestamp; /* ns on linux, timer ticks (32 bits) otherwise */
+    uint16_t valid;     /* 1 when the record is complete */
+    uint8_t  event;     /* strace_ev_t */
+    uint8_t  core;
+    uint16_t id;        /* Task, ISR or user scope id */
+    uint16_t ctx;       /* Task the event was recorded in, if known */
+} strace_rec_t;
+
+void strace( strace_ev_t event, uint16_t id );
+void strace_init( void );
+/* Get an id for a user scope. The name must be a string constant. */
+uint16_t strace_register( const char *name );
+/* Write all rings, see scripts/strace_convert.py for the format. Returns 0 on success. */
+int strace_dump( const char *filename );
+void strace_print( void );
+
 #ifdef USE_STRACE
-#define STRACE(_x)	strace((_x))
+#define STRACE(_ev,_id)	strace((_ev),(_id))
+/* Trace the execution of _code as a named user scope */
+#define STRACE_SCOPE(_name,_code) \
+    do { \
+        static uint16_t strace_scope_id_ = STRACE_ID_NONE; \
+        if (strace_scope_id_ == STRACE_ID_NONE) { \
+            strace_scope_id_ = strace_register(_name); \
+        } \
+        strace(STRACE_EV_USER_START, strace_scope_id_); \
+        _code; \
+        strace(STRACE_EV_USER_STOP, strace_scope_id_); \
+    } while(0)
 #else
-#define STRACE(_x)
+#define STRACE(_ev,_id)
+#define STRACE_SCOPE(_name,_code)   _code
 #endif
 
 #endif /* STRACE_H_ */
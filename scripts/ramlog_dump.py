@@ -0,0 +1,120 @@
+"""
+
+Description
+    Prints a ramlog (common/ramlog.c) from a memory dump of the ramlog
+    variable, e.g. saved with Data.SAVE.Binary in tools/t32/ramlog.cmm.
+
+    Records are printed in time order. Records that were still being
+    written or have been overwritten when the dump was taken are skipped
+    and counted.
+
+Usage:
+    python scripts/ramlog_dump.py ramlog.bin
+    python scripts/ramlog_dump.py ramlog.bin -r      (one line per record)
+"""
+
+import optparse
+import struct
+import sys
+
+MAGIC = 0x474F4C52  # "RLOG"
+VERSION = 2
+
+REC_TEXT = 0
+REC_DET = 1
+REC_USER = 16
+
+
+class Record(object):
+    def __init__(self, pos, time, type, core, data):
+        self.pos = pos
+        self.time = time
+        self.type = type
+        self.core = core
+        self.data = data
+
+
+def read_ramlog(filename):
+    data = open(filename, 'rb').read()
+    bo = '<'
+    if struct.unpack_from('<I', data, 0)[0] != MAGIC:
+        bo = '>'
+        if struct.unpack_from('>I', data, 0)[0] != MAGIC:
+            raise ValueError('%s is not a ramlog dump' % filename)
+
+    (magic, version, slot_size, slot_cnt, freq, session, head) = struct.unpack_from(bo + 'IHHIIII', data, 0)
+    if version != VERSION or slot_size != 32:
+        raise ValueError('Unsupported ramlog version %d, slot size %d' % (version, slot_size))
+
+    slot = struct.Struct(bo + 'IIBBBB20s')
+    first = max(0, head - slot_cnt)
+    records = []
+    bad = 0
+    pos = first
+    while pos < head:
+        seq, time, type, core, length, cont = slot.unpack_from(data, 32 + (pos % slot_cnt) * slot_size)[:6]
+        # A record is valid when all its slots are
+        payload = b''
+        ok = True
+        for i in range(cont + 1):
+            p = pos + i
+            if p >= head:
+                ok = False
+                break
+            s = slot.unpack_from(data, 32 + (p % slot_cnt) * slot_size)
+            if s[0] != ((p + 1) & 0xFFFFFFFF) or s[5] != cont - i:
+                ok = False
+                break
+            payload += s[6][:s[4]]
+        if ok and seq == ((pos + 1) & 0xFFFFFFFF):
+            records.append(Record(pos, time, type, core, payload))
+            pos += cont + 1
+        else:
+            bad += 1
+            pos += 1
+
+    # Unwrap the 32 bit time stamps, the records are in reservation order
+    wrap, last = 0, None
+    for r in records:
+        if last is not None and r.time < last and (last - r.time) > 0x80000000:
+            wrap += 1 << 32
+        last = r.time
+        r.time += wrap
+    records.sort(key=lambda r: (r.time, r.pos))
+    return freq, session, records, bad
+
+
+def describe(r):
+    if r.type == REC_TEXT:
+        return r.data.decode('ascii', 'replace')
+    if r.type == REC_DET and len(r.data) >= 5:
+        module, instance, api, error = struct.unpack_from('<HBBB', r.data, 0)
+        return 'DET module=%d instance=%d api=0x%02x error=0x%02x' % (module, instance, api, error)
+    return 'type=%d %s' % (r.type, ' '.join('%02x' % b for b in bytearray(r.data)))
+
+
+def main():
+    parser = optparse.OptionParser(usage='%prog [options] <ramlog dump>')
+    parser.add_option('-r', '--records', dest='records', action='store_true', default=False,
+                      help='Print one line per record with time stamp and core')
+    (options, args) = parser.parse_args()
+    if len(args) != 1:
+        parser.error('No ramlog dump given')
+
+    freq, session, records, bad = read_ramlog(args[0])
+    out = sys.stdout
+    if options.records:
+        for r in records:
+            out.write('%12.6f %d %s\n' % (float(r.time) / freq, r.core, describe(r).rstrip('\n')))
+    else:
+        for r in records:
+            if r.type == REC_TEXT:
+                out.write(describe(r))
+            else:
+                out.write('<%s>\n' % describe(r))
+    if bad:
+        sys.stderr.write('session %d: %d torn or overwritten slots skipped\n' % (session, bad))
+
+
+if __name__ == '__main__':
+    main()
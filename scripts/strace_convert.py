@@ -0,0 +1,263 @@
+"""
+
+Description
+    Converts a system trace written by strace_dump() (common/strace.c) into
+      - Chrome trace_event JSON, open in chrome://tracing or ui.perfetto.dev
+      - Common Trace Format (CTF 1.8), open in Trace Compass or babeltrace
+
+    Tasks, ISRs, main functions (SCHM_MAINFUNCTION) and exclusive areas
+    (outermost SuspendOSInterrupts) become duration slices, activations are
+    instant events.
+
+    On LinuxOs every task is a thread, the records hold the task they were
+    recorded in and the timeline has one row per task. Otherwise there is one
+    row per core and preemption shows as nested slices.
+
+Usage:
+    python scripts/strace_convert.py /tmp/myecu.strace -o trace.json
+    python scripts/strace_convert.py /tmp/myecu.strace -f ctf -o trace_ctf
+"""
+
+import json
+import optparse
+import os
+import struct
+import sys
+
+MAGIC = 0x43525453  # "STRC"
+ID_NONE = 0xFFFF
+
+EVENTS = [
+    'isr_start', 'isr_stop',
+    'task_start', 'task_stop',
+    'task_activate', 'task_wait', 'task_release', 'task_resume',
+    'user_start', 'user_stop',
+    'excl_enter', 'excl_exit',
+]
+
+NAME_TASK, NAME_ISR, NAME_USER = 0, 1, 2
+
+
+class Trace(object):
+    def __init__(self):
+        self.hz = 1000000000
+        self.per_thread = False
+        self.names = {NAME_TASK: {}, NAME_ISR: {}, NAME_USER: {}}
+        self.records = []   # (timestamp, core, event, id, ctx)
+
+    def name(self, kind, id):
+        default = {NAME_TASK: 'task%d', NAME_ISR: 'isr%d', NAME_USER: 'user%d'}[kind]
+        return self.names[kind].get(id, default % id)
+
+    def task_name(self, id):
+        if id == ID_NONE:
+            return 'main'
+        return self.name(NAME_TASK, id)
+
+
+def read_trace(filename):
+    data = open(filename, 'rb').read()
+    bo = '<'
+    if struct.unpack_from('<I', data, 0)[0] != MAGIC:
+        bo = '>'
+        if struct.unpack_from('>I', data, 0)[0] != MAGIC:
+            raise ValueError('%s is not a strace dump' % filename)
+
+    t = Trace()
+    (magic, version, rec_size, ring_size, core_cnt, hz, ts_bits, per_thread,
+     name_cnt) = struct.unpack_from(bo + 'IHHIIIBBH', data, 0)
+    if version != 1 or rec_size != 16:
+        raise ValueError('Unsupported strace version %d, record size %d' % (version, rec_size))
+    t.hz = hz
+    t.per_thread = (per_thread != 0)
+    off = 24
+
+    for _ in range(name_cnt):
+        kind, id, length = struct.unpack_from(bo + 'BHB', data, off)
+        off += 4
+        t.names[kind][id] = data[off:off + length].decode('ascii', 'replace')
+        off += length
+
+    rec = struct.Struct(bo + 'QHBBHH')
+    for core in range(core_cnt):
+        head = struct.unpack_from(bo + 'I', data, off)[0]
+        off += 4
+        first = max(0, head - ring_size)
+        last_ts, wrap = 0, 0
+        for pos in range(first, head):
+            ts, valid, event, rcore, id, ctx = rec.unpack_from(data, off + (pos % ring_size) * rec_size)
+            if not valid:
+                continue
+            if ts_bits == 32:
+                if ts < last_ts:
+                    wrap += 1 << 32
+                last_ts = ts
+                ts += wrap
+            t.records.append((ts, rcore, event, id, ctx))
+        off += ring_size * rec_size
+
+    t.records.sort()
+    return t
+
+
+def slice_of(t, event, id):
+    """(begin, category, name) of duration events, None for instant events"""
+    if event in (0, 1):
+        return (event == 0, 'isr', t.name(NAME_ISR, id))
+    if event in (2, 3, 7, 5):
+        return (event in (2, 7), 'task', t.task_name(id))
+    if event in (8, 9):
+        return (event == 8, 'mainfunction', t.name(NAME_USER, id))
+    if event in (10, 11):
+        return (event == 10, 'exclusive', 'exclusive area')
+    return None
+
+
+def to_chrome(t, out):
+    events = []
+    stacks = {}
+    rows = set()
+    t0 = t.records[0][0] if t.records else 0
+    scale = 1000000.0 / t.hz
+
+    for ts, core, event, id, ctx in t.records:
+        us = (ts - t0) * scale
+        if t.per_thread:
+            # Task events are recorded by the task itself, except activations.
+            row = id if event in (2, 3, 5, 7) else ctx
+        else:
+            row = core
+        pid = 0 if t.per_thread else core
+        rows.add((pid, row))
+        s = slice_of(t, event, id)
+        if s is None:
+            events.append({'ph': 'i', 's': 't', 'ts': us, 'pid': pid, 'tid': row,
+                           'name': '%s %s' % (EVENTS[event], t.task_name(id)), 'cat': 'task'})
+            continue
+        begin, cat, name = s
+        stack = stacks.setdefault((pid, row), [])
+        if begin:
+            stack.append(name)
+            events.append({'ph': 'B', 'ts': us, 'pid': pid, 'tid': row, 'name': name, 'cat': cat})
+        elif name in stack:
+            # Close everything opened after it, e.g. a task ended inside an exclusive area
+            while stack:
+                top = stack.pop()
+                events.append({'ph': 'E', 'ts': us, 'pid': pid, 'tid': row, 'name': top})
+                if top == name:
+                    break
+
+    end = (t.records[-1][0] - t0) * scale if t.records else 0
+    for (pid, row), stack in stacks.items():
+        while stack:
+            events.append({'ph': 'E', 'ts': end, 'pid': pid, 'tid': row, 'name': stack.pop()})
+
+    for pid, row in sorted(rows):
+        if t.per_thread:
+            label = t.task_name(row)
+        else:
+            label = 'core %d' % row
+        events.append({'ph': 'M', 'pid': pid, 'tid': row, 'name': 'thread_name', 'args': {'name': label}})
+
+    json.dump({'traceEvents': events, 'displayTimeUnit': 'ns'}, out)
+
+
+CTF_METADATA = """/* CTF 1.8 */
+
+typealias integer { size = 8; align = 8; signed = false; } := uint8_t;
+typealias integer { size = 16; align = 8; signed = false; } := uint16_t;
+typealias integer { size = 32; align = 8; signed = false; } := uint32_t;
+
+trace {
+    major = 1;
+    minor = 8;
+    byte_order = le;
+    packet.header := struct {
+        uint32_t magic;
+        uint32_t stream_id;
+    };
+};
+
+clock {
+    name = "monotonic";
+    freq = %(hz)d;
+};
+
+typealias integer { size = 64; align = 8; signed = false; map = clock.monotonic.value; } := uint64_clock_t;
+
+stream {
+    id = 0;
+    packet.context := struct {
+        uint32_t cpu_id;
+    };
+    event.header := struct {
+        uint8_t id;
+        uint64_clock_t timestamp;
+    };
+};
+"""
+
+CTF_EVENT = """
+event {
+    name = "%(name)s";
+    id = %(id)d;
+    stream_id = 0;
+    fields := struct {
+        uint16_t id;
+        uint16_t ctx;
+        string name;
+    };
+};
+"""
+
+
+def to_ctf(t, outdir):
+    if not os.path.isdir(outdir):
+        os.makedirs(outdir)
+    with open(os.path.join(outdir, 'metadata'), 'w') as f:
+        f.write(CTF_METADATA % {'hz': t.hz})
+        for i, name in enumerate(EVENTS):
+            f.write(CTF_EVENT % {'name': name, 'id': i})
+
+    streams = {}
+    for ts, core, event, id, ctx in t.records:
+        f = streams.get(core)
+        if f is None:
+            f = open(os.path.join(outdir, 'stream_%d' % core), 'wb')
+            f.write(struct.pack('<III', 0xC1FC1FC1, 0, core))
+            streams[core] = f
+        s = slice_of(t, event, id)
+        name = s[2] if s is not None else t.task_name(id)
+        f.write(struct.pack('<BQHH', event, ts, id, ctx))
+        f.write(name.encode('ascii', 'replace') + b'\0')
+    for f in streams.values():
+        f.close()
+
+
+def main():
+    parser = optparse.OptionParser(usage='%prog [options] <strace dump>')
+    parser.add_option('-f', '--format', dest='format', default='chrome',
+                      help='chrome (default) or ctf')
+    parser.add_option('-o', '--output', dest='output',
+                      help='Output file (chrome, default stdout) or directory (ctf)')
+    (options, args) = parser.parse_args()
+    if len(args) != 1:
+        parser.error('No strace dump given')
+
+    t = read_trace(args[0])
+    if options.format == 'chrome':
+        if options.output:
+            with open(options.output, 'w') as out:
+                to_chrome(t, out)
+        else:
+            to_chrome(t, sys.stdout)
+    elif options.format == 'ctf':
+        if not options.output:
+            parser.error('ctf needs an output directory (-o)')
+        to_ctf(t, options.output)
+    else:
+        parser.error('Unknown format %s' % options.format)
+
+
+if __name__ == '__main__':
+    main()
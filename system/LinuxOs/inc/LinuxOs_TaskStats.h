@@ -0,0 +1,56 @@
+/*-------------------------------- Arctic Core ------------------------------
+ * Copyright (C) 2013, ArcCore AB, Sweden, www.arccore.com.
+ * Contact: <contact@arccore.com>
+ *
+ * You may ONLY use this file:
+ * 1)if you have a valid commercial ArcCore license and then in accordance with
+ * the terms contained in the written license agreement between you and ArcCore,
+ * or alternatively
+ * 2)if you follow the terms found in GNU General Public License version 2 as
+ * published by the Free Software Foundation and appearing in the file
+ * LICENSE.GPL included in the packaging of this file or here
+ * <http://www.gnu.org/licenses/old-licenses/gpl-2.0.txt>
+ *-------------------------------- Arctic Core -----------------------------*/
+
+
+#ifndef LINUXOS_TASKSTATS_H_
+#define LINUXOS_TASKSTATS_H_
+
+#include "Std_Types.h"
+
+/* Number of histogram buckets. Bucket 0 counts times below 1 us, bucket n
+ * counts times in [2^(n-1), 2^n) us and the last bucket everything above,
+ * i.e. 16 buckets cover up to 16 ms. */
+#define LINOS_HIST_BUCKETS  16u
+
+typedef struct {
+    uint32 bucket[LINOS_HIST_BUCKETS];
+    uint32 max_ns;
+    uint64 sum_ns;
+} Linos_HistType;
+
+/* Per activation timing of a LinuxOs task thread.
+ *
+ * release  - CLOCK_MONOTONIC time of the ActivateTask() that released the task
+ * start    - CLOCK_MONOTONIC time the thread entered the task entry
+ * end      - CLOCK_MONOTONIC time the task entry returned (TerminateTask)
+ *
+ * Tasks that never return from the entry (extended tasks looping on WaitEvent)
+ * only get the first activation accounted for. */
+typedef struct {
+    uint32 activateCnt;     /* Activations that reached the task entry */
+    uint32 completeCnt;     /* Activations that returned from the task entry */
+    uint32 deadlineMissCnt; /* ActivateTask() while the previous activation was still running */
+    Linos_HistType response; /* end - release */
+    Linos_HistType jitter;   /* |(start - release) - previous (start - release)| */
+    Linos_HistType exec;     /* Thread CPU time (CLOCK_THREAD_CPUTIME_ID) between start and end */
+} Linos_TaskStatsType;
+
+/* Copy the statistics of a task. Not locked, counters may be one activation apart. */
+void Linos_GetTaskStats(uint32 taskId, Linos_TaskStatsType *stats);
+
+/* Upper bound in us of the bucket that holds the given per mille of the samples,
+ * 0xFFFFFFFF if it is in the last (open) bucket. */
+uint32 Linos_HistPercentile_us(const Linos_HistType *hist, uint32 permille);
+
+#endif /* LINUXOS_TASKSTATS_H_ */
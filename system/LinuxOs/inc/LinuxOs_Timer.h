@@ -0,0 +1,41 @@
+/*-------------------------------- Arctic Core ------------------------------
+ * Copyright (C) 2013, ArcCore AB, Sweden, www.arccore.com.
+ * Contact: <contact@arccore.com>
+ *
+ * You may ONLY use this file:
+ * 1)if you have a valid commercial ArcCore license and then in accordance with
+ * the terms contained in the written license agreement between you and ArcCore,
+ * or alternatively
+ * 2)if you follow the terms found in GNU General Public License version 2 as
+ * published by the Free Software Foundation and appearing in the file
+ * LICENSE.GPL included in the packaging of this file or here
+ * <http://www.gnu.org/licenses/old-licenses/gpl-2.0.txt>
+ *-------------------------------- Arctic Core -----------------------------*/
+
+
+#ifndef LINUXOS_TIMER_H_
+#define LINUXOS_TIMER_H_
+
+#include "Std_Types.h"
+
+/* Statistics of the gnulinux_timer OS tick source.
+ *
+ * Ticks are generated against absolute CLOCK_MONOTONIC deadlines, so the
+ * lateness below never accumulates, it only tells how late a single tick
+ * was released compared to its deadline. */
+typedef struct {
+    uint32 tickPeriod_ns;   /* 1000000000 / OsTickFreq */
+    uint64 tickCnt;         /* Number of IncrementCounter(0) calls */
+    uint32 overrunCnt;      /* Wake-ups where more than one tick was due.
+                             * Virtual time: ticks given before the tasks were idle */
+    uint32 missedTickCnt;   /* Ticks released late, caught up by an overrun */
+    uint32 droppedTickCnt;  /* Ticks skipped when re-synchronising after a long stall */
+    uint32 lateLast_ns;     /* Wake-up lateness of the last tick */
+    uint32 lateMax_ns;      /* Worst wake-up lateness */
+    uint64 lateSum_ns;      /* Sum of lateness of all wake-ups (tickCnt - missedTickCnt) */
+} Linos_TimerStatsType;
+
+/* Copy the current OS tick statistics. */
+void Linos_GetTimerStats(Linos_TimerStatsType *stats);
+
+#endif /* LINUXOS_TIMER_H_ */
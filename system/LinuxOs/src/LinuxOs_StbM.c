@@ -171,10 +171,10 @@ Std_ReturnType Linos_StbM_BusSetGlobalTime(StbM_SynchronizedTimeBaseType timeBas
     logger(LOG_DEBUG, "Linos_StbM_BusSetGlobalTime got ptp (in-sync, offset):"
             " (%d, %f)", ptp_in_sync, ptp_offset);
 
-    /* For update timeout measurement, get the time from the monotonic clock. */
+    /* For update timeout measurement, get the time from the (virtual) monotonic clock. */
     /* We do this outside the mutex locking block below. */
     struct timespec current_time;
-    clock_gettime(CLOCK_MONOTONIC, &current_time);
+    Linos_GetMonotonicTime(&current_time);
 
     pthread_mutex_lock(&mutex_linos_StbM_Status);
 
@@ -267,10 +267,10 @@ Std_ReturnType Linos_StbM_GetCurrentTime(StbM_SynchronizedTimeBaseType timeBaseI
         return E_NOT_OK ;
     }
 
-    /* For update timeout measurement, get the time from the monotonic clock. */
+    /* For update timeout measurement, get the time from the (virtual) monotonic clock. */
     /* We do this outside the mutex locking block below. */
     struct timespec current_time;
-    clock_gettime(CLOCK_MONOTONIC, &current_time);
+    Linos_GetMonotonicTime(&current_time);
 
     /* @req 4.2.2/SWS_StbM_00195 */
     pthread_mutex_lock(&mutex_linos_StbM_Status);
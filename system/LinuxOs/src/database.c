@@ -14,11 +14,317 @@
 
 #include <stdio.h>
 #include <string.h>
+#ifndef _WIN32
+#include <pthread.h>
+#include <time.h>
+#endif
 #include "database.h"
 #include "linos_logger.h" // Logger function
 
 #ifndef _WIN32
 sqlite3 *db = 0;
+
+enum db_op {
+    DB_OP_SET,
+    DB_OP_INC,
+    DB_OP_TOUCH
+};
+
+enum db_stmt {
+    DB_STMT_GET,
+    DB_STMT_SET,
+    DB_STMT_UPDATE,
+    DB_STMT_UPDATE_NO_FORCE,
+    DB_STMT_INC,
+    DB_STMT_INC_NO_FORCE,
+    DB_STMT_TOUCH,
+    DB_STMT_TOUCH_NO_FORCE,
+    DB_STMT_BEGIN,
+    DB_STMT_COMMIT,
+    DB_STMT_ROLLBACK,
+    DB_STMT_CNT
+};
+
+// A register write not yet in the database. A later write to the same
+// register with the same flags is merged into it, see db_can_merge().
+typedef struct {
+    int address;
+    int op;
+    int value;
+    int create_missing;
+    int force_write;
+    int writeable;
+} db_pending_t;
+
+// A register as db_get_register() reports it, the database row with the
+// pending writes applied
+typedef struct {
+    int address;
+    int value;
+    int writeable;
+    int exists;
+} db_row_t;
+
+static sqlite3_stmt *db_stmt[DB_STMT_CNT];
+// Serialises all use of db and db_stmt
+static pthread_mutex_t db_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// Pending writes. Double buffered so callers can queue while a batch is written.
+static db_pending_t db_pending_buf[2][DB_PENDING_MAX];
+static db_pending_t *db_pending = db_pending_buf[0];
+static int db_pending_cnt = 0;
+static pthread_mutex_t db_pending_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t db_pending_cond;
+
+static pthread_t db_writer_thread;
+static int db_writer_running = 0;
+// Error of the last failed background write, returned by the next db_set/inc/touch_register
+static int db_writer_error = DB_OK;
+
+// Statistics
+static unsigned long db_req_cnt = 0;
+static unsigned long db_merged_cnt = 0;
+static unsigned long db_full_cnt = 0;
+static unsigned long db_flush_cnt = 0;
+static unsigned long db_flush_rows = 0;
+static unsigned long db_fail_cnt = 0;
+
+// Pending writes in the range of a db_get_register(), db_lock must be held
+static db_pending_t db_read_pending[DB_PENDING_MAX];
+
+
+static int db_prepare ( int idx, const char *sql, const char *sql_end )
+{
+    char sql_cmd[512];
+
+    snprintf(sql_cmd, sizeof(sql_cmd), "%s%s", sql, sql_end);
+    if ( sqlite3_prepare_v2(db, sql_cmd, -1, &db_stmt[idx], NULL) != SQLITE_OK )
+    {
+        logger(LOG_ERR, "ERROR: DB PREPARE Sqlite3: %s\n", sqlite3_errmsg(db));
+        logger(LOG_ERR, "\n SQL was: %s\n", sql_cmd);
+        return DB_FAIL_CREATE;
+    }
+    return DB_OK;
+}
+
+
+static void db_finalize ( void )
+{
+    int i;
+
+    for ( i = 0; i < DB_STMT_CNT; i++ )
+    {
+        sqlite3_finalize(db_stmt[i]);
+        db_stmt[i] = NULL;
+    }
+}
+
+
+/**
+ * Write one register to the database, db_lock must be held.
+ */
+static int db_write ( const db_pending_t *p )
+{
+    sqlite3_stmt *stmt;
+    int rc;
+
+    switch ( p->op )
+    {
+    case DB_OP_SET:
+        stmt = db_stmt[(p->force_write == 1) ? DB_STMT_UPDATE : DB_STMT_UPDATE_NO_FORCE];
+        break;
+    case DB_OP_INC:
+        stmt = db_stmt[(p->force_write == 1) ? DB_STMT_INC : DB_STMT_INC_NO_FORCE];
+        break;
+    default:
+        stmt = db_stmt[(p->force_write == 1) ? DB_STMT_TOUCH : DB_STMT_TOUCH_NO_FORCE];
+        break;
+    }
+
+    sqlite3_bind_int(stmt, 1, p->value);
+    sqlite3_bind_int(stmt, 2, p->address);
+    rc = sqlite3_step(stmt);
+    sqlite3_reset(stmt);
+
+    if ( rc != SQLITE_DONE )
+    {
+        logger(LOG_ERR, "ERROR: DB WRITE REGISTER %d Sqlite3 error[%d]: %s\n", p->address, rc, sqlite3_errmsg(db));
+        return DB_FAIL_INSERT;
+    }
+
+    // Check that there was a row changed
+    // otherwise  try SET (REPLACE)
+    if ( (sqlite3_changes(db) != 1) && (p->create_missing == 1) )
+    {
+        stmt = db_stmt[DB_STMT_SET];
+        sqlite3_bind_int(stmt, 1, (p->op == DB_OP_TOUCH) ? 0 : p->value);
+        sqlite3_bind_int(stmt, 2, p->address);
+        sqlite3_bind_int(stmt, 3, p->writeable);
+        rc = sqlite3_step(stmt);
+        sqlite3_reset(stmt);
+        if ( rc != SQLITE_DONE )
+        {
+            // SET failed
+            logger(LOG_ERR, "ERROR: DB WRITE REGISTER %d Sqlite3 error[%d]: %s\n", p->address, rc, sqlite3_errmsg(db));
+            return DB_FAIL_INSERT;
+        }
+    }
+    return DB_OK;
+}
+
+
+/**
+ * A write can be merged into the last pending write of the register if both
+ * have the same flags, and the result is the same as writing them one by one.
+ * A write that is not forced to a register that is not writeable replaces the
+ * row when create_missing is set. A set gives the same row either way, an
+ * increment or touch after an earlier write could replace it with their own
+ * value, so they are queued on their own.
+ */
+static int db_can_merge ( const db_pending_t *p, int op, int create_missing, int force_write, int writeable )
+{
+    if ( (p->create_missing != create_missing) || (p->force_write != force_write) ||
+         (p->writeable != writeable) )
+    {
+        return 0;
+    }
+    return (op == DB_OP_SET) || (force_write == 1) || (writeable == 1) || (create_missing != 1);
+}
+
+
+/**
+ * Queue a register write. Merged with a pending write to the same register.
+ * Returns the error of a failed background write since the last call, or of
+ * the batch this call had to write itself.
+ */
+static int db_queue ( int register_address, int op, int value, int create_missing, int force_write, int writeable )
+{
+    db_pending_t *p;
+    int i;
+    int queued = 0;
+    int rv = DB_OK;
+    int flush_rv;
+
+    if (!db)
+        return DB_FAIL_EXISTS;
+
+    while ( !queued )
+    {
+        p = NULL;
+        pthread_mutex_lock(&db_pending_lock);
+        // Only the last pending write of the register, the writes are done in order
+        for ( i = db_pending_cnt - 1; i >= 0; i-- )
+        {
+            if ( db_pending[i].address == register_address )
+            {
+                if ( db_can_merge(&db_pending[i], op, create_missing, force_write, writeable) )
+                {
+                    p = &db_pending[i];
+                }
+                break;
+            }
+        }
+
+        if ( p != NULL )
+        {
+            db_merged_cnt++;
+            if ( op == DB_OP_SET )
+            {
+                p->op = DB_OP_SET;
+                p->value = value;
+            }
+            else if ( op == DB_OP_INC )
+            {
+                if ( p->op == DB_OP_TOUCH )
+                {
+                    p->op = DB_OP_INC;
+                    p->value = 0;
+                }
+                // An increment of a pending set, sets the sum
+                p->value += value;
+            }
+            // A set or increment also updates the timestamp, so a touch adds nothing
+            queued = 1;
+        }
+        else if ( db_pending_cnt < DB_PENDING_MAX )
+        {
+            p = &db_pending[db_pending_cnt++];
+            p->address = register_address;
+            p->op = op;
+            p->value = value;
+            p->create_missing = create_missing;
+            p->force_write = force_write;
+            p->writeable = writeable;
+            queued = 1;
+            if ( db_pending_cnt == DB_PENDING_WAKE )
+            {
+                pthread_cond_signal(&db_pending_cond);
+            }
+        }
+        else
+        {
+            db_full_cnt++;
+        }
+
+        if ( queued )
+        {
+            db_req_cnt++;
+            if ( db_writer_error != DB_OK )
+            {
+                rv = db_writer_error;
+                db_writer_error = DB_OK;
+            }
+        }
+        pthread_mutex_unlock(&db_pending_lock);
+
+        if ( !queued )
+        {
+            // No room, write the pending batch from this thread
+            flush_rv = db_flush();
+            if ( flush_rv != DB_OK )
+            {
+                rv = flush_rv;
+            }
+        }
+    }
+
+    return rv;
+}
+
+
+static void *db_writer ( void *arg )
+{
+    struct timespec ts;
+    int rv;
+
+    (void)arg;
+
+    pthread_mutex_lock(&db_pending_lock);
+    while ( db_writer_running )
+    {
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        ts.tv_nsec += DB_FLUSH_PERIOD_MS * 1000000L;
+        while ( ts.tv_nsec >= 1000000000L )
+        {
+            ts.tv_nsec -= 1000000000L;
+            ts.tv_sec++;
+        }
+        (void)pthread_cond_timedwait(&db_pending_cond, &db_pending_lock, &ts);
+        pthread_mutex_unlock(&db_pending_lock);
+
+        rv = db_flush();
+
+        pthread_mutex_lock(&db_pending_lock);
+        if ( rv != DB_OK )
+        {
+            // Nobody waits for this write, hand the error to the next caller
+            db_writer_error = rv;
+        }
+    }
+    pthread_mutex_unlock(&db_pending_lock);
+
+    return NULL;
+}
 #endif
 
 int db_init ( char *filename )
@@ -28,6 +334,7 @@ int db_init ( char *filename )
     char sql_cmd_index[] = DB_CREATE_INDEX;
     char sql_cmd_trigger[] = DB_CREATE_TRIGGER;
     char sql_cmd_check[] = DB_CHECK;
+    pthread_condattr_t cond_attr;
 
 
     char *reply = 0;
@@ -46,6 +353,14 @@ int db_init ( char *filename )
     sqlite3_busy_timeout(db, DB_BUSY_TIMEOUT); // mS
     //
 
+    // WAL, so a commit does not need an fsync of the main database
+    if ( sqlite3_exec ( db, DB_JOURNAL_MODE, 0, 0, &reply ) != SQLITE_OK )
+    {
+        logger(LOG_WARNING, "WARNING: DB journal mode Sqlite3: %s\n", reply);
+        sqlite3_free(reply);
+        reply = 0;
+    }
+
     // If modbus table missing, then create it.
     if ( sqlite3_exec ( db, sql_cmd_check, 0, 0, &reply ) != SQLITE_OK )
     {
@@ -81,6 +396,41 @@ int db_init ( char *filename )
         }
 
     }
+
+    if ( (db_prepare(DB_STMT_GET, DB_GET_REGISTER_STMT, "") != DB_OK) ||
+         (db_prepare(DB_STMT_SET, DB_SET_REGISTER_STMT, "") != DB_OK) ||
+         (db_prepare(DB_STMT_UPDATE, DB_UPDATE_REGISTER_STMT, "") != DB_OK) ||
+         (db_prepare(DB_STMT_UPDATE_NO_FORCE, DB_UPDATE_REGISTER_STMT, DB_UPDATE_NO_FORCE_REGISTER) != DB_OK) ||
+         (db_prepare(DB_STMT_INC, DB_INC_REGISTER_STMT, "") != DB_OK) ||
+         (db_prepare(DB_STMT_INC_NO_FORCE, DB_INC_REGISTER_STMT, DB_UPDATE_NO_FORCE_REGISTER) != DB_OK) ||
+         (db_prepare(DB_STMT_TOUCH, DB_TOUCH_REGISTER_STMT, "") != DB_OK) ||
+         (db_prepare(DB_STMT_TOUCH_NO_FORCE, DB_TOUCH_REGISTER_STMT, DB_UPDATE_NO_FORCE_REGISTER) != DB_OK) ||
+         (db_prepare(DB_STMT_BEGIN, "BEGIN", "") != DB_OK) ||
+         (db_prepare(DB_STMT_COMMIT, "COMMIT", "") != DB_OK) ||
+         (db_prepare(DB_STMT_ROLLBACK, "ROLLBACK", "") != DB_OK) )
+    {
+        db_finalize();
+        sqlite3_close ( db );
+        db = 0;
+        return DB_FAIL_CREATE;
+    }
+
+    // Start the write-behind thread
+    pthread_condattr_init(&cond_attr);
+    pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&db_pending_cond, &cond_attr);
+    pthread_condattr_destroy(&cond_attr);
+
+    db_writer_running = 1;
+    if ( pthread_create(&db_writer_thread, NULL, db_writer, NULL) != 0 )
+    {
+        logger(LOG_ERR, "ERROR: DB failed to create writer thread\n");
+        db_writer_running = 0;
+        db_finalize();
+        sqlite3_close ( db );
+        db = 0;
+        return DB_FAIL_CREATE;
+    }
 #endif
     return DB_OK;
 
@@ -100,31 +450,173 @@ int callback_print_sql_result(char *NotUsed, int argc, char **argv, char **azCol
 }
 
 
+#ifndef _WIN32
+/**
+ * Apply a pending write to a register the way db_write() does it in the database.
+ */
+static void db_apply_pending ( db_row_t *r, const db_pending_t *p )
+{
+    if ( r->exists && ((p->force_write == 1) || (r->writeable == 1)) )
+    {
+        if ( p->op == DB_OP_SET )
+        {
+            r->value = p->value;
+        }
+        else if ( p->op == DB_OP_INC )
+        {
+            r->value += p->value;
+        }
+    }
+    else if ( p->create_missing == 1 )
+    {
+        r->value = (p->op == DB_OP_TOUCH) ? 0 : p->value;
+        r->writeable = p->writeable;
+        r->exists = 1;
+    }
+}
+
+
+/**
+ * Apply the pending writes of register r->address, *j indexes the sorted
+ * db_read_pending[] and is moved past them.
+ */
+static void db_apply_pending_all ( db_row_t *r, int *j, int cnt )
+{
+    while ( (*j < cnt) && (db_read_pending[*j].address == r->address) )
+    {
+        db_apply_pending(r, &db_read_pending[*j]);
+        (*j)++;
+    }
+}
+
+
+/**
+ * Sort db_read_pending[] on the register address. Insertion sort, it is
+ * stable so the writes of a register stay in queue order.
+ */
+static void db_read_pending_sort ( int cnt )
+{
+    db_pending_t tmp;
+    int i, k;
+
+    for ( i = 1; i < cnt; i++ )
+    {
+        tmp = db_read_pending[i];
+        for ( k = i; (k > 0) && (db_read_pending[k - 1].address > tmp.address); k-- )
+        {
+            db_read_pending[k] = db_read_pending[k - 1];
+        }
+        db_read_pending[k] = tmp;
+    }
+}
+
+
+// Same callback interface as sqlite3_exec()
+static int db_report_row ( const db_row_t *r, int (*callback)(char *, int,  char **, char **) )
+{
+    char address[16];
+    char value[16];
+    char *argv[2];
+    char *cols[2] = { "registeraddress", "registervalue" };
+
+    if ( (callback == NULL) || !r->exists )
+    {
+        return 0;
+    }
+    snprintf(address, sizeof(address), "%d", r->address);
+    snprintf(value, sizeof(value), "%d", r->value);
+    argv[0] = address;
+    argv[1] = value;
+    return callback(NULL, 2, argv, cols);
+}
+#endif
+
+
+/**
+ * Reads registers, the pending writes are applied to what is in the
+ * database, so the result is the same as after a db_flush().
+ */
 int db_get_register ( int register_address, int number_of_registers,
             int (*callback)(char *, int,  char **, char **))
 {
 #ifndef _WIN32
-  char sql_cmd_get_reg[255];
-  char tmp_sql_cmd_get_reg[50];
-  char *reply = NULL;
+  sqlite3_stmt *stmt;
+  db_row_t row;
   int rc=0;
+  int i;
+  int j = 0;
+  int cnt = 0;
 
   if (!db)
     return DB_FAIL_EXISTS;
 
-  tmp_sql_cmd_get_reg[0] = '\0';
+  // Holding db_lock no batch is written while we read, what is still pending
+  // is in db_pending
+  pthread_mutex_lock(&db_lock);
 
+  pthread_mutex_lock(&db_pending_lock);
+  for ( i = 0; i < db_pending_cnt; i++ )
+  {
+      if ( (db_pending[i].address >= register_address) &&
+           (db_pending[i].address < (register_address + number_of_registers)) )
+      {
+          db_read_pending[cnt++] = db_pending[i];
+      }
+  }
+  pthread_mutex_unlock(&db_pending_lock);
+  db_read_pending_sort(cnt);
 
-  snprintf(sql_cmd_get_reg, sizeof(sql_cmd_get_reg), DB_GET_REGISTER,
-        DB_GET_SELECT, register_address, register_address, number_of_registers, tmp_sql_cmd_get_reg);
+  stmt = db_stmt[DB_STMT_GET];
+  sqlite3_bind_int(stmt, 1, register_address);
+  sqlite3_bind_int(stmt, 2, register_address + number_of_registers);
 
-  //logger(LOG_DEBUG, "SQL DB_GET_REGISTER [%s]\n", sql_cmd_get_reg);
+  while ( (rc = sqlite3_step(stmt)) == SQLITE_ROW )
+  {
+      row.address = sqlite3_column_int(stmt, 0);
+      row.value = sqlite3_column_int(stmt, 1);
+      row.writeable = sqlite3_column_int(stmt, 2);
+      row.exists = 1;
+
+      // Registers before this one that only exist pending
+      while ( (j < cnt) && (db_read_pending[j].address < row.address) )
+      {
+          db_row_t created = { db_read_pending[j].address, 0, 0, 0 };
+          db_apply_pending_all(&created, &j, cnt);
+          if ( db_report_row(&created, callback) != 0 )
+          {
+              rc = SQLITE_ABORT;
+              break;
+          }
+      }
+      if ( rc == SQLITE_ABORT )
+      {
+          break;
+      }
+
+      db_apply_pending_all(&row, &j, cnt);
+      if ( db_report_row(&row, callback) != 0 )
+      {
+          rc = SQLITE_ABORT;
+          break;
+      }
+  }
+  sqlite3_reset(stmt);
+
+  while ( (rc == SQLITE_DONE) && (j < cnt) )
+  {
+      db_row_t created = { db_read_pending[j].address, 0, 0, 0 };
+      db_apply_pending_all(&created, &j, cnt);
+      if ( db_report_row(&created, callback) != 0 )
+      {
+          rc = SQLITE_ABORT;
+      }
+  }
 
-  rc = sqlite3_exec(db, sql_cmd_get_reg, (sqlite3_callback) callback, NULL, &reply);
+  pthread_mutex_unlock(&db_lock);
 
-  if ( rc != SQLITE_OK )
+  if ( rc != SQLITE_DONE )
     {
-      logger(LOG_ERR, "DB GET REGISTER Sqlite3 error[%d]: %s\n", rc, reply);
+      logger(LOG_ERR, "DB GET REGISTER Sqlite3 error[%d]: %s\n", rc, sqlite3_errmsg(db));
       return DB_FAIL_SELECT;
     }
 #endif
@@ -154,60 +646,10 @@ int db_get_register ( int register_address, int number_of_registers,
 int db_touch_register ( int register_address, int create_missing, int force_write, int writeable )
 {
 #ifndef _WIN32
-    char sql_cmd_touch_reg[255];
-    char end_sql[25];
-    char *reply = 0;
-
-    int rc, num_of_rows;
-
-    if (!db)
-        return DB_FAIL_EXISTS;
-
-
-    if ( force_write == 1 )
-    {
-        end_sql[0] = '\0';
-    }
-    else
-    {
-        strcpy( end_sql, DB_UPDATE_NO_FORCE_REGISTER);
-    }
-
-    snprintf(sql_cmd_touch_reg, 255, DB_TOUCH_REGISTER, register_address, end_sql);
-
-    logger_mod((LOGGER_MOD_LINOS|LOGGER_SUB_OS_DATABASE), LOG_DEBUG, "SQL DB_TOUCH_REGISTER [%s]\n", sql_cmd_touch_reg);
-
-    rc = sqlite3_exec(db, sql_cmd_touch_reg, 0, 0, &reply);
-
-    if ( rc != SQLITE_OK )
-    {
-
-        logger(LOG_ERR, "ERROR: DB TOUCH REGISTER Sqlite3 error[%d]: %s\n", rc, reply);
-        return DB_FAIL_INSERT;
-    }
-    else
-    {
-        // Check that there was a row changed
-        // otherwise  try SET (REPLACE)
-        num_of_rows = sqlite3_changes(db);
-        if ( num_of_rows != 1 )
-        {
-            if ( create_missing == 1 )
-            {
-                // Update didn't work try SET (REPLACE)
-                snprintf(sql_cmd_touch_reg, 255, DB_SET_REGISTER, 0, register_address, writeable);
-                rc = sqlite3_exec(db, sql_cmd_touch_reg, 0, 0, &reply);
-                if ( rc != SQLITE_OK )
-                {
-                    // SET failed
-                    logger(LOG_ERR, "ERROR: DB TOUCH REGISTER Sqlite3 error[%d]: %s\n", rc, reply);
-                    return DB_FAIL_INSERT;
-                }
-            }
-        }
-    }
-#endif
+    return db_queue(register_address, DB_OP_TOUCH, 0, create_missing, force_write, writeable);
+#else
     return DB_OK;
+#endif
 
 } // END db_touch_register
 
@@ -233,60 +675,10 @@ int db_touch_register ( int register_address, int create_missing, int force_writ
 int db_inc_register ( int register_address, int register_inc_value, int create_missing, int force_write, int writeable )
 {
 #ifndef _WIN32
-  char sql_cmd_set_reg[255];
-  char end_sql[25];
-  char *reply = 0;
-
-  int rc, num_of_rows;
-
-  if (!db)
-    return DB_FAIL_EXISTS;
-
-  if ( force_write == 1 )
-  {
-    end_sql[0] = '\0';
-  }
-  else
-  {
-    strcpy( end_sql, DB_UPDATE_NO_FORCE_REGISTER);
-  }
-
-  snprintf(sql_cmd_set_reg, 255, DB_INC_REGISTER, register_inc_value, register_address, end_sql);
-
-  //logger(LOG_DEBUG, "SQL DB_INC_REGISTER [%s]\n", sql_cmd_set_reg);
-
-  rc = sqlite3_exec(db, sql_cmd_set_reg, 0, 0, &reply);
-
-  if ( rc != SQLITE_OK )
-  {
-
-      logger(LOG_ERR, "ERROR: DB INC REGISTER Sqlite3 error[%d]: %s\n", rc, reply);
-      return DB_FAIL_INSERT;
-  }
-  else
-  {
-    // Check that there was a row changed
-    // otherwise  try SET (REPLACE)
-    num_of_rows = sqlite3_changes(db);
-    if ( num_of_rows != 1 )
-    {
-        if ( create_missing == 1 )
-        {
-            // Update didn't work try SET (REPLACE)
-            snprintf(sql_cmd_set_reg, 255, DB_SET_REGISTER, register_inc_value, register_address, writeable);
-            rc = sqlite3_exec(db, sql_cmd_set_reg, 0, 0, &reply);
-            if ( rc != SQLITE_OK )
-            {
-                // SET failed
-                logger(LOG_ERR, "ERROR: DB INC REGISTER Sqlite3 error[%d]: %s\n", rc, reply);
-                return DB_FAIL_INSERT;
-            }
-          }
-    }
-  }
+    return db_queue(register_address, DB_OP_INC, register_inc_value, create_missing, force_write, writeable);
+#else
+    return DB_OK;
 #endif
- return DB_OK;
-
 }
 
 
@@ -311,63 +703,92 @@ int db_inc_register ( int register_address, int register_inc_value, int create_m
 int db_set_register ( int register_address, int register_value, int create_missing, int force_write, int writeable )
 {
 #ifndef _WIN32
-    char sql_cmd_set_reg[255];
-    char end_sql[25];
-    char *reply = 0;
+    return db_queue(register_address, DB_OP_SET, register_value, create_missing, force_write, writeable);
+#else
+    return DB_OK;
+#endif
+}
 
-    int rc, num_of_rows;
 
-    if (!db)
-        return DB_FAIL_EXISTS;
+/**
+ *
+ * db_flush
+ *
+ * Write all pending register writes to the database in one transaction.
+ * Called periodically by the writer thread, callers only need it to make
+ * sure the data is written before something else reads the database file.
+*/
 
-    if ( force_write == 1 )
-    {
-        end_sql[0] = '\0';
-    }
-    else
-    {
-        strcpy( end_sql, DB_UPDATE_NO_FORCE_REGISTER);
-    }
+int db_flush ( void )
+{
+#ifndef _WIN32
+    db_pending_t *batch;
+    int cnt, i;
+    int in_transaction;
+    int rv = DB_OK;
 
-    snprintf(sql_cmd_set_reg, 255, DB_UPDATE_REGISTER, register_value, register_address, end_sql);
+    if (!db)
+        return DB_FAIL_EXISTS;
 
-    logger(LOG_DEBUG, "SQL DB_SET_REGISTER [%s]\n", sql_cmd_set_reg);
+    pthread_mutex_lock(&db_lock);
 
-    rc = sqlite3_exec(db, sql_cmd_set_reg, 0, 0, &reply);
+    pthread_mutex_lock(&db_pending_lock);
+    batch = db_pending;
+    cnt = db_pending_cnt;
+    db_pending = (batch == db_pending_buf[0]) ? db_pending_buf[1] : db_pending_buf[0];
+    db_pending_cnt = 0;
+    pthread_mutex_unlock(&db_pending_lock);
 
-    if ( rc != SQLITE_OK )
+    if ( cnt > 0 )
     {
+        // Without the transaction, e.g. when another process holds the
+        // database longer than DB_BUSY_TIMEOUT, each write commits on its own
+        in_transaction = (sqlite3_step(db_stmt[DB_STMT_BEGIN]) == SQLITE_DONE);
+        if ( !in_transaction )
+        {
+            logger(LOG_WARNING, "WARNING: DB BEGIN Sqlite3: %s, writing %d registers one by one\n",
+                    sqlite3_errmsg(db), cnt);
+        }
+        sqlite3_reset(db_stmt[DB_STMT_BEGIN]);
 
-        logger(LOG_ERR, "ERROR: DB SET REGISTER Sqlite3 error[%d]: %s\n", rc, reply);
-        return DB_FAIL_INSERT;
-    }
-    else
-    {
-        // Check that there was a row changed
-        // otherwise  try SET (REPLACE)
-        num_of_rows = sqlite3_changes(db);
-        if ( num_of_rows != 1 )
+        for ( i = 0; i < cnt; i++ )
         {
-            if ( create_missing == 1 )
+            if ( db_write(&batch[i]) != DB_OK )
             {
-                // Update didn't work try SET (REPLACE)
-                snprintf(sql_cmd_set_reg, 255, DB_SET_REGISTER, register_value, register_address, writeable);
-                rc = sqlite3_exec(db, sql_cmd_set_reg, 0, 0, &reply);
-                if ( rc != SQLITE_OK )
-                {
-                    // SET failed
-                    logger(LOG_ERR, "ERROR: DB SET REGISTER Sqlite3 error[%d]: %s\n", rc, reply);
-                    return DB_FAIL_INSERT;
-                }
+                rv = DB_FAIL_INSERT;
+                db_fail_cnt++;
             }
         }
-    }
-#endif
-    return DB_OK;
 
-}
+        if ( in_transaction )
+        {
+            if ( sqlite3_step(db_stmt[DB_STMT_COMMIT]) != SQLITE_DONE )
+            {
+                logger(LOG_ERR, "ERROR: DB COMMIT Sqlite3: %s\n", sqlite3_errmsg(db));
+                rv = DB_FAIL_INSERT;
+                db_fail_cnt += cnt;
+                // Do not leave the transaction open for the next batch
+                sqlite3_reset(db_stmt[DB_STMT_COMMIT]);
+                sqlite3_step(db_stmt[DB_STMT_ROLLBACK]);
+                sqlite3_reset(db_stmt[DB_STMT_ROLLBACK]);
+            }
+            else
+            {
+                sqlite3_reset(db_stmt[DB_STMT_COMMIT]);
+            }
+        }
+
+        db_flush_cnt++;
+        db_flush_rows += cnt;
+    }
 
+    pthread_mutex_unlock(&db_lock);
 
+    return rv;
+#else
+    return DB_OK;
+#endif
+}
 
 
 int db_close ( void )
@@ -376,6 +797,22 @@ int db_close ( void )
   if (!db)
     return DB_FAIL_EXISTS;
 
+  if ( db_writer_running )
+  {
+      pthread_mutex_lock(&db_pending_lock);
+      db_writer_running = 0;
+      pthread_cond_signal(&db_pending_cond);
+      pthread_mutex_unlock(&db_pending_lock);
+      pthread_join(db_writer_thread, NULL);
+  }
+
+  (void)db_flush();
+
+  logger_mod((LOGGER_MOD_LINOS|LOGGER_SUB_OS_DATABASE), LOG_INFO,
+          "DB writes: %lu merged: %lu full: %lu flushes: %lu rows: %lu failed: %lu\n",
+          db_req_cnt, db_merged_cnt, db_full_cnt, db_flush_cnt, db_flush_rows, db_fail_cnt);
+
+  db_finalize();
   sqlite3_close ( db );
   db = 0;
 #endif
@@ -39,6 +39,23 @@
 
 #define DB_ECU_RUNTIME_REG_ADDRESS    1
 
+// Task timing statistics, see LinuxOs_TaskStats.h. One block of
+// DB_TASK_STATS_REG_CNT registers per task, starting at
+// DB_TASK_STATS_REG_ADDRESS + (TaskId * DB_TASK_STATS_REG_CNT). Times in us.
+#define DB_TASK_STATS_REG_ADDRESS     1000
+#define DB_TASK_STATS_REG_CNT         64
+#define DB_TASK_STATS_ACTIVATE        0  // Activations
+#define DB_TASK_STATS_COMPLETE        1  // Completed activations
+#define DB_TASK_STATS_DEADLINE_MISS   2  // Activations while still running
+#define DB_TASK_STATS_RESPONSE_AVG    3
+#define DB_TASK_STATS_RESPONSE_MAX    4
+#define DB_TASK_STATS_JITTER_MAX      5
+#define DB_TASK_STATS_EXEC_AVG        6
+#define DB_TASK_STATS_EXEC_MAX        7
+#define DB_TASK_STATS_RESPONSE_HIST   8  // LINOS_HIST_BUCKETS registers each
+#define DB_TASK_STATS_JITTER_HIST     24
+#define DB_TASK_STATS_EXEC_HIST       40
+
 
 #define DB_CHECK "SELECT * FROM arccore_cal"
 
@@ -78,6 +95,37 @@
 
 #define DB_TOUCH_REGISTER "UPDATE arccore_cal SET sensortimestamp = time('now') WHERE registeraddress = %d %s"
 
+// Prepared statement versions of the above, DB_UPDATE_NO_FORCE_REGISTER is appended when needed.
+// Also selects writeable, to apply the pending writes to what is read
+#define DB_GET_REGISTER_STMT "SELECT " DB_GET_SELECT ", writeable FROM arccore_cal WHERE \
+                registeraddress >= ?1 AND \
+                registeraddress < ?2 \
+                ORDER BY registeraddress ASC;"
+
+#define DB_SET_REGISTER_STMT "REPLACE INTO arccore_cal (registervalue, registeraddress, writeable) \
+                VALUES (?1, ?2, ?3)"
+
+#define DB_UPDATE_REGISTER_STMT "UPDATE arccore_cal SET registervalue = ?1 WHERE registeraddress = ?2"
+
+#define DB_INC_REGISTER_STMT "UPDATE arccore_cal SET registervalue = registervalue + ?1 WHERE registeraddress = ?2"
+
+#define DB_TOUCH_REGISTER_STMT "UPDATE arccore_cal SET sensortimestamp = time('now') WHERE registeraddress = ?2"
+
+#define DB_JOURNAL_MODE "PRAGMA journal_mode=WAL; PRAGMA synchronous=NORMAL;"
+
+// Write-behind. Register writes are merged in memory per register and written
+// by a background thread in one transaction every DB_FLUSH_PERIOD_MS. A failed
+// background write is returned by the next db_set/inc/touch_register call.
+// Writes with different flags are kept apart, db_get_register applies the
+// pending writes to what it reads from the database.
+#define DB_FLUSH_PERIOD_MS 100
+// Max number of registers with pending writes. The writer is woken early when
+// DB_PENDING_WAKE are pending, when full the caller writes the batch itself.
+#ifndef DB_PENDING_MAX
+#define DB_PENDING_MAX 256
+#endif
+#define DB_PENDING_WAKE ((DB_PENDING_MAX * 3) / 4)
+
 
 // Log function IMPROVEMENT
 
@@ -100,6 +148,8 @@ int db_inc_register ( int register_address, int register_inc_value, int create_m
 
 int db_touch_register ( int register_address, int create_missing, int force_write, int writeable );
 
+int db_flush ( void );
+
 int db_close ( void );
 
 
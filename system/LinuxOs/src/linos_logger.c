@@ -40,6 +40,14 @@
 #include "linos_logger.h"
 #include <stdio.h> // vsprintf
 #include <string.h> // strlen
+#ifndef _WIN32
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <time.h>
+#endif
 
 #include <os_i.h>
 #include <os_sys.h>  /* OS_SYS_PTR */
@@ -76,6 +84,90 @@ int logger_output_mask = 1;
 
 extern int DebugMask;
 
+#ifndef _WIN32
+/*
+ * Asynchronous logging
+ *
+ * The calling thread only copies the format pointer (used as format ID),
+ * the OS tick and the raw arguments into its own single producer/single
+ * consumer ring. The logger thread formats and writes the records. Strings
+ * (%s) are copied since they may not live until the record is written.
+ *
+ * Formats are parsed once and the argument types cached by format pointer,
+ * so only literal formats are queued (logger_lit(), logger_mod_lit() and the
+ * macros in linos_logger.h). Formats that can't be queued (%n, '*' width,
+ * long double, wide strings or too many arguments) are logged synchronously.
+ *
+ * The logger thread sleeps on a futex when all rings are empty, at most
+ * LOGGER_ASYNC_FLUSH_MS. A producer wakes it when its ring holds
+ * LOGGER_ASYNC_WAKE_FILL records or for LOG_WARNING and more urgent, so a
+ * burst pays for one wake up and not one per record. The logger thread sets
+ * logger_sleeping and checks the rings again before it waits, a producer
+ * checks logger_sleeping after publishing a record, so one of them always
+ * sees the other.
+ */
+
+#define LOGGER_ARG_INT      0
+#define LOGGER_ARG_LONG     1
+#define LOGGER_ARG_LLONG    2
+#define LOGGER_ARG_DOUBLE   3
+#define LOGGER_ARG_PTR      4
+#define LOGGER_ARG_STR      5
+
+#define LOGGER_FMT_CACHE_SIZE   512     // Power of 2
+#define LOGGER_FMT_CACHE_PROBE  8
+
+typedef struct {
+    const char *fmt;
+    volatile int ready;
+    int sync;                           // Can't be queued, log synchronously
+    int argc;
+    uint8_t type[LOGGER_ASYNC_ARGS_MAX];
+} logger_fmt_t;
+
+typedef union {
+    long long ll;
+    double d;
+    const void *p;
+    uint32_t str_off;
+} logger_arg_t;
+
+typedef struct {
+    const char *fmt;
+    const logger_fmt_t *desc;
+    uint32_t tick;
+    int loglevel;
+    logger_arg_t arg[LOGGER_ASYNC_ARGS_MAX];
+    char str[LOGGER_ASYNC_STR_MAX];
+} logger_record_t;
+
+typedef struct logger_ring {
+    struct logger_ring *next;
+    volatile uint32_t head;             // Written by the owning thread
+    volatile uint32_t tail;             // Written by the logger thread
+    volatile uint32_t dropped;          // Written by the owning thread
+    uint32_t dropped_reported;
+    logger_record_t rec[LOGGER_ASYNC_RING_SIZE];
+} logger_ring_t;
+
+static logger_fmt_t logger_fmt_cache[LOGGER_FMT_CACHE_SIZE];
+
+static logger_ring_t *logger_rings = NULL;  // All rings, never freed
+static pthread_mutex_t logger_rings_lock = PTHREAD_MUTEX_INITIALIZER;
+static __thread logger_ring_t *logger_ring_self = NULL;
+static __thread int logger_in_push = 0;
+
+static volatile int logger_async_running = 0;
+static int logger_sleeping = 0;
+static uint32_t logger_wake_seq = 0;
+static pthread_t logger_thread;
+static uint64_t logger_written = 0;
+static uint64_t logger_dropped = 0;
+
+static void logger_write(int loglevel, uint32_t tick, const char *msg);
+static void logger_emit(int loglevel, const char *format, va_list listPointer, int literal);
+#endif
+
 #ifdef USE_SYSLOG
 /*
  *
@@ -143,20 +235,39 @@ int logger_set_output(int bitMask) {
 
 
 
-void logger_mod(uint16_t logmodule, int loglevel, char *format, ... ) {
 #ifndef _WIN32
-    va_list listPointer; // Pointer to variable arguments
-    va_start ( listPointer, format); // Set the pointer to the last fixed argument.
-
+static int logger_mod_enabled(uint16_t logmodule) {
     uint16_t module,submodule;
 
     module = (( logmodule >> 8 )& 0xff) ;
     submodule = (logmodule & 0xff);
 
-    if ( ((DebugMask >> 8)&0xff) & module) {
-        if ( (DebugMask&0xff) & submodule ) {
-            logger_va(loglevel, format, listPointer);
-        }
+    return ((((DebugMask >> 8)&0xff) & module) && ((DebugMask&0xff) & submodule));
+}
+#endif
+
+void (logger_mod)(uint16_t logmodule, int loglevel, char *format, ... ) {
+#ifndef _WIN32
+    va_list listPointer; // Pointer to variable arguments
+    va_start ( listPointer, format); // Set the pointer to the last fixed argument.
+
+    if ( logger_mod_enabled(logmodule) ) {
+        logger_emit(loglevel, format, listPointer, 0);
+    }
+    va_end( listPointer );
+#endif
+}
+
+/*
+ * As logger_mod() for literal formats, these may be logged asynchronously.
+ */
+void logger_mod_lit(uint16_t logmodule, int loglevel, char *format, ... ) {
+#ifndef _WIN32
+    va_list listPointer;
+    va_start ( listPointer, format);
+
+    if ( logger_mod_enabled(logmodule) ) {
+        logger_emit(loglevel, format, listPointer, 1);
     }
     va_end( listPointer );
 #endif
@@ -175,35 +286,406 @@ void logger_mod(uint16_t logmodule, int loglevel, char *format, ... ) {
  *
 */
 
-void logger ( int loglevel, char *format, ... ) {
+void (logger) ( int loglevel, char *format, ... ) {
 #ifndef _WIN32
     va_list listPointer; // Pointer to variable arguments
 
     va_start ( listPointer, format); // Set the pointer to the last fixed argument.
 
-    logger_va (loglevel, format, listPointer);
+    logger_emit (loglevel, format, listPointer, 0);
     va_end( listPointer );
 #endif
 }
 
+/*
+ * As logger() for literal formats, these may be logged asynchronously.
+ */
+void logger_lit ( int loglevel, char *format, ... ) {
 #ifndef _WIN32
-void logger_va(int loglevel, char *format, va_list listPointer) {
-    char format_buffer[255] = {'\0'};
-    char print_buffer[255] = {'\0'}; // Temp string buffer
-    char timestamp_buffer[16]  = {'\0'};
+    va_list listPointer;
 
-    snprintf(timestamp_buffer, (sizeof(timestamp_buffer) -1), "[%u]:", OS_SYS_PTR->tick);
+    va_start ( listPointer, format);
 
-    // log_prefix    
-    if ( strlen(log_prefix) > 1 ) {
-        strcpy(print_buffer, log_prefix);
-        strcat(print_buffer, " : ");
+    logger_emit (loglevel, format, listPointer, 1);
+    va_end( listPointer );
+#endif
+}
+
+#ifndef _WIN32
+static void logger_futex_wait(uint32_t *addr, uint32_t val) {
+    struct timespec timeout = { LOGGER_ASYNC_FLUSH_MS / 1000, (LOGGER_ASYNC_FLUSH_MS % 1000) * 1000000L };
+
+    (void)syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, val, &timeout, NULL, 0);
+}
+
+static void logger_futex_wake(uint32_t *addr) {
+    (void)syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+}
+
+static void logger_async_wake(void) {
+    __atomic_add_fetch(&logger_wake_seq, 1, __ATOMIC_RELEASE);
+    logger_futex_wake(&logger_wake_seq);
+}
+
+/*
+ * Parse the conversions in a format. Returns 0 if it can be queued.
+ */
+static int logger_fmt_parse(const char *fmt, logger_fmt_t *d) {
+    const char *p = fmt;
+    int len;
+
+    d->argc = 0;
+    d->sync = 0;
+
+    while (*p != '\0') {
+        if (*p++ != '%') {
+            continue;
+        }
+        if (*p == '%') {
+            p++;
+            continue;
+        }
+        // Flags, width and precision
+        while ((*p != '\0') && (strchr("-+ #0123456789.", *p) != NULL)) {
+            p++;
+        }
+        // Length modifier, counted in 'l'/'q' steps, 'z' 't' 'j' are long here
+        len = 0;
+        while ((*p != '\0') && (strchr("hlqzjtL", *p) != NULL)) {
+            if ((*p == 'l') || (*p == 'q')) {
+                len++;
+            } else if ((*p == 'z') || (*p == 't') || (*p == 'j')) {
+                len = 1;
+            } else if (*p == 'L') {
+                len = 3;
+            }
+            p++;
+        }
+        if (d->argc >= LOGGER_ASYNC_ARGS_MAX) {
+            d->sync = 1;
+            break;
+        }
+        switch (*p) {
+        case 'd': case 'i': case 'u': case 'o': case 'x': case 'X': case 'c':
+            d->type[d->argc++] = (len == 0) ? LOGGER_ARG_INT :
+                                 (len == 1) ? LOGGER_ARG_LONG : LOGGER_ARG_LLONG;
+            break;
+        case 'e': case 'E': case 'f': case 'F': case 'g': case 'G': case 'a': case 'A':
+            if (len == 3) {
+                d->sync = 1;
+            }
+            d->type[d->argc++] = LOGGER_ARG_DOUBLE;
+            break;
+        case 'p':
+            d->type[d->argc++] = LOGGER_ARG_PTR;
+            break;
+        case 's':
+            if (len != 0) {
+                d->sync = 1;
+            }
+            d->type[d->argc++] = LOGGER_ARG_STR;
+            break;
+        default:
+            // %n, '*' and anything unknown
+            d->sync = 1;
+            break;
+        }
+        if ((d->sync == 1) || (*p == '\0')) {
+            break;
+        }
+        p++;
     }
+    return d->sync;
+}
 
-    vsnprintf(format_buffer, (sizeof(format_buffer) -1 ), format,listPointer); // printf -> print_buffer
-    strcat( print_buffer,timestamp_buffer);
+/*
+ * Get the cached description of a format, parse it into tmp if not cached.
+ */
+static const logger_fmt_t *logger_fmt_get(const char *fmt, logger_fmt_t *tmp) {
+    uint32_t h = (uint32_t)(((uintptr_t)fmt >> 2) * 2654435761u);
+    logger_fmt_t *d;
+    const char *expected;
+    int i;
+
+    for (i = 0; i < LOGGER_FMT_CACHE_PROBE; i++) {
+        d = &logger_fmt_cache[(h + i) & (LOGGER_FMT_CACHE_SIZE - 1)];
+        expected = __atomic_load_n(&d->fmt, __ATOMIC_ACQUIRE);
+        if (expected == fmt) {
+            if (__atomic_load_n(&d->ready, __ATOMIC_ACQUIRE)) {
+                return d;
+            }
+            break;  // Being added by another thread
+        }
+        if ((expected == NULL) &&
+            __atomic_compare_exchange_n(&d->fmt, &expected, fmt, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            (void)logger_fmt_parse(fmt, d);
+            __atomic_store_n(&d->ready, 1, __ATOMIC_RELEASE);
+            return d;
+        }
+        if (expected == fmt) {
+            break;
+        }
+    }
+    (void)logger_fmt_parse(fmt, tmp);
+    return tmp;
+}
 
-    strcat( print_buffer,format_buffer);
+static logger_ring_t *logger_ring_get(void) {
+    logger_ring_t *r = logger_ring_self;
+
+    if (r == NULL) {
+        r = calloc(1, sizeof(logger_ring_t));
+        if (r != NULL) {
+            pthread_mutex_lock(&logger_rings_lock);
+            r->next = logger_rings;
+            __atomic_store_n(&logger_rings, r, __ATOMIC_RELEASE);
+            pthread_mutex_unlock(&logger_rings_lock);
+            logger_ring_self = r;
+        }
+    }
+    return r;
+}
+
+/*
+ * Queue a message. Returns 0 if queued or dropped, -1 if it has to be
+ * logged synchronously. listPointer is only used when 0 is returned.
+ */
+static int logger_async_push(int loglevel, const char *format, va_list listPointer) {
+    logger_fmt_t tmp;
+    const logger_fmt_t *d;
+    logger_ring_t *r;
+    logger_record_t *rec;
+    const char *str;
+    uint32_t head;
+    uint32_t fill;
+    uint32_t off = 0;
+    size_t n;
+    int i;
+
+    d = logger_fmt_get(format, &tmp);
+    r = logger_ring_get();
+    if ((d->sync == 1) || (r == NULL) || (logger_in_push == 1)) {
+        // logger_in_push: called from a signal handler that interrupted a push
+        return -1;
+    }
+    logger_in_push = 1;
+
+    head = r->head;
+    fill = head - __atomic_load_n(&r->tail, __ATOMIC_ACQUIRE);
+    if (fill >= LOGGER_ASYNC_RING_SIZE) {
+        __atomic_store_n(&r->dropped, r->dropped + 1, __ATOMIC_RELAXED);
+        logger_in_push = 0;
+        return 0;
+    }
+
+    rec = &r->rec[head & (LOGGER_ASYNC_RING_SIZE - 1)];
+    rec->fmt = format;
+    // A description parsed into tmp is not cached, the logger thread parses it again
+    rec->desc = (d == &tmp) ? NULL : d;
+    rec->tick = OS_SYS_PTR->tick;
+    rec->loglevel = loglevel;
+    for (i = 0; i < d->argc; i++) {
+        switch (d->type[i]) {
+        case LOGGER_ARG_INT:    rec->arg[i].ll = va_arg(listPointer, int); break;
+        case LOGGER_ARG_LONG:   rec->arg[i].ll = va_arg(listPointer, long); break;
+        case LOGGER_ARG_LLONG:  rec->arg[i].ll = va_arg(listPointer, long long); break;
+        case LOGGER_ARG_DOUBLE: rec->arg[i].d = va_arg(listPointer, double); break;
+        case LOGGER_ARG_PTR:    rec->arg[i].p = va_arg(listPointer, void *); break;
+        default:
+            str = va_arg(listPointer, const char *);
+            if (str == NULL) {
+                str = "(null)";
+            }
+            n = strnlen(str, LOGGER_ASYNC_STR_MAX - 1 - off);
+            memcpy(&rec->str[off], str, n);
+            rec->str[off + n] = '\0';
+            rec->arg[i].str_off = off;
+            off += n;
+            if (off < (LOGGER_ASYNC_STR_MAX - 1)) {
+                off++;
+            }
+            break;
+        }
+    }
+    __atomic_store_n(&r->head, head + 1, __ATOMIC_RELEASE);
+
+    // Pairs with the fence in logger_async_thread()
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&logger_sleeping, __ATOMIC_RELAXED) &&
+        (((fill + 1) >= LOGGER_ASYNC_WAKE_FILL) || (loglevel <= LOG_WARNING))) {
+        logger_async_wake();
+    }
+
+    logger_in_push = 0;
+    return 0;
+}
+
+/*
+ * Format a queued record, one conversion at a time.
+ */
+static void logger_async_format(const logger_record_t *rec, char *out, size_t size) {
+    logger_fmt_t tmp;
+    const logger_fmt_t *d = rec->desc;
+    const char *p = rec->fmt;
+    const char *start;
+    char spec[32];
+    size_t pos = 0;
+    size_t len;
+    int argi = 0;
+    int n;
+
+    if (d == NULL) {
+        (void)logger_fmt_parse(rec->fmt, &tmp);
+        d = &tmp;
+    }
+
+    out[0] = '\0';
+    while ((*p != '\0') && (pos < (size - 1))) {
+        if ((*p != '%') || (p[1] == '%')) {
+            out[pos++] = *p;
+            p += (*p == '%') ? 2 : 1;
+            continue;
+        }
+        start = p++;
+        while ((*p != '\0') && (strchr("diuoxXceEfFgGaAps", *p) == NULL)) {
+            p++;
+        }
+        if ((*p == '\0') || (argi >= d->argc)) {
+            break;
+        }
+        p++;
+        len = (size_t)(p - start);
+        if (len >= sizeof(spec)) {
+            len = sizeof(spec) - 1;
+        }
+        memcpy(spec, start, len);
+        spec[len] = '\0';
+
+        switch (d->type[argi]) {
+        case LOGGER_ARG_INT:    n = snprintf(&out[pos], size - pos, spec, (int)rec->arg[argi].ll); break;
+        case LOGGER_ARG_LONG:   n = snprintf(&out[pos], size - pos, spec, (long)rec->arg[argi].ll); break;
+        case LOGGER_ARG_LLONG:  n = snprintf(&out[pos], size - pos, spec, rec->arg[argi].ll); break;
+        case LOGGER_ARG_DOUBLE: n = snprintf(&out[pos], size - pos, spec, rec->arg[argi].d); break;
+        case LOGGER_ARG_PTR:    n = snprintf(&out[pos], size - pos, spec, rec->arg[argi].p); break;
+        default:                n = snprintf(&out[pos], size - pos, spec, &rec->str[rec->arg[argi].str_off]); break;
+        }
+        argi++;
+        if (n > 0) {
+            pos += (size_t)n;
+        }
+    }
+    if (pos > (size - 1)) {
+        pos = size - 1;
+    }
+    out[pos] = '\0';
+}
+
+/*
+ * Write all queued records. Returns the number written.
+ */
+static int logger_async_drain(void) {
+    logger_ring_t *r;
+    logger_record_t *rec;
+    char msg[255];
+    char drop_msg[64];
+    uint32_t tail;
+    uint32_t dropped;
+    int cnt = 0;
+
+    for (r = __atomic_load_n(&logger_rings, __ATOMIC_ACQUIRE); r != NULL; r = r->next) {
+        tail = r->tail;
+        while (tail != __atomic_load_n(&r->head, __ATOMIC_ACQUIRE)) {
+            rec = &r->rec[tail & (LOGGER_ASYNC_RING_SIZE - 1)];
+            logger_async_format(rec, msg, sizeof(msg));
+            logger_write(rec->loglevel, rec->tick, msg);
+            tail++;
+            __atomic_store_n(&r->tail, tail, __ATOMIC_RELEASE);
+            cnt++;
+        }
+
+        dropped = __atomic_load_n(&r->dropped, __ATOMIC_RELAXED);
+        if (dropped != r->dropped_reported) {
+            snprintf(drop_msg, sizeof(drop_msg), "logger: %u messages dropped", dropped - r->dropped_reported);
+            logger_write(LOG_WARNING, OS_SYS_PTR->tick, drop_msg);
+            logger_dropped += dropped - r->dropped_reported;
+            r->dropped_reported = dropped;
+        }
+    }
+    logger_written += cnt;
+    return cnt;
+}
+
+static void *logger_async_thread(void *arg) {
+    uint32_t seq;
+
+    (void)arg;
+
+    while (logger_async_running) {
+        if (logger_async_drain() == 0) {
+            seq = __atomic_load_n(&logger_wake_seq, __ATOMIC_ACQUIRE);
+            __atomic_store_n(&logger_sleeping, 1, __ATOMIC_RELAXED);
+            __atomic_thread_fence(__ATOMIC_SEQ_CST);
+            if ((logger_async_drain() == 0) && logger_async_running) {
+                logger_futex_wait(&logger_wake_seq, seq);
+            }
+            __atomic_store_n(&logger_sleeping, 0, __ATOMIC_RELAXED);
+        }
+    }
+    (void)logger_async_drain();
+    return NULL;
+}
+
+/*
+ * Switch logger() and logger_mod() with literal formats to asynchronous mode. Must be called
+ * after daemonising since the logger thread does not survive a fork.
+ *
+ * RETURNS 0 on success
+ */
+int logger_async_start(void) {
+    if (logger_async_running) {
+        return 0;
+    }
+    logger_async_running = 1;
+    if (pthread_create(&logger_thread, NULL, logger_async_thread, NULL) != 0) {
+        logger_async_running = 0;
+        return -1;
+    }
+    return 0;
+}
+
+/*
+ * Write all queued messages and go back to synchronous logging.
+ */
+void logger_async_stop(void) {
+    if (logger_async_running) {
+        logger_async_running = 0;
+        logger_async_wake();
+        pthread_join(logger_thread, NULL);
+    }
+}
+
+/*
+ * RETURNS 1 if logging asynchronously
+ */
+int logger_async_active(void) {
+    return logger_async_running;
+}
+
+void logger_async_stats(uint64_t *written, uint64_t *dropped) {
+    *written = logger_written;
+    *dropped = logger_dropped;
+}
+
+
+static void logger_write(int loglevel, uint32_t tick, const char *msg) {
+    char print_buffer[300] = {'\0'}; // Temp string buffer
+
+    // log_prefix
+    if ( strlen(log_prefix) > 1 ) {
+        snprintf(print_buffer, sizeof(print_buffer), "%s : [%u]:%s", log_prefix, tick, msg);
+    } else {
+        snprintf(print_buffer, sizeof(print_buffer), "[%u]:%s", tick, msg);
+    }
 
 #ifdef USE_SYSLOG
     if ((logger_output_mask & 2) == 2)
@@ -216,6 +698,26 @@ void logger_va(int loglevel, char *format, va_list listPointer) {
             fprintf(stderr, "%s:%s\n", LOG_LEVEL_STR[loglevel], print_buffer);
     }
 }
+
+
+/*
+ * Queue the message if literal and asynchronous logging is running, else
+ * format and write it now.
+ */
+static void logger_emit(int loglevel, const char *format, va_list listPointer, int literal) {
+    char format_buffer[255] = {'\0'};
+
+    if (literal && logger_async_running && (logger_async_push(loglevel, format, listPointer) == 0)) {
+        return;
+    }
+
+    vsnprintf(format_buffer, (sizeof(format_buffer) -1 ), format,listPointer); // printf -> print_buffer
+    logger_write(loglevel, OS_SYS_PTR->tick, format_buffer);
+}
+
+void logger_va(int loglevel, char *format, va_list listPointer) {
+    logger_emit(loglevel, format, listPointer, 0);
+}
 #endif
 /*
  *  logger_format_hex( char* s, int slength)
@@ -69,6 +69,20 @@
 //
 
 
+// Asynchronous logging, see logger_async_start().
+// Records per thread ring, power of 2
+#define LOGGER_ASYNC_RING_SIZE  256
+// Max number of arguments in an asynchronous message, others are logged synchronously
+#define LOGGER_ASYNC_ARGS_MAX   8
+// Bytes for copies of %s arguments in each record, longer strings are cut
+#define LOGGER_ASYNC_STR_MAX    96
+// Records in a ring that wake the logger thread, LOG_WARNING and more urgent always wake it
+#define LOGGER_ASYNC_WAKE_FILL  (LOGGER_ASYNC_RING_SIZE / 4)
+// Max time a record waits for the logger thread when not woken
+#define LOGGER_ASYNC_FLUSH_MS   100
+//
+
+
 // Declare functions
 
 void logger_open_close(int open_close, char *progname);
@@ -83,6 +97,29 @@ void logger(int loglevel, char *format, ... );
 
 void logger_mod(uint16_t logmodule, int loglevel, char *format, ... );
 
+void logger_lit(int loglevel, char *format, ... );
+
+void logger_mod_lit(uint16_t logmodule, int loglevel, char *format, ... );
+
 char* logger_format_hex(char* s, int slength);
 
+int logger_async_start(void);
+
+void logger_async_stop(void);
+
+int logger_async_active(void);
+
+void logger_async_stats(uint64_t *written, uint64_t *dropped);
+
+// An asynchronous record keeps the format pointer and the logger thread reads
+// the format later, so only string literals may be queued. logger() and
+// logger_mod() only take literal formats (a compile error otherwise), for
+// other formats call (logger)(), (logger_mod)() or logger_va(), these format
+// in the calling thread.
+#define logger(_loglevel, ...) \
+    logger_lit((_loglevel), "" __VA_ARGS__)
+
+#define logger_mod(_logmodule, _loglevel, ...) \
+    logger_mod_lit((_logmodule), (_loglevel), "" __VA_ARGS__)
+
 #endif
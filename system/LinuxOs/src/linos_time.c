@@ -18,7 +18,41 @@
 
 #include "linos_logger.h" /* Logger functions */
 
+#define NSEC_PER_SEC    1000000000
+
+int Linos_VirtualTimeMode = LINOS_VTIME_OFF;
+
+/* Virtual time is kept as ns since Linos_VirtualTimeInit() and added to the
+ * real clocks read at that point. Only the OS tick thread writes it. */
+static uint64 vtime_ns = 0;
+static struct timespec vtime_base_realtime;
+static struct timespec vtime_base_monotonic;
+
+static void vtime_get(const struct timespec *base, struct timespec *tp) {
+    uint64 ns = __atomic_load_n(&vtime_ns, __ATOMIC_ACQUIRE);
+
+    tp->tv_sec = base->tv_sec + (time_t)(ns / NSEC_PER_SEC);
+    tp->tv_nsec = base->tv_nsec + (long)(ns % NSEC_PER_SEC);
+    if (tp->tv_nsec >= NSEC_PER_SEC) {
+        tp->tv_nsec -= NSEC_PER_SEC;
+        tp->tv_sec++;
+    }
+}
+
+void Linos_VirtualTimeInit(void) {
+    clock_gettime(CLOCK_REALTIME, &vtime_base_realtime);
+    clock_gettime(CLOCK_MONOTONIC, &vtime_base_monotonic);
+}
+
+void Linos_VirtualTimeAdvance(uint32 ns) {
+    (void)__atomic_add_fetch(&vtime_ns, ns, __ATOMIC_RELEASE);
+}
+
 Std_ReturnType Linos_GetCurrentTime(struct timespec *tp ) {
+    if (Linos_VirtualTimeMode != LINOS_VTIME_OFF) {
+        vtime_get(&vtime_base_realtime, tp);
+        return E_OK;
+    }
     if (clock_gettime(CLOCK_REALTIME, tp)) {
         logger(LOG_ERR, "Linos_GetCurrentTime. problems getting CLOCK_REALTIME");
         return E_NOT_OK;
@@ -26,4 +60,16 @@ Std_ReturnType Linos_GetCurrentTime(struct timespec *tp ) {
     return E_OK;
 }
 
+Std_ReturnType Linos_GetMonotonicTime(struct timespec *tp ) {
+    if (Linos_VirtualTimeMode != LINOS_VTIME_OFF) {
+        vtime_get(&vtime_base_monotonic, tp);
+        return E_OK;
+    }
+    if (clock_gettime(CLOCK_MONOTONIC, tp)) {
+        logger(LOG_ERR, "Linos_GetMonotonicTime. problems getting CLOCK_MONOTONIC");
+        return E_NOT_OK;
+    }
+    return E_OK;
+}
+
 #endif /* Not defined _WIN32 */
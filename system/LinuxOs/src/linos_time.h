@@ -21,8 +21,24 @@
 
 #include <time.h>
 
+/* Virtual time modes, see Linos_VirtualTimeMode */
+#define LINOS_VTIME_OFF     0 /* Real time, the OS tick follows CLOCK_MONOTONIC */
+#define LINOS_VTIME_FREE    1 /* Tick as soon as all tasks are idle */
+#define LINOS_VTIME_STEP    2 /* Tick on step commands from a local socket */
+
+extern int Linos_VirtualTimeMode;
+
 Std_ReturnType Linos_GetCurrentTime(struct timespec *tp);
 
+/* Monotonic time, virtual when a virtual time mode is selected. */
+Std_ReturnType Linos_GetMonotonicTime(struct timespec *tp);
+
+/* Latch the real time that virtual time starts from. Call once at start-up. */
+void Linos_VirtualTimeInit(void);
+
+/* Move virtual time forward, called by the OS tick thread. */
+void Linos_VirtualTimeAdvance(uint32 ns);
+
 #endif /* Not defined _WIN32 */
 
 #endif /* _LINOS_TIME_H_ */
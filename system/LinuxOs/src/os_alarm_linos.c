@@ -60,6 +60,7 @@ void Os_AlarmAutostart(void) {
  * @param a_obj
  */
 static void AlarmProcess( OsAlarmType *aPtr ) {
+        Os_AlarmWheelRemove(aPtr);
         if( aPtr->cycletime == 0 ) {
                 aPtr->active = 0;
         } else {
@@ -67,48 +68,67 @@ static void AlarmProcess( OsAlarmType *aPtr ) {
                 aPtr->expire_val = Os_CounterAdd( Os_CounterGetValue(aPtr->counter),
                                                                                         Os_CounterGetMaxValue(aPtr->counter),
                                                                                         aPtr->cycletime);
+                Os_AlarmWheelInsert(aPtr);
         }
 }
 
 
-void Os_AlarmCheck( const OsCounterType *c_p ) {
+/* Only the due alarms at the head of the wheel slot of the counter value are
+ * visited, moved to a list of their own before the actions run, see os_alarm.c */
+void Os_AlarmCheck( OsCounterType *c_p ) {
 	OsAlarmType *a_obj;
+	OsAlarmType *last_obj = NULL;
+	LIST_HEAD(alarm_due,OsAlarm) due;
+	struct alarm_wheel *slot = &c_p->alarm_wheel[c_p->val & (OS_ALARM_WHEEL_SIZE - 1u)];
 	StatusType rv;
 
-	SLIST_FOREACH(a_obj,&c_p->alarm_head,alarm_list) {
+	LIST_INIT(&due);
+	a_obj = LIST_FIRST(slot);
+	while( (a_obj != NULL) && a_obj->active && (c_p->val == a_obj->expire_val) ) {
+		LIST_REMOVE(a_obj, wheel_list);
+		if( last_obj == NULL ) {
+			LIST_INSERT_HEAD(&due, a_obj, wheel_list);
+		} else {
+			LIST_INSERT_AFTER(last_obj, a_obj, wheel_list);
+		}
+		last_obj = a_obj;
+		a_obj = LIST_FIRST(slot);
+	}
+
+	while( (a_obj = LIST_FIRST(&due)) != NULL ) {
 		// logger(LOG_INFO,"Os_AlarmCheck a_obj->active %d  c_p->val %d a_obj->expire_val %d", a_obj->active, c_p->val, a_obj->expire_val);
-		if( a_obj->active && (c_p->val == a_obj->expire_val) ) {
-			/* Check if the alarms have expired */
-			logger_mod((LOGGER_MOD_LINOS|LOGGER_SUB_OS_ALARM), LOG_INFO,"Os_AlarmCheck expired %s(%d) cycletime (%d)\n", a_obj->name, a_obj->action.task_id, a_obj->cycletime);
+		/* Check if the alarms have expired */
+		logger_mod((LOGGER_MOD_LINOS|LOGGER_SUB_OS_ALARM), LOG_INFO,"Os_AlarmCheck expired %s(%d) cycletime (%d)\n", a_obj->name, a_obj->action.task_id, a_obj->cycletime);
 
-			switch( a_obj->action.type ) {
-				case ALARM_ACTION_ACTIVATETASK:
-					logger_mod((LOGGER_MOD_LINOS|LOGGER_SUB_OS_ALARM), LOG_INFO, "Os_AlarmCheck ActivateTask (%d)", a_obj->action.task_id);
-					if( ActivateTask(a_obj->action.task_id) != E_OK ) {
-						/* We actually do thing here, See 0S321 */
-					}
-					AlarmProcess(a_obj);
-					break;
-				case ALARM_ACTION_SETEVENT:
-					rv =  SetEvent(a_obj->action.task_id,a_obj->action.event_id);
-					if( rv != E_OK ) {
-						Os_CallErrorHook(rv);
-					}
-					AlarmProcess(a_obj);
-					break;
-				case ALARM_ACTION_ALARMCALLBACK:
-					/* IMPROVEMENT: not done */
-					break;
+		switch( a_obj->action.type ) {
+			case ALARM_ACTION_ACTIVATETASK:
+				logger_mod((LOGGER_MOD_LINOS|LOGGER_SUB_OS_ALARM), LOG_INFO, "Os_AlarmCheck ActivateTask (%d)", a_obj->action.task_id);
+				if( ActivateTask(a_obj->action.task_id) != E_OK ) {
+					/* We actually do thing here, See 0S321 */
+				}
+				break;
+			case ALARM_ACTION_SETEVENT:
+				rv =  SetEvent(a_obj->action.task_id,a_obj->action.event_id);
+				if( rv != E_OK ) {
+					Os_CallErrorHook(rv);
+				}
+				break;
+			case ALARM_ACTION_ALARMCALLBACK:
+				/* IMPROVEMENT: not done */
+				break;
 
-				case ALARM_ACTION_INCREMENTCOUNTER:
-					/** @req OS301 */
-					logger_mod((LOGGER_MOD_LINOS|LOGGER_SUB_OS_ALARM), LOG_INFO, "Os_AlarmCheck 			ALARM_ACTION_INCREMENTCOUNTER");
-					(void)IncrementCounter(a_obj->action.counter_id);
-					AlarmProcess(a_obj);
-					break;
-				default:
-					ASSERT(0);
-			}
+			case ALARM_ACTION_INCREMENTCOUNTER:
+				/** @req OS301 */
+				logger_mod((LOGGER_MOD_LINOS|LOGGER_SUB_OS_ALARM), LOG_INFO, "Os_AlarmCheck 			ALARM_ACTION_INCREMENTCOUNTER");
+				(void)IncrementCounter(a_obj->action.counter_id);
+				break;
+			default:
+				ASSERT(0);
+		}
+
+		/* A cancelled alarm is no longer in the due list */
+		if( LIST_FIRST(&due) == a_obj ) {
+			AlarmProcess(a_obj);
 		}
 	}
 }
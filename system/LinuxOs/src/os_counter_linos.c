@@ -67,6 +67,16 @@ StatusType IncrementCounter( CounterType counter_id ) {
  *  * Initialize alarms and schedule-tables for the counters
  *   */
 void Os_CounterInit( void ) {
+#if OS_COUNTER_CNT!=0
+        /* Empty alarm wheels, before any alarm can be inserted */
+        for (CounterType c = 0; c < OS_COUNTER_CNT; c++) {
+                OsCounterType *cPtr = Os_CounterGet(c);
+                for (uint32 slot = 0; slot < OS_ALARM_WHEEL_SIZE; slot++) {
+                        LIST_INIT(&cPtr->alarm_wheel[slot]);
+                }
+        }
+#endif
+
 #if OS_ALARM_CNT!=0
         {
                 OsCounterType *cPtr;
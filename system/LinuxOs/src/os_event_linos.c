@@ -17,18 +17,44 @@
 #define __USE_GNU
 #include <pthread.h>
 #include <time.h>
-#include <unistd.h> /* sleep */
+#include <unistd.h> /* sleep, syscall */
+#include <errno.h>
+#include <limits.h> /* INT_MAX */
+#include <sys/syscall.h>
+#include <linux/futex.h>
 #endif
 #include "linos_logger.h" /* Logger functions */
 #include "Os.h"
 #include <os_sys.h>  /* OS_SYS_PTR */
 #include <os_i.h>    /* GEN_TASK_HEAD  */
 #include "os_main.h"
+#include "strace.h"
 
 extern ThreadTaskType ThreadTasks[(OS_TASK_CNT+GNULINUX_TASK_CNT)]; /* Normal tasks and special GNULinux tasks. Declared in os_main.c  */
 
 extern int GetTaskId (void); /* Declared in os_task_linos.c */
 
+/* Events are kept lock free:
+ *
+ * EventState  The event bits, only changed with atomic or/and.
+ * WaitMask    The mask the task is blocked on in WaitEvent, 0 when not waiting.
+ * EventSeq    32 bit futex word, bumped by SetEvent before waking the waiter.
+ *
+ * SetEvent only enters the kernel when the task waits for one of the bits that
+ * was set. The waiter samples EventSeq before testing EventState, so a SetEvent
+ * that happens between the test and the futex wait changes EventSeq and the
+ * wait returns immediately. */
+#ifndef _WIN32
+static inline void event_futex_wait(uint32 *addr, uint32 val) {
+    /* EINTR and EAGAIN are fine, the caller re-checks the event state. */
+    (void)syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, val, NULL, NULL, 0);
+}
+
+static inline void event_futex_wake(uint32 *addr) {
+    (void)syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+}
+#endif
+
 StatusType WaitEvent ( EventMaskType Mask ) {
 
     unsigned int usecs;
@@ -50,15 +76,21 @@ StatusType WaitEvent ( EventMaskType Mask ) {
 
         start_ticks = OS_SYS_PTR->tick;
 
-        pthread_mutex_lock(&ThreadTasks[CurrentTaskId].mutex_lock);
-
+        ThreadTaskType *threadtask = &ThreadTasks[CurrentTaskId];
         int event_already_existed = 1;
-        while ((ThreadTasks[CurrentTaskId].EventState & Mask) == 0) {
+
+        __atomic_store_n(&threadtask->WaitMask, Mask, __ATOMIC_SEQ_CST);
+        STRACE(STRACE_EV_TASK_WAIT, (uint16)CurrentTaskId);
+        while (1) {
+            uint32 seq = __atomic_load_n(&threadtask->EventSeq, __ATOMIC_SEQ_CST);
+            if ((__atomic_load_n(&threadtask->EventState, __ATOMIC_SEQ_CST) & Mask) != 0) {
+                break;
+            }
             event_already_existed = 0;
-            pthread_cond_wait(&ThreadTasks[CurrentTaskId].cond, &ThreadTasks[CurrentTaskId].mutex_lock);
+            event_futex_wait(&threadtask->EventSeq, seq);
         }
-
-        pthread_mutex_unlock(&ThreadTasks[CurrentTaskId].mutex_lock);
+        __atomic_store_n(&threadtask->WaitMask, 0, __ATOMIC_SEQ_CST);
+        STRACE(STRACE_EV_TASK_RESUME, (uint16)CurrentTaskId);
 
         clock_gettime(CLOCK_REALTIME, &t_end); // Get current time.
         end_ticks = OS_SYS_PTR->tick;
@@ -93,11 +125,7 @@ StatusType GetEvent( TaskType TaskId, EventMaskRefType Mask){
             "Started GetEvent TaskId %s(%d) [0x%.8X] 32bits",
             ThreadTasks[TaskId].name, TaskId, *Mask);
 #ifndef _WIN32
-    pthread_mutex_lock(&ThreadTasks[TaskId].mutex_lock);
-
-    *Mask = ThreadTasks[TaskId].EventState;
-
-    pthread_mutex_unlock(&ThreadTasks[TaskId].mutex_lock);
+    *Mask = __atomic_load_n(&ThreadTasks[TaskId].EventState, __ATOMIC_SEQ_CST);
 #endif
     logger_mod((LOGGER_MOD_LINOS | LOGGER_SUB_OS_EVENT), LOG_INFO,
             "Finished GetEvent TaskId %s(%d) [0x%.8X] 32bits",
@@ -122,15 +150,9 @@ StatusType ClearEvent ( EventMaskType Mask ) {
                     "Started ClearEvent TaskId %s(%d),  Mask [0x%.8X] 32bits.",
                     ThreadTasks[CurrentTaskId].name, CurrentTaskId, Mask);
 #ifndef _WIN32
-        pthread_mutex_lock(&ThreadTasks[CurrentTaskId].mutex_lock);
-        EventMaskType OldMask = ThreadTasks[CurrentTaskId].EventState;
-
-        ThreadTasks[CurrentTaskId].EventState &= ~(Mask);
+        EventMaskType OldMask = __atomic_fetch_and(&ThreadTasks[CurrentTaskId].EventState, ~(Mask), __ATOMIC_SEQ_CST);
 
-        /* Get the newMask to avoid locking the EventState while locking. */
-        EventMaskType newMask = ThreadTasks[CurrentTaskId].EventState;
-
-        pthread_mutex_unlock(&ThreadTasks[CurrentTaskId].mutex_lock);
+        EventMaskType newMask = OldMask & ~(Mask);
 
 
         if ( OldMask == newMask)
@@ -160,13 +182,13 @@ StatusType SetEvent( TaskType TaskId, EventMaskType Mask ){
             "Started SetEvent TaskId %s(%d),  Mask [0x%.8X] 32bits.",
             ThreadTasks[TaskId].name, TaskId, Mask);
 
-    pthread_mutex_lock(&ThreadTasks[TaskId].mutex_lock);
-
-    ThreadTasks[TaskId].EventState |= Mask;
+    (void)__atomic_fetch_or(&ThreadTasks[TaskId].EventState, Mask, __ATOMIC_SEQ_CST);
 
-    /* Notify the waiting thread (WaitEvent) */
-    pthread_cond_signal(&ThreadTasks[TaskId].cond);
-    pthread_mutex_unlock(&ThreadTasks[TaskId].mutex_lock);
+    /* Notify the waiting thread (WaitEvent), only if it waits for any of the bits */
+    if ((__atomic_load_n(&ThreadTasks[TaskId].WaitMask, __ATOMIC_SEQ_CST) & Mask) != 0) {
+        (void)__atomic_fetch_add(&ThreadTasks[TaskId].EventSeq, 1, __ATOMIC_SEQ_CST);
+        event_futex_wake(&ThreadTasks[TaskId].EventSeq);
+    }
 
     logger_mod((LOGGER_MOD_LINOS | LOGGER_SUB_OS_EVENT), LOG_INFO,
             "Finished SetEvent TaskId %s(%d),  Mask [0x%.8X] 32bits.",
@@ -34,6 +34,10 @@ void InitOS( void ) {
 
     logger(LOG_INFO, "InitOS called.\n");
 
+    for( i = 0; i < OS_READY_PRIO_CNT; i++ ) {
+        TAILQ_INIT(& (OS_SYS_PTR->ready_head[i]));
+    }
+
 #if OS_COUNTER_CNT!=0
                 Os_CounterInit();
 #endif
@@ -58,6 +62,7 @@ void InitOS( void ) {
                     ThreadTasks[i].entry = tmpPcbPtr->constPtr->entry;
                     ThreadTasks[i].name = tmpPcbPtr->constPtr->name;
                     ThreadTasks[i].prio = tmpPcbPtr->activePriority;
+                    ThreadTasks[i].stack_size = tmpPcbPtr->constPtr->stack.size;
                     ThreadTasks[i].autostart = tmpPcbPtr->constPtr->autostart;
                     //
 
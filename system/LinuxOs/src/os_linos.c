@@ -85,6 +85,7 @@ StatusType SetAbsAlarm(AlarmType AlarmId, TickType Start, TickType Cycle) {
 
         aPtr->expire_val = Start;
         aPtr->cycletime = Cycle;
+        Os_AlarmWheelInsert(aPtr);
 
         Irq_Restore(flags);
 
@@ -171,6 +172,7 @@ StatusType SetRelAlarm(AlarmType AlarmId, TickType Increment, TickType Cycle){
                                                                 COUNTER_MAX(aPtr),
                                                                 Increment);
                 aPtr->cycletime = Cycle;
+                Os_AlarmWheelInsert(aPtr);
 
                 Irq_Restore(flags);
                 OS_DEBUG(D_ALARM,"  expire:%u cycle:%u\n",
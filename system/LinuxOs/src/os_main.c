@@ -13,6 +13,11 @@
  * <http://www.gnu.org/licenses/old-licenses/gpl-2.0.txt>
  *-------------------------------- Arctic Core -----------------------------*/
 
+#ifndef _WIN32
+/* Not POSIX, needed for CPU_SET and pthread_attr_setaffinity_np */
+#define _GNU_SOURCE
+#endif
+
 #include <stdio.h>
 
 #include <setjmp.h>
@@ -23,6 +28,11 @@
 #include <errno.h>
 #include <signal.h>
 #include <fcntl.h>  /* open */
+#include <poll.h>
+#include <sched.h>  /* SCHED_FIFO */
+#include <sys/mman.h> /* mlockall */
+#include <sys/socket.h>
+#include <sys/un.h> /* Virtual time step socket */
 #include <asm/param.h> /* HZ */
 #endif
 
@@ -40,8 +50,10 @@
 #include <os_sys.h>  /* OS_SYS_PTR */
 
 #include "LinuxOs_StbM.h"
+#include "LinuxOs_Timer.h"
 
 #include "os_main.h"
+#include "strace.h"
 
 #if defined(USE_LINOS_DB) && !defined(_WIN32)
   #include "database.h"
@@ -85,13 +97,30 @@ char pid_file_name[64]; // /var/run/X.pid
 
 char bit_event_file_name[64]; // File to store the event bit signal in.
 
+char vtime_socket_name[64]; // Socket for virtual time step commands.
+
 #if defined(USE_LINOS_DB)
 char db_file_name[64];
 #endif
 
+#if defined(USE_STRACE)
+char strace_file_name[64]; // System trace written at shutdown, see scripts/strace_convert.py
+#endif
+
 /*     */
 int stop_at_runtime = 0;
 
+int rt_sched = 0; /* Run the task threads with SCHED_FIFO */
+
+int lock_memory = 0; /* mlockall() at start-up */
+int async_logging = 0; /* logger() only queues, a logger thread writes */
+
+uint32 default_cpu_mask = 0; /* CPU affinity for threads without their own mask. 0 = any */
+
+/* -a <task name>:<cpumask> options, applied after InitOS() has named the tasks */
+static char *affinity_args[LINOS_AFFINITY_ARG_MAX];
+static int affinity_arg_cnt = 0;
+
 extern void EcuM_Init(void);
 
 /*
@@ -127,44 +156,282 @@ struct timespec timesdiff(struct timespec *start, struct timespec *end) {
 }
 #endif
 
+/* Maximum number of overdue ticks released in one wake-up. If the timer thread
+ * was stalled for longer than this (e.g. process stopped in a debugger) the
+ * deadline is re-synchronised to now and the remaining ticks are dropped. */
+#define GNULINUX_TIMER_MAX_CATCHUP_TICKS(_period_ns)  ((uint32)(NSEC_PER_SEC / (_period_ns)))
+
+static Linos_TimerStatsType Linos_TimerStats;
+
+void Linos_GetTimerStats(Linos_TimerStatsType *stats) {
+    *stats = Linos_TimerStats;
+}
+
+void Linos_GetTaskStats(uint32 taskId, Linos_TaskStatsType *stats) {
+    if (taskId < OS_TASK_CNT) {
+        *stats = ThreadTasks[taskId].stats;
+    } else {
+        memset(stats, 0, sizeof(*stats));
+    }
+}
+
+static void linos_hist_add(Linos_HistType *hist, uint32 ns) {
+    uint32 us = ns / 1000u;
+    uint32 idx = 0;
+
+    while ((us != 0) && (idx < (LINOS_HIST_BUCKETS - 1u))) {
+        us >>= 1;
+        idx++;
+    }
+    hist->bucket[idx]++;
+    hist->sum_ns += ns;
+    if (ns > hist->max_ns) {
+        hist->max_ns = ns;
+    }
+}
+
+uint32 Linos_HistPercentile_us(const Linos_HistType *hist, uint32 permille) {
+    uint64 total = 0;
+    uint64 acc = 0;
+    uint32 i;
+
+    for (i = 0; i < LINOS_HIST_BUCKETS; i++) {
+        total += hist->bucket[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+    for (i = 0; i < LINOS_HIST_BUCKETS; i++) {
+        acc += hist->bucket[i];
+        if ((acc * 1000u) >= (total * permille)) {
+            break;
+        }
+    }
+    if (i >= (LINOS_HIST_BUCKETS - 1u)) {
+        return 0xFFFFFFFFUL;
+    }
+    return (1uL << i);
+}
+
+#ifndef _WIN32
+/* Nanoseconds from "from" to "to", saturated to 32 bits (~4 s) */
+static uint32 timesdiff_ns(struct timespec *from, struct timespec *to) {
+    struct timespec t_diff = timesdiff(from, to);
+
+    if (t_diff.tv_sec < 0) {
+        return 0;
+    }
+    if (t_diff.tv_sec >= 4) {
+        return 0xFFFFFFFFUL;
+    }
+    return (uint32)((t_diff.tv_sec * NSEC_PER_SEC) + t_diff.tv_nsec);
+}
+#endif
+
+#ifndef _WIN32
+/* A task is idle in virtual time when it is not activated, or when it is blocked
+ * in WaitEvent and none of the events it waits for are set. */
+static boolean vtime_tasks_idle(void) {
+    int i;
+    uint8 status;
+    EventMaskType waitMask;
+
+    for (i = 0; i < OS_TASK_CNT; i++) {
+        if (i == TASK_ID_OsIdle) {
+            continue; /* Never runs on LinuxOs */
+        }
+        status = __atomic_load_n(&ThreadTasks[i].pthread_status, __ATOMIC_ACQUIRE);
+        if (status == GNULINUX_PTHREAD_STARTING) {
+            return FALSE;
+        }
+        if (status == GNULINUX_PTHREAD_FUNCTION_STARTED) {
+            waitMask = __atomic_load_n(&ThreadTasks[i].WaitMask, __ATOMIC_SEQ_CST);
+            if ((waitMask == 0) ||
+                ((__atomic_load_n(&ThreadTasks[i].EventState, __ATOMIC_SEQ_CST) & waitMask) != 0)) {
+                return FALSE;
+            }
+        }
+    }
+    return TRUE;
+}
+
+/* One virtual tick. Waits until the tasks released by the previous tick are idle.
+ * Tasks that block outside the OS (sockets, sleep) are never idle, so after
+ * LINOS_VTIME_IDLE_TIMEOUT_MS of real time the tick is given anyway.
+ * The wait sleeps instead of yielding, with -R the timer thread has the highest
+ * SCHED_FIFO priority and sched_yield() would not let lower priority tasks run. */
+static void vtime_tick(uint32 period_ns) {
+    const struct timespec poll = { 0, LINOS_VTIME_IDLE_POLL_NS };
+    struct timespec t_start, t_now, t_diff;
+
+    clock_gettime(CLOCK_MONOTONIC, &t_start);
+    while (!vtime_tasks_idle()) {
+        clock_gettime(CLOCK_MONOTONIC, &t_now);
+        t_diff = timesdiff(&t_start, &t_now);
+        if (((t_diff.tv_sec * 1000) + (t_diff.tv_nsec / 1000000)) >= LINOS_VTIME_IDLE_TIMEOUT_MS) {
+            Linos_TimerStats.overrunCnt++;
+            break;
+        }
+        (void)nanosleep(&poll, NULL);
+    }
+
+    Linos_VirtualTimeAdvance(period_ns);
+    IncrementCounter(0);
+    Linos_TimerStats.tickCnt++;
+}
+
+/* Serve step commands on a local stream socket, one client at a time.
+ *   "step <n>"  Run n ticks, answers "ok <tick>"
+ *   "tick"      Answers "ok <tick>" without running
+ */
+static void vtime_step_server(uint32 period_ns) {
+    struct sockaddr_un addr;
+    char line[64];
+    FILE *fp;
+    int srv;
+    int cli;
+    unsigned long n;
+
+    srv = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (srv < 0) {
+        handle_error("vtime socket");
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, vtime_socket_name, sizeof(addr.sun_path) - 1);
+    unlink(vtime_socket_name);
+    if ((bind(srv, (struct sockaddr *)&addr, sizeof(addr)) != 0) || (listen(srv, 1) != 0)) {
+        handle_error("vtime bind");
+    }
+    logger(LOG_INFO, "Virtual time, waiting for step commands on %s", vtime_socket_name);
+
+    while (1) {
+        cli = accept(srv, NULL, NULL);
+        if (cli < 0) {
+            continue;
+        }
+        fp = fdopen(cli, "r+");
+        if (fp == NULL) {
+            close(cli);
+            continue;
+        }
+        while (fgets(line, sizeof(line), fp) != NULL) {
+            if (strncmp(line, "step", 4) == 0) {
+                n = strtoul(&line[4], (char **) NULL, 0);
+                while (n > 0) {
+                    vtime_tick(period_ns);
+                    n--;
+                }
+            } else if (strncmp(line, "tick", 4) != 0) {
+                fprintf(fp, "error\n");
+                fflush(fp);
+                continue;
+            }
+            fprintf(fp, "ok %u\n", (unsigned)OS_SYS_PTR->tick);
+            fflush(fp);
+        }
+        fclose(fp);
+    }
+}
+
+/* gnulinux_timer in virtual time, the tick does not depend on the wall clock. */
+static void gnulinux_virtual_timer(void) {
+    uint32 period_ns = (uint32)(NSEC_PER_SEC / OsTickFreq);
+
+    Linos_TimerStats.tickPeriod_ns = period_ns;
+
+    if (Linos_VirtualTimeMode == LINOS_VTIME_STEP) {
+        vtime_step_server(period_ns);
+    }
+    while (1) {
+        vtime_tick(period_ns);
+    }
+}
+#endif
+
 /*
  *
  *
  *  gnulinux_timer (Runs in seperate thread)
  *
- *  Increment the counter OsTickFreq times per second. Max 1000Hz (1ms) ??
+ *  Increment the counter OsTickFreq times per second.
+ *
+ *  Sleeps until an absolute deadline (TIMER_ABSTIME) that is advanced with
+ *  exactly one tick period per tick, so the processing time of
+ *  IncrementCounter() does not accumulate as drift. If the thread wakes up
+ *  after more than one deadline has passed the overdue ticks are released
+ *  back-to-back (catch up) and counted as missed.
  *
- *  This sleeps different amounts of time to ensure accuracy.
+ *  Tick rates above 1000Hz are supported, the period is kept in ns.
  *
+ *  In virtual time (-V, -S) the tick is instead driven by task idleness or
+ *  step commands, see gnulinux_virtual_timer().
  *
 */
 
 void gnulinux_timer(void) {
 #ifndef _WIN32
-    unsigned int msec = (1000/OsTickFreq); /* How long to wait for every tick */
-    unsigned int usecs = msec * 1000; /* Wait time in microseconds */
+    uint32 period_ns = (uint32)(NSEC_PER_SEC / OsTickFreq); /* How long to wait for every tick */
+    uint32 max_catchup = GNULINUX_TIMER_MAX_CATCHUP_TICKS(period_ns);
+    uint32 due;
+    uint32 late_ns;
+    struct timespec deadline;
+    struct timespec now;
+    int rv;
+
+    if (Linos_VirtualTimeMode != LINOS_VTIME_OFF) {
+        gnulinux_virtual_timer(); /* Will never return */
+    }
 
-    struct timespec t;
-    t.tv_sec = 0;
-    t.tv_nsec = (usecs * 1000);
+    Linos_TimerStats.tickPeriod_ns = period_ns;
 
-    struct timespec r;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
 
     while(1) {
-        while (clock_nanosleep(CLOCK_MONOTONIC, 0, &t, &r) != 0) {
-            if (errno == EINTR) {
-                t.tv_sec = r.tv_sec;
-                t.tv_nsec = r.tv_nsec;
-            } else {
+        deadline.tv_nsec += period_ns;
+        tsnorm(&deadline);
+
+        /* EINTR only means a signal handler ran, just sleep again towards the same deadline. */
+        while ((rv = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL)) != 0) {
+            if (rv != EINTR) {
                 /* Exiting on permanent errors. */
                 logger(LOG_ERR, "vECU exiting on gnulinux_timer permanent sleep error.");
                 // Improvement: do cleanup
                 exit(1);
             }
         }
-        IncrementCounter(0);
-        t.tv_sec = 0;
-        t.tv_nsec = (usecs * 1000);
+
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        late_ns = timesdiff_ns(&deadline, &now);
+
+        Linos_TimerStats.lateLast_ns = late_ns;
+        Linos_TimerStats.lateSum_ns += late_ns;
+        if (late_ns > Linos_TimerStats.lateMax_ns) {
+            Linos_TimerStats.lateMax_ns = late_ns;
+        }
+
+        /* The tick for this deadline plus every further deadline that has already passed */
+        due = 1u + (late_ns / period_ns);
+        if (due > 1u) {
+            Linos_TimerStats.overrunCnt++;
+            if (due > max_catchup) {
+                /* Stalled, release one tick and start over from now. */
+                Linos_TimerStats.droppedTickCnt += (due - 1u);
+                deadline = now;
+                due = 1u;
+            } else {
+                Linos_TimerStats.missedTickCnt += (due - 1u);
+                /* The last released tick owns the last passed deadline */
+                deadline.tv_nsec += (long)(due - 1u) * period_ns;
+                tsnorm(&deadline);
+            }
+        }
+
+        while (due > 0u) {
+            IncrementCounter(0);
+            Linos_TimerStats.tickCnt++;
+            due--;
+        }
     }
 #endif
 }
@@ -245,10 +512,11 @@ void disable_gnulinux_pmc_sync_status_reader() {
 
 /* All tasks will get to this function at least once.
  *
- * If Alarm type is "ALARM_ACTION_ACTIVATETASK" the thread will spin in this
- * loop until "pthread_status" get changed to GNULINUX_PTHREAD_FUNCTION_STARTED.
- * Mutex is required as "gnulinux_timer" thread will change the "pthread_status" to
- * "GNULINUX_PTHREAD_FUNCTION_STARTED" which means we need to protect the read.
+ * If Alarm type is "ALARM_ACTION_ACTIVATETASK" the thread will block on
+ * "activate_cond" until "pthread_status" get changed to GNULINUX_PTHREAD_FUNCTION_STARTED.
+ * start_thread() changes the status and signals "activate_cond" under "mutex_lock",
+ * so the task is released as soon as the activating thread (e.g. gnulinux_timer)
+ * unlocks the mutex instead of on the next poll.
  *
  * If Alarm type is "ALARM_ACTION_SETEVENT" the thread will jump to the function pointed to
  * by "entry()" and it will never return. The generated Rte implements the loop that handles
@@ -264,17 +532,50 @@ void TaskWrapper(ThreadTaskType *threadtask) {
     }
 
     while(1) {
+#ifndef _WIN32
+        struct timespec t_release, t_start, t_end, cpu_start, cpu_end;
+        uint32 latency_ns;
+
         pthread_mutex_lock(&threadtask->mutex_lock);
-        int thread_is_started = (threadtask->pthread_status == GNULINUX_PTHREAD_FUNCTION_STARTED);
+        while (threadtask->pthread_status != GNULINUX_PTHREAD_FUNCTION_STARTED) {
+            pthread_cond_wait(&threadtask->activate_cond, &threadtask->mutex_lock);
+        }
+        t_release = threadtask->activate_time;
         pthread_mutex_unlock(&threadtask->mutex_lock);
-        if (thread_is_started) {
-#ifndef _WIN32
-        	threadtask->entry(); /* Call the function defined in the task entry */
-#endif
-        } else {
-            //logger(LOG_INFO, "TaskWrapper waiting to re-activate task");
-            usleep(1000); /* Sleep 1 ms */
+
+        clock_gettime(CLOCK_MONOTONIC, &t_start);
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu_start);
+        latency_ns = timesdiff_ns(&t_release, &t_start);
+
+        /* Only the task itself writes the latency counters and the histograms. */
+        if (threadtask->activate_cnt != 0) {
+            linos_hist_add(&threadtask->stats.jitter,
+                    (latency_ns > threadtask->activate_latency_last_ns) ?
+                        (latency_ns - threadtask->activate_latency_last_ns) :
+                        (threadtask->activate_latency_last_ns - latency_ns));
         }
+        threadtask->stats.activateCnt++;
+        threadtask->activate_cnt++;
+        threadtask->activate_latency_last_ns = latency_ns;
+        threadtask->activate_latency_sum_ns += latency_ns;
+        if (latency_ns > threadtask->activate_latency_max_ns) {
+            threadtask->activate_latency_max_ns = latency_ns;
+            logger_mod((LOGGER_MOD_LINOS|LOGGER_SUB_OS_TASK), LOG_DEBUG,
+                    "Task %s new max activation latency %u us.",
+                    threadtask->name, (latency_ns / 1000));
+        }
+
+        STRACE(STRACE_EV_TASK_START, (uint16)threadtask->pid);
+        threadtask->entry(); /* Call the function defined in the task entry */
+        STRACE(STRACE_EV_TASK_STOP, (uint16)threadtask->pid);
+
+        /* Back here after TerminateTask() */
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu_end);
+        clock_gettime(CLOCK_MONOTONIC, &t_end);
+        linos_hist_add(&threadtask->stats.response, timesdiff_ns(&t_release, &t_end));
+        linos_hist_add(&threadtask->stats.exec, timesdiff_ns(&cpu_start, &cpu_end));
+        threadtask->stats.completeCnt++;
+#endif
     }
 }
 
@@ -358,6 +659,66 @@ int callback_print_runtime (char *reg_type, int argc, char **argv, char **azColN
     }
     return 0;
 }
+
+static void db_hist_to_regs(const Linos_HistType *hist, uint32 *regs) {
+    uint32 i;
+    for (i = 0; i < LINOS_HIST_BUCKETS; i++) {
+        regs[i] = hist->bucket[i];
+    }
+}
+
+/* Write the task timing statistics, only the registers that changed since the last call.
+ * Up to DB_TASK_STATS_REG_CNT registers per task, so each task is written out
+ * on its own instead of filling the write-behind buffer of the other callers. */
+static void db_write_task_stats(void) {
+    static uint32 last[OS_TASK_CNT][DB_TASK_STATS_REG_CNT];
+    static boolean written = FALSE;
+    uint32 regs[DB_TASK_STATS_REG_CNT];
+    Linos_TaskStatsType stats;
+    int i;
+    int r;
+    int queued;
+
+    for (i = 0; i < OS_TASK_CNT; i++) {
+        if (i == TASK_ID_OsIdle) {
+            continue; /* Never runs on LinuxOs */
+        }
+        Linos_GetTaskStats(i, &stats);
+        memset(regs, 0, sizeof(regs));
+        regs[DB_TASK_STATS_ACTIVATE] = stats.activateCnt;
+        regs[DB_TASK_STATS_COMPLETE] = stats.completeCnt;
+        regs[DB_TASK_STATS_DEADLINE_MISS] = stats.deadlineMissCnt;
+        if (stats.completeCnt != 0) {
+            regs[DB_TASK_STATS_RESPONSE_AVG] = (uint32)((stats.response.sum_ns / stats.completeCnt) / 1000u);
+            regs[DB_TASK_STATS_EXEC_AVG] = (uint32)((stats.exec.sum_ns / stats.completeCnt) / 1000u);
+        }
+        regs[DB_TASK_STATS_RESPONSE_MAX] = stats.response.max_ns / 1000u;
+        regs[DB_TASK_STATS_JITTER_MAX] = stats.jitter.max_ns / 1000u;
+        regs[DB_TASK_STATS_EXEC_MAX] = stats.exec.max_ns / 1000u;
+        db_hist_to_regs(&stats.response, &regs[DB_TASK_STATS_RESPONSE_HIST]);
+        db_hist_to_regs(&stats.jitter, &regs[DB_TASK_STATS_JITTER_HIST]);
+        db_hist_to_regs(&stats.exec, &regs[DB_TASK_STATS_EXEC_HIST]);
+
+        queued = 0;
+        for (r = 0; r < (DB_TASK_STATS_EXEC_HIST + (int)LINOS_HIST_BUCKETS); r++) {
+            if (written && (regs[r] == last[i][r])) {
+                continue;
+            }
+            if (db_set_register(DB_TASK_STATS_REG_ADDRESS + (i * DB_TASK_STATS_REG_CNT) + r,
+                    (int)regs[r], DB_CREATE_MISSING_WRITE, 1, 0) != DB_OK) { // force_write, read only
+                logger(LOG_ERR, "DB_TASK_STATS Problems saving task %s statistics to DB.", ThreadTasks[i].name);
+                return;
+            }
+            last[i][r] = regs[r];
+            queued++;
+        }
+        if ((queued != 0) && (db_flush() != DB_OK)) {
+            logger(LOG_ERR, "DB_TASK_STATS Problems saving task %s statistics to DB.", ThreadTasks[i].name);
+            return;
+        }
+    }
+    written = TRUE;
+}
 #endif
 
 static void usage() {
@@ -377,6 +738,12 @@ static void usage() {
     printf("-l loops (999 = infinite).\n");
     printf("-m <BITMASK> to set the debug mask. Only three digit hex, e.g. 0xFFF. See logger.h\n");
     printf("-r stop at runtime. For test.\n");
+    printf("-R run tasks with SCHED_FIFO, priorities mapped from the OS config. Needs CAP_SYS_NICE.\n");
+    printf("-L lock all memory (mlockall) to avoid page faults in the tasks.\n");
+    printf("-A asynchronous logging, messages are formatted and written by a logger thread.\n");
+    printf("-V virtual time, tick as soon as all tasks are idle.\n");
+    printf("-S virtual time, tick on \"step <n>\" commands on socket %s\n", vtime_socket_name);
+    printf("-a [<task name>:]<cpumask> pin a task, or all tasks if no name is given, to cores, e.g. -a 0x2.\n");
 }
 
 
@@ -387,8 +754,20 @@ int settings(int argc, char **argv ) {
     opterr = 0;
 #endif
         // See usage() function above
-    while ((c = getopt (argc, argv, "bfhl:m:rt")) != -1) {
+    while ((c = getopt (argc, argv, "Aa:bfhl:Lm:rRStV")) != -1) {
         switch (c) {
+            case 'a':
+#ifndef _WIN32
+                if (strchr(optarg, ':') == NULL) {
+                    default_cpu_mask = strtoul(optarg, (char **) NULL, 16);
+                } else if (affinity_arg_cnt < LINOS_AFFINITY_ARG_MAX) {
+                    affinity_args[affinity_arg_cnt++] = optarg;
+                } else {
+                    fprintf(stderr, "Too many -a options, max %d.\n", LINOS_AFFINITY_ARG_MAX);
+                }
+#endif
+                break;
+
             case 'b':
 #if defined(USE_TCPIP)
                 gnulinuxTcpBindAny = TRUE;
@@ -428,6 +807,26 @@ int settings(int argc, char **argv ) {
                 stop_at_runtime = 1;
                 break;
 
+            case 'R':
+                rt_sched = 1;
+                break;
+
+            case 'L':
+                lock_memory = 1;
+                break;
+
+            case 'A':
+                async_logging = 1;
+                break;
+
+            case 'V':
+                Linos_VirtualTimeMode = LINOS_VTIME_FREE;
+                break;
+
+            case 'S':
+                Linos_VirtualTimeMode = LINOS_VTIME_STEP;
+                break;
+
 
             case 't':
                 EcuM_Init();
@@ -437,7 +836,7 @@ int settings(int argc, char **argv ) {
 
             case '?':
 #ifndef _WIN32
-                if ((optopt == 'l')||(optopt == 'm')||(optopt == 'e')) {
+                if ((optopt == 'a')||(optopt == 'l')||(optopt == 'm')||(optopt == 'e')) {
                     fprintf(stderr, "Option -%c requires an argument.\n", optopt);
                 }
                 else if (isprint (optopt)) {
@@ -468,12 +867,26 @@ static void close_sigint(int exit_code) {
     //logger(LOG_INFO, "Killing threads."); // IMPROVEMENT SimonG
     // pthread_cancel
     disable_gnulinux_pmc_sync_status_reader(); // Read Design note inside this method.
+#ifndef _WIN32
+    logger_async_stop(); /* Write queued messages */
+#endif
 
 #if defined(USE_LINOS_DB) && !defined(_WIN32)
     db_close();
 #endif
 
+#if defined(USE_STRACE)
+    if (strace_dump(strace_file_name) == 0) {
+        logger(LOG_INFO, "System trace written to %s", strace_file_name);
+    } else {
+        logger(LOG_ERR, "Failed to write system trace to %s", strace_file_name);
+    }
+#endif
+
     unlink(pid_file_name);
+    if (Linos_VirtualTimeMode == LINOS_VTIME_STEP) {
+        unlink(vtime_socket_name);
+    }
 
     logger(LOG_INFO, "Done!");
 #ifdef USE_SYSLOG
@@ -511,23 +924,169 @@ void read_event_file(void) {
 }
 
 
-void signal_handler(int sig) {
 #ifndef _WIN32
+/* The handler only records the signal and wakes the main loop through the
+ * pipe, the shutdown and the event file are handled by handle_signals(). */
+static volatile sig_atomic_t signal_hup;
+static volatile sig_atomic_t signal_stop;
+static volatile sig_atomic_t signal_other;
+static int signal_pipe[2] = { -1, -1 };
+
+void signal_handler(int sig) {
+    int saved_errno = errno;
+
     switch(sig) {
         case SIGHUP:
-            read_event_file();
+            signal_hup = 1;
             break;
 
         case SIGTERM:
         case SIGINT:
-            close_sigint(0);
+            signal_stop = 1;
             break;
 
         default:
-            logger(LOG_ERR, "Unknown signal (%d) %s ignored.", sig, strsignal(sig));
+            signal_other = sig;
+    }
+    if (signal_pipe[1] >= 0) {
+        (void)write(signal_pipe[1], "s", 1);
+    }
+    errno = saved_errno;
+}
+
+/* Sleeps up to timeout_s in the main loop, returns early on a signal */
+static void wait_signals(int timeout_s) {
+    struct pollfd pfd = { signal_pipe[0], POLLIN, 0 };
+    char buf[16];
+
+    if (signal_pipe[0] < 0) {
+        sleep(timeout_s);
+        return;
     }
+    if (poll(&pfd, 1, timeout_s * 1000) > 0) {
+        while (read(signal_pipe[0], buf, sizeof(buf)) > 0) {
+            /* Drain, the flags tell what happened */
+        }
+    }
+}
+
+/* Returns 1 when the main loop shall shut down */
+static int handle_signals(void) {
+    int sig;
+
+    if (signal_hup) {
+        signal_hup = 0;
+        read_event_file();
+    }
+    sig = signal_other;
+    if (sig != 0) {
+        signal_other = 0;
+        logger(LOG_ERR, "Unknown signal (%d) %s ignored.", sig, strsignal(sig));
+    }
+    return (signal_stop != 0);
+}
 #endif
+
+#ifndef _WIN32
+/* Apply the -a <task name>:<cpumask> options. Called when the task names are known. */
+static void apply_affinity_args(void) {
+    int i;
+    int t;
+    char *sep;
+
+    for (i = 0; i < (OS_TASK_CNT+GNULINUX_TASK_CNT); i++) {
+        ThreadTasks[i].cpu_mask = default_cpu_mask;
+    }
+
+    for (i = 0; i < affinity_arg_cnt; i++) {
+        sep = strchr(affinity_args[i], ':');
+        for (t = 0; t < (OS_TASK_CNT+GNULINUX_TASK_CNT); t++) {
+            if ((ThreadTasks[t].name != NULL) &&
+                (strlen(ThreadTasks[t].name) == (size_t)(sep - affinity_args[i])) &&
+                (strncmp(ThreadTasks[t].name, affinity_args[i], (size_t)(sep - affinity_args[i])) == 0)) {
+                ThreadTasks[t].cpu_mask = strtoul(sep + 1, (char **) NULL, 16);
+                break;
+            }
+        }
+        if (t == (OS_TASK_CNT+GNULINUX_TASK_CNT)) {
+            logger(LOG_ERR, "Affinity option %s does not match any task.", affinity_args[i]);
+        }
+    }
+}
+
+/* Map an OS task priority to a SCHED_FIFO priority.
+ *
+ * The OS priorities are used as an offset from the lowest FIFO priority so
+ * the relative order between tasks is kept. The highest FIFO priority is
+ * reserved for the thread that drives the OS tick. */
+static int map_fifo_priority( int threadId ) {
+    int prio_min = sched_get_priority_min(SCHED_FIFO);
+    int prio_max = sched_get_priority_max(SCHED_FIFO);
+    int prio;
+
+    if (threadId == TASK_ID_GNULINUX_timer) {
+        return prio_max;
+    }
+
+    prio = prio_min + (int)ThreadTasks[threadId].prio;
+    if (prio > (prio_max - 1)) {
+        logger(LOG_ERR, "Task %s priority %d does not fit SCHED_FIFO, using %d.",
+                ThreadTasks[threadId].name, ThreadTasks[threadId].prio, (prio_max - 1));
+        prio = prio_max - 1;
+    }
+    return prio;
+}
+
+/* Set stack size, scheduling policy and affinity of a task thread. */
+static void set_thread_attr( pthread_attr_t *attr, int threadId ) {
+    int err;
+    size_t stack_size;
+    struct sched_param param;
+    cpu_set_t cpus;
+    int cpu;
+
+    if (ThreadTasks[threadId].stack_size > 0) {
+        stack_size = ThreadTasks[threadId].stack_size;
+        if (stack_size < LINOS_TASK_STACK_SIZE_MIN) {
+            stack_size = LINOS_TASK_STACK_SIZE_MIN;
+        }
+        err = pthread_attr_setstacksize(attr, stack_size);
+        if (err != 0) {
+            handle_error_en(err, "pthread_attr_setstacksize");
+        }
+    }
+
+    if (rt_sched) {
+        err = pthread_attr_setinheritsched(attr, PTHREAD_EXPLICIT_SCHED);
+        if (err != 0) {
+            handle_error_en(err, "pthread_attr_setinheritsched");
+        }
+        err = pthread_attr_setschedpolicy(attr, SCHED_FIFO);
+        if (err != 0) {
+            handle_error_en(err, "pthread_attr_setschedpolicy");
+        }
+        param.sched_priority = map_fifo_priority(threadId);
+        err = pthread_attr_setschedparam(attr, &param);
+        if (err != 0) {
+            handle_error_en(err, "pthread_attr_setschedparam");
+        }
+    }
+
+    if (ThreadTasks[threadId].cpu_mask != 0) {
+        CPU_ZERO(&cpus);
+        for (cpu = 0; cpu < 32; cpu++) {
+            if (ThreadTasks[threadId].cpu_mask & (1UL << cpu)) {
+                CPU_SET(cpu, &cpus);
+            }
+        }
+        /* Not POSIX */
+        err = pthread_attr_setaffinity_np(attr, sizeof(cpus), &cpus);
+        if (err != 0) {
+            handle_error_en(err, "pthread_attr_setaffinity_np");
+        }
+    }
 }
+#endif
 
 /* Shorten the task name to fit the Linux thread name limits of 15 characters.
  * See the documentation of pthread_setname_np.*/
@@ -566,12 +1125,16 @@ int start_thread( int threadId ) {
     int thread_is_terminated = (ThreadTasks[threadId].pthread_status == GNULINUX_PTHREAD_FUNCTION_TERMINATED);
     if (thread_is_terminated) {
     	ThreadTasks[threadId].pthread_status = GNULINUX_PTHREAD_FUNCTION_STARTED;
+        clock_gettime(CLOCK_MONOTONIC, &ThreadTasks[threadId].activate_time);
+        /* Wake up the thread blocked in TaskWrapper */
+        pthread_cond_signal(&ThreadTasks[threadId].activate_cond);
     }
     pthread_mutex_unlock(&ThreadTasks[threadId].mutex_lock);
 
     if (thread_is_terminated)
     {
     	err = E_OK;
+        STRACE(STRACE_EV_TASK_ACTIVATE, (uint16)threadId);
         logger_mod((LOGGER_MOD_LINOS | LOGGER_SUB_OS_TASK), LOG_DEBUG,
                     "Restarting a terminated task (%s).",
                     ThreadTasks[threadId].name);
@@ -584,9 +1147,15 @@ int start_thread( int threadId ) {
     /* We can not re-create a task that is not empty and passed the above check. */
     pthread_mutex_lock(&ThreadTasks[threadId].mutex_lock);
 	int thread_is_empty = (ThreadTasks[threadId].pthread_status == GNULINUX_PTHREAD_EMPTY);
+	int thread_is_running = (ThreadTasks[threadId].pthread_status == GNULINUX_PTHREAD_FUNCTION_STARTED);
 	pthread_mutex_unlock(&ThreadTasks[threadId].mutex_lock);
     if (!thread_is_empty) {
         err = E_NOT_OK;
+        if (thread_is_running) {
+            /* Released again before the previous activation terminated,
+             * the implicit deadline (next release) is missed. */
+            __atomic_add_fetch(&ThreadTasks[threadId].stats.deadlineMissCnt, 1, __ATOMIC_RELAXED);
+        }
         /* This is a thread that has not terminated OR never started.
          * We do not log anything here to avoid noise in the logs. */
         return err;
@@ -598,6 +1167,7 @@ int start_thread( int threadId ) {
      * that will try to read or write pthread_status.
      */
     ThreadTasks[threadId].pthread_status = GNULINUX_PTHREAD_STARTING;
+    clock_gettime(CLOCK_MONOTONIC, &ThreadTasks[threadId].activate_time);
 
     /* Initialize thread creation attributes */
 
@@ -606,17 +1176,17 @@ int start_thread( int threadId ) {
         handle_error_en(err, "pthread_attr_init");
     }
 
-// IMPROVEMENT Set prio, affinity etc.
-//        if (stack_size > 0) {
-//            err = pthread_attr_setstacksize(&attr, stack_size);
-//            if (err != 0)
-//            handle_error_en(err, "pthread_attr_setstacksize");
-//    }
-//
-//    sched_setaffinity( etc.
-//
+    set_thread_attr(&attr, threadId);
 
-    err = pthread_create((pthread_t * restrict)&(ThreadTasks[threadId].tid), NULL, &StartTask, &ThreadTasks[threadId]);
+    err = pthread_create((pthread_t * restrict)&(ThreadTasks[threadId].tid), &attr, &StartTask, &ThreadTasks[threadId]);
+
+    if ((err == EPERM) && rt_sched) {
+        /* Not allowed to use SCHED_FIFO, run the task with the default policy instead. */
+        logger(LOG_ERR, "No permission to create SCHED_FIFO thread for task (%s), using default scheduling.",
+                ThreadTasks[threadId].name);
+        pthread_attr_setinheritsched(&attr, PTHREAD_INHERIT_SCHED);
+        err = pthread_create((pthread_t * restrict)&(ThreadTasks[threadId].tid), &attr, &StartTask, &ThreadTasks[threadId]);
+    }
 
     if (err != 0) {
         logger(LOG_ERR, "\nFailed to create thread for task (%s), error :[%s]",
@@ -664,10 +1234,10 @@ void init_threads() {
 
     /* First, mutexes and locks are initialized before any thread is running. */
     for (i=0; i< (OS_TASK_CNT+GNULINUX_TASK_CNT);i++) {
-        /* Initialise the Wait/Set event pthread lock */
+        /* Initialise the task activation pthread lock */
 #ifndef _WIN32
         pthread_mutex_init((pthread_mutex_t *) &ThreadTasks[i].mutex_lock, NULL);
-        pthread_cond_init((pthread_cond_t *) &ThreadTasks[i].cond, NULL);
+        pthread_cond_init((pthread_cond_t *) &ThreadTasks[i].activate_cond, NULL);
 #endif
     }
 
@@ -784,9 +1354,15 @@ int main(int argc, char *argv[]) {
     strcat(pid_file_name, "/tmp/");
     strcat(pid_file_name, progname);
     strcat(bit_event_file_name,pid_file_name); /* Put the event file in the same place as the pid file */
+    strcat(vtime_socket_name,pid_file_name);
+    strcat(vtime_socket_name, VTIME_SOCKET_NAME_SUFFIX);
 #if defined(USE_LINOS_DB)
     strcat(db_file_name,pid_file_name); /* Put the database file in the same place as the pid file */
     strcat(db_file_name, ".sqlite3");
+#endif
+#if defined(USE_STRACE)
+    strcat(strace_file_name,pid_file_name);
+    strcat(strace_file_name, ".strace");
 #endif
     strcat(pid_file_name, ".pid");
     strcat(bit_event_file_name,BIT_EVENT_FILE_NAME_SUFFIX);
@@ -796,6 +1372,12 @@ int main(int argc, char *argv[]) {
         usage();
         exit(1);
     }
+#ifndef _WIN32
+    Linos_VirtualTimeInit();
+    if (Linos_VirtualTimeMode != LINOS_VTIME_OFF) {
+        logger(LOG_INFO, "Running in virtual time.");
+    }
+#endif
 #ifndef _WIN32
     logger(LOG_INFO,"Main. HZ is %ld CLOCKS_PER_SEC is %ld OsTickFreq is %ld", 
             HZ, CLOCKS_PER_SEC, OsTickFreq);
@@ -806,6 +1388,9 @@ int main(int argc, char *argv[]) {
 
 #ifndef _WIN32
     /* Catch these signals */
+    if (pipe2(signal_pipe, O_NONBLOCK | O_CLOEXEC) != 0) {
+        logger(LOG_ERR, "Failed to create the signal pipe, signals are seen once a second.");
+    }
     signal(SIGHUP, signal_handler);
     signal(SIGINT, signal_handler);
     signal(SIGTERM, signal_handler);
@@ -825,6 +1410,15 @@ int main(int argc, char *argv[]) {
         logger(LOG_INFO, "No daemonising.");
     }
 
+#ifndef _WIN32
+    /* After daemonising, the logger thread would not survive the fork */
+    if (async_logging) {
+        if (logger_async_start() != 0) {
+            logger(LOG_ERR, "Failed to start the logger thread, logging synchronously.");
+        }
+    }
+#endif
+
 #if defined(USE_LINOS_DB) && !defined(_WIN32)
     if ( db_init (db_file_name) ) {
         logger(LOG_ERR,"Failed to initialize ArcCore CAL database '%s'", db_file_name);
@@ -857,6 +1451,19 @@ int main(int argc, char *argv[]) {
     }
 
 
+#ifndef _WIN32
+    if (lock_memory) {
+        /* Lock current and future pages. Future mappings, like the thread stacks,
+         * are populated when they are created so the tasks never page fault. */
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+            logger(LOG_ERR, "mlockall failed errno: %d (%s)", errno, strerror(errno));
+        }
+        else {
+            logger(LOG_INFO, "All memory locked.");
+        }
+    }
+#endif
+
     EcuM_Init(); /* This calls InitOS() */
     /* Improvement review if we can configure calling Linos_StbM_Init from EcuM module,
      * e.g. from EcuM_Init().
@@ -864,6 +1471,12 @@ int main(int argc, char *argv[]) {
     Linos_StbM_Init();
     /* In addition to Tasks and Scheduler threads, we start a thread to read
      * PTP synchronization updates from a running pmc_sync_status daemon. */
+#ifndef _WIN32
+    apply_affinity_args();
+#endif
+#if defined(USE_STRACE)
+    strace_init();
+#endif
     init_threads();
 
     /* THIS is the Main Thread */
@@ -880,13 +1493,18 @@ int main(int argc, char *argv[]) {
             }
         }
 #ifndef _WIN32
-        sleep(sleep_time_s);
+        wait_signals(sleep_time_s);
+        if (handle_signals()) {
+            rc = 0;
+            break;
+        }
 #endif
 #if defined(USE_LINOS_DB) && !defined(_WIN32)
         rc = db_inc_register (DB_ECU_RUNTIME_REG_ADDRESS, sleep_time_s, DB_CREATE_MISSING_WRITE, 1,1); // force_write, writeable
         if ( rc != DB_OK ) {
             logger(LOG_ERR, "DB_ECU_RUNTIME Problems saving runtime to DB.");
         }
+        db_write_task_stats();
 #endif
 
         /* Linos_StbM_GetCurrentTime TEST */
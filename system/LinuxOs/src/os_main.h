@@ -17,11 +17,14 @@
 
 #ifndef _WIN32
 /* Not POSIX, but needed for debugging using pthread_setname_np */
+#ifndef __USE_GNU
 #define __USE_GNU
+#endif
 #include <pthread.h>
 #endif
 
 #include <setjmp.h>
+#include "LinuxOs_TaskStats.h"
 #ifdef _WIN32
 #include "os_stubs.h"
 #endif
@@ -47,6 +50,12 @@ OsTaskVarType Os_TaskVarList[OS_TASK_CNT];
 /*			*/
 
 #define BIT_EVENT_FILE_NAME_SUFFIX "_event.txt"
+#define VTIME_SOCKET_NAME_SUFFIX "_vtime.sock"
+
+/* Real time a virtual tick waits for busy tasks before it is given anyway */
+#define LINOS_VTIME_IDLE_TIMEOUT_MS 100
+/* Real time the virtual tick sleeps between two checks for idle tasks */
+#define LINOS_VTIME_IDLE_POLL_NS    20000
 
 
 /* pthread status */
@@ -57,6 +66,13 @@ OsTaskVarType Os_TaskVarList[OS_TASK_CNT];
 
 /*	*/
 
+/* Smallest stack given to a task thread. The configured OS stack sizes are
+ * sized for the embedded targets, glibc and the logger need more than that. */
+#define LINOS_TASK_STACK_SIZE_MIN   (64*1024)
+
+/* Max number of -a <task>:<cpumask> options */
+#define LINOS_AFFINITY_ARG_MAX      16
+
 #define PTP_DEVICE       "/dev/ptp0"
 
 #ifndef CLOCK_INVALID
@@ -68,15 +84,27 @@ OsTaskVarType Os_TaskVarList[OS_TASK_CNT];
 typedef struct {
     OsTaskidType    pid;
     pthread_t tid;	/* Linux pThread id type */
-    pthread_mutex_t mutex_lock; /* Mutex lock for locking a thread running a WaitEvent */
-    pthread_cond_t cond;  /* Condition variable for notifing changes to EventState */
+    pthread_mutex_t mutex_lock; /* Mutex lock protecting pthread_status */
+    pthread_cond_t activate_cond; /* Condition variable for notifing (re-)activation of the task */
     jmp_buf stack_env; /* pthread stack environment */
     uint8 pthread_status; /* Only start new thread if old thread has ended. */
     OsPriorityType  prio;
+    uint32 stack_size; /* Configured stack size, 0 = pthread default */
+    uint32 cpu_mask;   /* CPU affinity, bit n = core n. 0 = no pinning */
     const char *name;
     void (*entry)( void ); /* Function pointer */
     uint8 autostart;
-    EventMaskType EventState; /* Something to hold Event bits for each task */
+    EventMaskType EventState; /* Something to hold Event bits for each task. Atomic access only */
+    EventMaskType WaitMask; /* Events the task is blocked on in WaitEvent, 0 if not waiting */
+    uint32 EventSeq; /* Futex word for WaitEvent, bumped by SetEvent */
+#ifndef _WIN32
+    struct timespec activate_time; /* CLOCK_MONOTONIC time of the last activation request */
+#endif
+    uint32 activate_cnt; /* Number of activations that reached the task entry */
+    uint32 activate_latency_last_ns; /* Activation request -> task entry, last */
+    uint32 activate_latency_max_ns;  /* Activation request -> task entry, worst case */
+    uint64 activate_latency_sum_ns;  /* Activation request -> task entry, sum for the average */
+    Linos_TaskStatsType stats; /* Response time, jitter and execution time per activation */
 } ThreadTaskType;
 
 #define handle_error_en(en, msg) \
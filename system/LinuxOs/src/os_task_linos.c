@@ -100,7 +100,7 @@ static inline void Os_TaskRunningToReady( OsTaskVarType *currPcbPtr ) {
 void Os_TaskMakeReady( OsTaskVarType *pcb ) {
     if( ( pcb->state & ( ST_READY | ST_RUNNING ) ) == 0 ) {
         pcb->state = ST_READY;
-        TAILQ_INSERT_TAIL(& OS_SYS_PTR->ready_head,pcb,ready_list);
+        Os_ReadyQInsert(pcb,FALSE);
         OS_DEBUG(D_TASK,"Added %s to ready list\n",pcb->constPtr->name);
     }
 }
@@ -117,7 +117,7 @@ void Os_TaskMakeWaiting( OsTaskVarType *pcb )
     ASSERT( pcb->state & (ST_READY|ST_RUNNING) );
 
     pcb->state = ST_WAIT_EVENT;
-    TAILQ_REMOVE(&OS_SYS_PTR->ready_head,pcb,ready_list);
+    Os_ReadyQDelete(pcb);
     OS_DEBUG(D_TASK,"Removed %s from ready list\n",pcb->constPtr->name);
 }
 
@@ -128,7 +128,7 @@ static inline void Os_TaskMakeSleeping( OsTaskVarType *pcb )
     ASSERT( pcb->state & (ST_READY|ST_RUNNING) );
 
     pcb->state = ST_WAITING | ST_SLEEPING;
-    TAILQ_REMOVE(&OS_SYS_PTR->ready_head,pcb,ready_list);
+    Os_ReadyQDelete(pcb);
     OS_DEBUG(D_TASK,"Removed %s from ready list\n",pcb->constPtr->name);
 }
 
@@ -138,7 +138,7 @@ static inline void Os_TaskMakeWaitingOnSem( OsTaskVarType *pcb )
     ASSERT( pcb->state & (ST_READY|ST_RUNNING) );
 
     pcb->state = ST_WAITING_SEM;
-    TAILQ_REMOVE(&OS_SYS_PTR->ready_head,pcb,ready_list);
+    Os_ReadyQDelete(pcb);
     OS_DEBUG(D_TASK,"Removed %s from ready list\n",pcb->constPtr->name);
 }
 
@@ -150,7 +150,7 @@ static inline void Os_TaskMakeSuspended( OsTaskVarType *pcb )
     {
     ASSERT( pcb->state & (ST_READY|ST_RUNNING) );
     pcb->state = ST_SUSPENDED;
-    TAILQ_REMOVE(&OS_SYS_PTR->ready_head,pcb,ready_list);
+    Os_ReadyQDelete(pcb);
     OS_DEBUG(D_TASK,"Removed %s from ready list\n",pcb->constPtr->name);
 }
 
@@ -347,40 +347,16 @@ void Os_TaskContextInit( OsTaskVarType *pcb ) {
 
 /**
  * Find the top priority task. Even the running task is included.
- * NOTE: There should be a priority queue (using a heap?) here instead.
- *        giving O(log n) for instertions and (1) for getting the top
- *        prio task. The curerent implementation is ehhhh bad.
  * @return
  */
 
 OsTaskVarType *Os_TaskGetTop( void ){
-    OsTaskVarType *i_pcb;
-    OsTaskVarType *top_prio_pcb = NULL;
-    OsPriorityType top_prio = 0;
-    boolean found = FALSE;
-
+    OsTaskVarType *top_prio_pcb;
 
 //    OS_DEBUG(D_TASK,"os_find_top_prio_proc\n");
 
-    TAILQ_FOREACH(i_pcb,& OS_SYS_PTR->ready_head,ready_list) {
-        // all ready task on the current core are candidates
-        if (Os_OnRunningCore(OBJECT_TASK,i_pcb->constPtr->pid)) {
-            if( i_pcb->state & (ST_READY | ST_RUNNING)) {
-                if( found ) {
-                    if( i_pcb->activePriority > top_prio ) {
-                        top_prio = i_pcb->activePriority;
-                        top_prio_pcb = i_pcb;
-                    }
-                } else {
-                    found = TRUE;
-                    top_prio = i_pcb->activePriority;
-                    top_prio_pcb = i_pcb;
-                }
-            } else {
-                ASSERT(0);
-            }
-        }
-    }
+    /* Only tasks on the current core are in its ready queue */
+    top_prio_pcb = Os_ReadyQTop();
 
     ASSERT(top_prio_pcb!=NULL);
 
@@ -43,6 +43,9 @@
 #include "limits.h"
 #include <sys/queue.h>
 #include "Rte_Os_Type.h"
+#if defined(USE_STRACE)
+#include "strace.h"
+#endif
 
 typedef uint8 StatusType;
 
@@ -327,6 +330,11 @@ static inline void ResumeAllInterrupts( void ) {
 static inline void SuspendOSInterrupts( void ) {
     Irq_SuspendOs();
     Os_IntSuspendAllCnt++;
+#if defined(USE_STRACE)
+    if(Os_IntSuspendAllCnt==1) {
+        strace(STRACE_EV_EXCL_ENTER, STRACE_ID_NONE);
+    }
+#endif
 }
 
 /* @req OSEK_SWS_ISR_00005 */
@@ -337,6 +345,9 @@ static inline void ResumeOSInterrupts( void ) {
     } else {
         Os_IntSuspendAllCnt--;
         if(Os_IntSuspendAllCnt==0) {
+#if defined(USE_STRACE)
+            strace(STRACE_EV_EXCL_EXIT, STRACE_ID_NONE);
+#endif
             Irq_ResumeOs();
         }
     }
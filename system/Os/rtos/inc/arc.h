@@ -72,6 +72,19 @@ typedef struct StackInfo_s {
 } StackInfoType;
 
 
+/**
+ * Holds spinlock statistics
+ */
+typedef struct SpinlockStats_s {
+    /* Number of times the spinlock was taken */
+    uint32  acquireCnt;
+    /* Number of times the spinlock was busy when requested */
+    uint32  contendedCnt;
+    /* Longest time spent spinning, in Timer_GetTicks() ticks, 0 without CFG_TIMER */
+    uint32  spinMax;
+} SpinlockStatsType;
+
+
 typedef struct Arc_PcbS {
     char name[OS_ARC_PCB_NAME_SIZE];
     uint32 tasktype;
@@ -112,6 +125,17 @@ void Os_Arc_GetIsrInfo( Arc_PcbType *pcbPtr, ISRType isrId );
  */
 ISRType Os_Arc_GetIsrCount( void );
 
+#if (OS_NUM_CORES > 1)
+/**
+ * Get name and statistics of a spinlock
+ * @param spinlockId
+ * @param name      Set to the name of the spinlock
+ * @param s
+ * @return E_OS_ID if spinlockId is not valid
+ */
+StatusType Os_Arc_GetSpinlockStats( SpinlockIdType spinlockId, const char **name, SpinlockStatsType *s );
+#endif
+
 /**
  * If the configured trap is not handled by callouts then
  * this function will be called.and shutdown the system
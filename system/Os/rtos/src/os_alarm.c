@@ -41,9 +41,11 @@ static inline StatusType Os_AlarmCheckCycle(TickType cycle, const OsAlarmType *a
 
 /*
  * Checks if the given alarm has expired, if so sets it to inactive.
- * Otherwise calculate a new expiration time
+ * Otherwise calculate a new expiration time and move it to that slot
+ * of the alarm wheel.
  */
 static void AlarmProcess( OsAlarmType *aPtr ) {
+    Os_AlarmWheelRemove(aPtr);
     if( aPtr->cycletime == 0 ) {
         aPtr->active = 0;
     } else {
@@ -51,6 +53,7 @@ static void AlarmProcess( OsAlarmType *aPtr ) {
         aPtr->expire_val = Os_CounterAdd( Os_CounterGetValue(aPtr->counter),
                                             Os_CounterGetMaxValue(aPtr->counter),
                                             aPtr->cycletime);
+        Os_AlarmWheelInsert(aPtr);
     }
 }
 
@@ -133,6 +136,7 @@ static StatusType Os_internalSetRelAlarm(AlarmType AlarmId, TickType Increment,
                             COUNTER_MAX(aPtr),
                             Increment);
     aPtr->cycletime = Cycle;
+    Os_AlarmWheelInsert(aPtr);
 
     Irq_Restore(flags);
     OS_DEBUG(D_ALARM,"  expire:%u cycle:%u\n",
@@ -214,6 +218,7 @@ static StatusType Os_internalSetAbsAlarm(AlarmType AlarmId, TickType Start, Tick
 
     aPtr->expire_val = Start;
     aPtr->cycletime = Cycle;
+    Os_AlarmWheelInsert(aPtr);
 
     Irq_Restore(flags);
 
@@ -457,6 +462,7 @@ StatusType CancelAlarm(AlarmType AlarmId) {
     }
 
     aPtr->active = 0;
+    Os_AlarmWheelRemove(aPtr);
 
     Irq_Restore(flags);
 
@@ -466,49 +472,72 @@ StatusType CancelAlarm(AlarmType AlarmId) {
 /*
  * Check the action of the alarm and progress accordingly;
  * either activate a task, set an event or increment the counter
+ *
+ * Only the due alarms at the head of the wheel slot of the current counter
+ * value are visited. They are moved to a list of their own first, the
+ * actions may set and cancel alarms of the same slot. An alarm is only
+ * processed if its action left it in that list, a cancelled one is gone.
  * */
-void Os_AlarmCheck( const OsCounterType *c_p ) {
+void Os_AlarmCheck( OsCounterType *c_p ) {
     OsAlarmType *aPtr;
+    OsAlarmType *lastPtr = NULL_PTR;
+    LIST_HEAD(alarm_due,OsAlarm) due;
+    struct alarm_wheel *slot = &c_p->alarm_wheel[c_p->val & (OS_ALARM_WHEEL_SIZE - 1u)];
     StatusType rv;
 
-    /*lint -e{9036} MISRA:EXTERNAL_FILE::[MISRA 2012 Rule 14.4, required] */
-    SLIST_FOREACH(aPtr,&c_p->alarm_head,alarm_list) {
-        if( aPtr->active && (c_p->val == aPtr->expire_val) ) {
-            /* Check if the alarms have expired */
-            OS_DEBUG(D_ALARM,"expired %s id:%u val:%u\n",
-                                            aPtr->name,
-                                            (unsigned)aPtr->counter_id,
-                                            (unsigned)aPtr->expire_val);
-
-            switch( aPtr->action.type ) {
-            case ALARM_ACTION_ACTIVATETASK:
-                /* @req SWS_Os_00321 */
-                if( ActivateTask(aPtr->action.task_id) != E_OK ) {
-                    /* We ignore return value since handling of error occurs in ActivateTask */
-                }
-                AlarmProcess(aPtr);
-                break;
-            case ALARM_ACTION_SETEVENT:
-                rv =  SetEvent(aPtr->action.task_id,aPtr->action.event_id);
-                if( rv != E_OK ) {
-                	Os_CallErrorHook(rv);
-                }
-                AlarmProcess(aPtr);
-                break;
+    /*lint -e{9036} MISRA:EXTERNAL_FILE:while(0) allowed to be used in macros:[MISRA 2012 Rule 14.4, required] */
+    LIST_INIT(&due);
+    aPtr = LIST_FIRST(slot);
+    while( (aPtr != NULL_PTR) && aPtr->active && (c_p->val == aPtr->expire_val) ) {
+        /*lint -e{9036} MISRA:EXTERNAL_FILE:while(0) allowed to be used in macros:[MISRA 2012 Rule 14.4, required] */
+        LIST_REMOVE(aPtr, wheel_list);
+        if( lastPtr == NULL_PTR ) {
+            /*lint -e{9036} MISRA:EXTERNAL_FILE:while(0) allowed to be used in macros:[MISRA 2012 Rule 14.4, required] */
+            LIST_INSERT_HEAD(&due, aPtr, wheel_list);
+        } else {
+            /*lint -e{9036} MISRA:EXTERNAL_FILE:while(0) allowed to be used in macros:[MISRA 2012 Rule 14.4, required] */
+            LIST_INSERT_AFTER(lastPtr, aPtr, wheel_list);
+        }
+        lastPtr = aPtr;
+        aPtr = LIST_FIRST(slot);
+    }
+
+    while( (aPtr = LIST_FIRST(&due)) != NULL_PTR ) {
+        /* Check if the alarms have expired */
+        OS_DEBUG(D_ALARM,"expired %s id:%u val:%u\n",
+                                        aPtr->name,
+                                        (unsigned)aPtr->counter_id,
+                                        (unsigned)aPtr->expire_val);
+
+        switch( aPtr->action.type ) {
+        case ALARM_ACTION_ACTIVATETASK:
+            /* @req SWS_Os_00321 */
+            if( ActivateTask(aPtr->action.task_id) != E_OK ) {
+                /* We ignore return value since handling of error occurs in ActivateTask */
+            }
+            break;
+        case ALARM_ACTION_SETEVENT:
+            rv =  SetEvent(aPtr->action.task_id,aPtr->action.event_id);
+            if( rv != E_OK ) {
+                Os_CallErrorHook(rv);
+            }
+            break;
 #if (OS_SC1 == STD_ON)
-            case ALARM_ACTION_ALARMCALLBACK:
-                break;
+        case ALARM_ACTION_ALARMCALLBACK:
+            break;
 #endif
-            case ALARM_ACTION_INCREMENTCOUNTER:
-                /** @req SWS_Os_00301 */
-                (void)IncrementCounter(aPtr->action.counter_id);
-                AlarmProcess(aPtr);
-                break;
-            __CODE_COVERAGE_IGNORE__
-            default:
-                /* @CODECOV:DEFAULT_CASE:Default statement is required for defensive programming. */
-                ASSERT(0);
-            }
+        case ALARM_ACTION_INCREMENTCOUNTER:
+            /** @req SWS_Os_00301 */
+            (void)IncrementCounter(aPtr->action.counter_id);
+            break;
+        __CODE_COVERAGE_IGNORE__
+        default:
+            /* @CODECOV:DEFAULT_CASE:Default statement is required for defensive programming. */
+            ASSERT(0);
+        }
+
+        if( LIST_FIRST(&due) == aPtr ) {
+            AlarmProcess(aPtr);
         }
     }
 }
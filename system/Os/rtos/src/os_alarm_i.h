@@ -107,6 +107,7 @@ typedef struct OsAlarm {
     const struct OsAlarmAutostart *autostartPtr;
 
     SLIST_ENTRY(OsAlarm) alarm_list;		/* List of alarms connected to the same counter */
+    LIST_ENTRY(OsAlarm) wheel_list;		/* Slot in the counter alarm wheel, only when active */
 
 #if (OS_SC1 == STD_ON)
     /* IMPROVEMENT: OS242, callback in scalability class 1 only..*/
@@ -119,7 +120,7 @@ typedef struct OsAlarm {
 extern GEN_ALARM_HEAD;
 #endif
 
-void Os_AlarmCheck(const OsCounterType *c_p);
+void Os_AlarmCheck(OsCounterType *c_p);
 void Os_AlarmAutostart(void);
 
 static inline OsAlarmType *Os_AlarmGet( AlarmType alarm_id ) {
@@ -131,6 +132,50 @@ static inline OsAlarmType *Os_AlarmGet( AlarmType alarm_id ) {
 #endif
 }
 
+/**
+ * Ticks from the next counter value to the expiry of an alarm, 0..max. An
+ * alarm that expires at the current counter value is a whole counter cycle
+ * away. The order of the alarms by this value stays the same when the
+ * counter advances, until Os_AlarmCheck() takes the due ones.
+ */
+static inline TickType Os_AlarmWheelKey( const OsAlarmType *aPtr ) {
+    TickType max = Os_CounterGetMaxValue(aPtr->counter);
+
+    return Os_CounterDiff(aPtr->expire_val, Os_CounterAdd(Os_CounterGetValue(aPtr->counter), max, 1u), max);
+}
+
+/**
+ * Add an active alarm to the timing wheel of its counter, expire_val must be set.
+ * A slot is sorted on Os_AlarmWheelKey(), so the due alarms are at its head.
+ * Call with interrupts disabled.
+ */
+static inline void Os_AlarmWheelInsert( OsAlarmType *aPtr ) {
+    struct alarm_wheel *slot = &aPtr->counter->alarm_wheel[aPtr->expire_val & (OS_ALARM_WHEEL_SIZE - 1u)];
+    OsAlarmType *prevPtr = LIST_FIRST(slot);
+    TickType key = Os_AlarmWheelKey(aPtr);
+
+    if( (prevPtr == NULL_PTR) || (Os_AlarmWheelKey(prevPtr) > key) ) {
+        /*lint -e{9036} MISRA:EXTERNAL_FILE:while(0) allowed to be used in macros:[MISRA 2012 Rule 14.4, required] */
+        LIST_INSERT_HEAD(slot, aPtr, wheel_list);
+    } else {
+        while( (LIST_NEXT(prevPtr, wheel_list) != NULL_PTR) &&
+               (Os_AlarmWheelKey(LIST_NEXT(prevPtr, wheel_list)) <= key) ) {
+            prevPtr = LIST_NEXT(prevPtr, wheel_list);
+        }
+        /*lint -e{9036} MISRA:EXTERNAL_FILE:while(0) allowed to be used in macros:[MISRA 2012 Rule 14.4, required] */
+        LIST_INSERT_AFTER(prevPtr, aPtr, wheel_list);
+    }
+}
+
+/**
+ * Remove an alarm from the timing wheel of its counter.
+ * Call with interrupts disabled.
+ */
+static inline void Os_AlarmWheelRemove( OsAlarmType *aPtr ) {
+    /*lint -e{9036} MISRA:EXTERNAL_FILE:while(0) allowed to be used in macros:[MISRA 2012 Rule 14.4, required] */
+    LIST_REMOVE(aPtr, wheel_list);
+}
+
 static inline ApplicationType Os_AlarmGetApplicationOwner( AlarmType id ) {
     ApplicationType rv;
     /** @req SWS_Os_00274 */
@@ -375,16 +375,22 @@
  * _name
  *    Name of the spinlock, string
  * _lock
- *    SPINLOCK_UNLOCKED, SPINLOCK_LOCKED
+ *    SPINLOCK_UNLOCKED, SPINLOCK_LOCKED. Only used by OS_SPINLOCK_METHOD_TAS
+ * _method
+ *    OS_SPINLOCK_METHOD_TAS, OS_SPINLOCK_METHOD_TICKET, OS_SPINLOCK_METHOD_MCS
  */
-#define GEN_SPINLOCK( _id, _name, _lock, _accessing_appl_mask )	\
+#define GEN_SPINLOCK_METHOD( _id, _name, _lock, _accessing_appl_mask, _method )	\
 {	                                                          	\
     .id   = _id,                                            	\
     .name = _name,                                            	\
     .lock = _lock,                                            	\
     .accessingApplMask = _accessing_appl_mask,                	\
+    .method = _method,                                        	\
 }
 
+#define GEN_SPINLOCK( _id, _name, _lock, _accessing_appl_mask )	\
+    GEN_SPINLOCK_METHOD( _id, _name, _lock, _accessing_appl_mask, OS_SPINLOCK_METHOD_DEFAULT )
+
 
 #define ALIGN_16(x) (((x)>>4)<<4)
 
@@ -260,7 +260,6 @@ ISR(OsTick) {
 #if (ARC_OSTICK == STD_ON)
         OsCounterType *cPtr = Os_CounterGet(Os_Arc_OsTickCounter);
 #if defined(CFG_KERNEL_EXTRA)
-        OsTaskVarType *pcbPtr;
         imask_t flags;
 #endif
 
@@ -276,21 +275,7 @@ ISR(OsTick) {
         Irq_Save(flags);
         /* Check tasks in the timer queue for API calls with timeout */
         LOG_S_S(__func__,"CheckTQ");
-        if( !Os_TimerQIsEmpty() ) {
-            /* We have timeouts */
-            pcbPtr = Os_TimerQFirst();
-            if( pcbPtr->tmo == OS_SYS_PTR->tick ) {
-                LOG_S_S("TMO, rel:", pcbPtr->constPtr->name);
-
-                ASSERT( (pcbPtr->state & (ST_SLEEPING|ST_WAIT_SEM)) != 0  );
-
-                /* We have timeout, so remove the task from the timer queue and make ready   */
-                pcbPtr->rv = E_OS_TIMEOUT;
-                Os_TimerQRemove(pcbPtr);
-                /* ... and add to the ready queue */
-                Os_TaskMakeReady(pcbPtr);
-            }
-        }
+        Os_TimerQCheck(OS_SYS_PTR->tick);
         Irq_Restore(flags);
 #endif
 #if OS_ALARM_CNT!=0
@@ -310,6 +295,17 @@ TickType GetOsTick( void ) {
  * Initialize alarms and schedule-tables for the counters
  */
 void Os_CounterInit( void ) {
+#if OS_COUNTER_CNT!=0
+    /* Empty alarm wheels, before any alarm can be inserted */
+    for (CounterType c = 0; c < OS_COUNTER_CNT; c++) {
+        OsCounterType *cPtr = Os_CounterGet(c);
+        for (uint32 slot = 0; slot < OS_ALARM_WHEEL_SIZE; slot++) {
+            /*lint -e{9036} MISRA:EXTERNAL_FILE:while(0) allowed to be used in macros:[MISRA 2012 Rule 14.4, required] */
+            LIST_INIT(&cPtr->alarm_wheel[slot]);
+        }
+    }
+#endif
+
 #if OS_ALARM_CNT!=0
     {
         OsCounterType *cPtr;
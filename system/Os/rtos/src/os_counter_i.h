@@ -23,6 +23,14 @@
 #define COUNTER_UNIT_TICKS	0
 #define COUNTER_UNIT_NANO	1
 
+/* Number of slots in the alarm timing wheel of a counter, must be a power of 2.
+ * Active alarms are hashed on their expire value and each slot is sorted on
+ * the ticks left, so a tick only visits the due alarms of one slot. Setting an
+ * alarm walks the slot, about active alarms / OS_ALARM_WHEEL_SIZE of them. */
+#if !defined(OS_ALARM_WHEEL_SIZE)
+#define OS_ALARM_WHEEL_SIZE	16u
+#endif
+
 /* STD container : OsCounter
  * OsCounterMaxAllowedValue: 		1    Integer
  * OsCounterMinCycle:				1	 Integer
@@ -53,6 +61,8 @@ typedef struct OsCounter {
                                              * but easier to debug this way */
 
     SLIST_HEAD(sclist,OsSchTbl) sched_head;	/* List of schedule-table connected to this counter */
+
+    LIST_HEAD(alarm_wheel,OsAlarm) alarm_wheel[OS_ALARM_WHEEL_SIZE];	/* Active alarms, slot = expire_val % OS_ALARM_WHEEL_SIZE, sorted on ticks left */
 } OsCounterType;
 
 
@@ -122,8 +122,10 @@ void InitOS( void ) {
 
     // Assign pcb list and init ready queue
     OS_SYS_PTR->pcb_list = Os_TaskVarList;
-    /*lint -e{9036} MISRA:EXTERNAL_FILE::[MISRA 2012 Rule 14.4, required] */
-    TAILQ_INIT(& (OS_SYS_PTR->ready_head));
+    for( i = 0; i < OS_READY_PRIO_CNT; i++ ) {
+        /*lint -e{9036} MISRA:EXTERNAL_FILE::[MISRA 2012 Rule 14.4, required] */
+        TAILQ_INIT(& (OS_SYS_PTR->ready_head[i]));
+    }
 #if defined(CFG_KERNEL_EXTRA)
     TAILQ_INIT(& OS_SYS_PTR->timerHead);
 #endif
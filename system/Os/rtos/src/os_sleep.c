@@ -65,9 +65,9 @@ StatusType Sleep( TickType sleep ) {
 
             /* Put us last in the ready list, by first removing us and
              * then adding us again */
-            TAILQ_REMOVE(&OS_SYS_PTR->ready_head,pcbPtr,ready_list);
+            Os_ReadyQDelete(pcbPtr);
 
-            TAILQ_INSERT_TAIL(& OS_SYS_PTR->ready_head,pcbPtr,ready_list);
+            Os_ReadyQInsert(pcbPtr,FALSE);
 
             OsTaskVarType *topTask = Os_TaskGetTop();
             if( topTask != pcbPtr ) {
@@ -13,9 +13,219 @@
  *-------------------------------- Arctic Core -----------------------------*/
 
 #include "os_i.h"
+#if defined(CFG_TIMER)
+#include "timer.h"
+#endif
 
 #define SPINLOCK_CHECK_ID(_spinlockId)   (((_spinlockId) < OS_SPINLOCK_CNT) )
 
+/*
+ * Ticket and MCS locks use the GCC atomic builtins. For other compilers
+ * all spinlocks fall back on the arch test-and-set lock.
+ *
+ * An MCS lock has one queue node per core. The core enqueues and spins with
+ * interrupts disabled, so no task or ISR of the same core can take the node
+ * while it waits, and a waiter that is preempted does not stall the queue.
+ * Taking the lock again on a core that holds it would reuse the node, it is
+ * refused with E_OS_INTERFERENCE_DEADLOCK.
+ */
+#if defined(__GNUC__)
+#define SPINLOCK_ATOMICS
+#endif
+
+/* The spin time is only measured when the board has a timer */
+#if defined(CFG_TIMER)
+typedef TimerTick SpinStampType;
+#define SPINLOCK_STAMP()    Timer_GetTicks()
+#else
+typedef uint32 SpinStampType;
+#define SPINLOCK_STAMP()    0u
+#endif
+
+/* contendedCnt is also counted by failed tries, that do not hold the lock,
+ * so it is only updated atomically */
+#if defined(SPINLOCK_ATOMICS)
+#define SPINLOCK_CONTENDED_INC(_sPtr)   (void)__atomic_fetch_add(&(_sPtr)->stats.contendedCnt, 1u, __ATOMIC_RELAXED)
+#else
+/* Only counted with the lock taken, a failed try is not counted */
+#define SPINLOCK_CONTENDED_INC(_sPtr)   ((_sPtr)->stats.contendedCnt++)
+#endif
+
+/**
+ * Update statistics, called with the spinlock taken.
+ *
+ * @param sPtr      The spinlock
+ * @param contended TRUE if we had to spin
+ * @param start     SPINLOCK_STAMP() when we started to spin
+ */
+static void Os_SpinlockStats(OsSpinlockType *sPtr, boolean contended, SpinStampType start)
+{
+    SpinStampType spin;
+
+    sPtr->stats.acquireCnt++;
+    if (contended == TRUE) {
+        spin = SPINLOCK_STAMP() - start;
+        SPINLOCK_CONTENDED_INC(sPtr);
+        if (spin > sPtr->stats.spinMax) {
+            sPtr->stats.spinMax = (uint32)spin;
+        }
+    }
+}
+
+static StatusType Os_SpinlockAcquire(OsSpinlockType *sPtr)
+{
+    boolean contended = FALSE;
+    SpinStampType start = 0;
+#if defined(SPINLOCK_ATOMICS)
+    uint32 ticket;
+    OsSpinlockMcsNodeType *node;
+    OsSpinlockMcsNodeType *prev;
+    imask_t flags;
+#endif
+
+    switch (sPtr->method) {
+#if defined(SPINLOCK_ATOMICS)
+    case OS_SPINLOCK_METHOD_TICKET:
+        ticket = __atomic_fetch_add(&sPtr->ticketNext, 1u, __ATOMIC_RELAXED);
+        if (__atomic_load_n(&sPtr->ticketOwner, __ATOMIC_ACQUIRE) != ticket) {
+            contended = TRUE;
+            start = SPINLOCK_STAMP();
+            while (__atomic_load_n(&sPtr->ticketOwner, __ATOMIC_ACQUIRE) != ticket) {
+                ;
+            }
+        }
+        break;
+    case OS_SPINLOCK_METHOD_MCS:
+        Irq_Save(flags);
+        node = &sPtr->mcsNode[GetCoreID()];
+        if (node->busy != 0u) {
+            Irq_Restore(flags);
+            return E_OS_INTERFERENCE_DEADLOCK;
+        }
+        node->busy = 1u;
+        node->next = NULL;
+        node->locked = 1u;
+        prev = __atomic_exchange_n(&sPtr->mcsTail, node, __ATOMIC_ACQ_REL);
+        if (prev != NULL) {
+            contended = TRUE;
+            start = SPINLOCK_STAMP();
+            __atomic_store_n(&prev->next, node, __ATOMIC_RELEASE);
+            /* Spin on our own node until the previous owner hands over */
+            while (__atomic_load_n(&node->locked, __ATOMIC_ACQUIRE) != 0u) {
+                ;
+            }
+        }
+        Irq_Restore(flags);
+        break;
+#endif
+    default:
+        if (Os_TryToGetSpinlock(sPtr) != TRYTOGETSPINLOCK_SUCCESS) {
+            contended = TRUE;
+            start = SPINLOCK_STAMP();
+            Os_GetSpinlock(sPtr);
+        }
+        break;
+    }
+
+    Os_SpinlockStats(sPtr, contended, start);
+
+    return E_OK;
+}
+
+static TryToGetSpinlockType Os_SpinlockTryAcquire(OsSpinlockType *sPtr)
+{
+    TryToGetSpinlockType rv = TRYTOGETSPINLOCK_NOSUCCESS;
+#if defined(SPINLOCK_ATOMICS)
+    uint32 ticket;
+    OsSpinlockMcsNodeType *node;
+    OsSpinlockMcsNodeType *expected = NULL;
+    imask_t flags;
+#endif
+
+    switch (sPtr->method) {
+#if defined(SPINLOCK_ATOMICS)
+    case OS_SPINLOCK_METHOD_TICKET:
+        /* Only take a ticket if it will be served directly */
+        ticket = __atomic_load_n(&sPtr->ticketOwner, __ATOMIC_RELAXED);
+        if (__atomic_compare_exchange_n(&sPtr->ticketNext, &ticket, ticket + 1u,
+                FALSE, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            rv = TRYTOGETSPINLOCK_SUCCESS;
+        }
+        break;
+    case OS_SPINLOCK_METHOD_MCS:
+        Irq_Save(flags);
+        node = &sPtr->mcsNode[GetCoreID()];
+        /* A busy node means this core holds the lock, the tail is not NULL */
+        if (node->busy == 0u) {
+            node->next = NULL;
+            node->locked = 0u;
+            if (__atomic_compare_exchange_n(&sPtr->mcsTail, &expected, node,
+                    FALSE, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+                node->busy = 1u;
+                rv = TRYTOGETSPINLOCK_SUCCESS;
+            }
+        }
+        Irq_Restore(flags);
+        break;
+#endif
+    default:
+        rv = Os_TryToGetSpinlock(sPtr);
+        break;
+    }
+
+    if (rv == TRYTOGETSPINLOCK_SUCCESS) {
+        Os_SpinlockStats(sPtr, FALSE, 0);
+    } else {
+#if defined(SPINLOCK_ATOMICS)
+        SPINLOCK_CONTENDED_INC(sPtr);
+#endif
+    }
+
+    return rv;
+}
+
+static void Os_SpinlockRelease(OsSpinlockType *sPtr)
+{
+#if defined(SPINLOCK_ATOMICS)
+    OsSpinlockMcsNodeType *node;
+    OsSpinlockMcsNodeType *next;
+    OsSpinlockMcsNodeType *expected;
+    imask_t flags;
+#endif
+
+    switch (sPtr->method) {
+#if defined(SPINLOCK_ATOMICS)
+    case OS_SPINLOCK_METHOD_TICKET:
+        __atomic_store_n(&sPtr->ticketOwner, sPtr->ticketOwner + 1u, __ATOMIC_RELEASE);
+        break;
+    case OS_SPINLOCK_METHOD_MCS:
+        Irq_Save(flags);
+        node = &sPtr->mcsNode[GetCoreID()];
+        next = __atomic_load_n(&node->next, __ATOMIC_ACQUIRE);
+        if (next == NULL) {
+            /* No known successor, try to set the lock free */
+            expected = node;
+            if (!__atomic_compare_exchange_n(&sPtr->mcsTail, &expected, NULL,
+                    FALSE, __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+                /* A successor is queuing, wait for it to link in */
+                while ((next = __atomic_load_n(&node->next, __ATOMIC_ACQUIRE)) == NULL) {
+                    ;
+                }
+            }
+        }
+        if (next != NULL) {
+            __atomic_store_n(&next->locked, 0u, __ATOMIC_RELEASE);
+        }
+        node->busy = 0u;
+        Irq_Restore(flags);
+        break;
+#endif
+    default:
+        Os_ReleaseSpinlock(sPtr);
+        break;
+    }
+}
+
 static StatusType GetSpinlockDeadlockCheck(SpinlockIdType spinlock_id)
 {
     StatusType rv = E_OK;
@@ -92,7 +302,11 @@ StatusType GetSpinlock(SpinlockIdType spinlock_id)
     OS_VALIDATE( (GetSpinlockDeadlockCheck(spinlock_id)==E_OK), E_OS_INTERFERENCE_DEADLOCK);
 
     /** OS687 */
-    Os_GetSpinlock(sPtr);
+    rv = Os_SpinlockAcquire(sPtr);
+    if (rv != E_OK) {
+        Os_CallErrorHook(rv);
+        return rv;
+    }
 
     if (pcbPtr != NULL)
         TAILQ_INSERT_TAIL(&pcbPtr->spinlockHead, sPtr, spinlockEntry);
@@ -125,7 +339,7 @@ StatusType ReleaseSpinlock(SpinlockIdType spinlock_id)
     if (pcbPtr != NULL)
         TAILQ_REMOVE(&pcbPtr->spinlockHead, sPtr, spinlockEntry);
 
-    Os_ReleaseSpinlock(sPtr);
+    Os_SpinlockRelease(sPtr);
 
     /** OS697 */
     return rv;
@@ -151,7 +365,7 @@ StatusType TryToGetSpinlock(SpinlockIdType spinlock_id, TryToGetSpinlockType* su
 #endif
     OS_VALIDATE( (GetSpinlockDeadlockCheck(spinlock_id)==E_OK), E_OS_INTERFERENCE_DEADLOCK);
     /** OS704 */ /** OS705 */
-    *success = Os_TryToGetSpinlock(sPtr);
+    *success = Os_SpinlockTryAcquire(sPtr);
 
     if (*success == TRYTOGETSPINLOCK_SUCCESS) {
         pcbPtr = Os_SysTaskGetCurr();
@@ -163,3 +377,20 @@ StatusType TryToGetSpinlock(SpinlockIdType spinlock_id, TryToGetSpinlockType* su
     /** OS706 */
     return rv;
 }
+
+
+StatusType Os_Arc_GetSpinlockStats( SpinlockIdType spinlockId, const char **name, SpinlockStatsType *s )
+{
+    StatusType rv = E_OK;
+    OsSpinlockType *sPtr;
+
+    if (SPINLOCK_CHECK_ID(spinlockId)) {
+        sPtr = Os_SpinlockGet(spinlockId);
+        *name = sPtr->name;
+        *s = sPtr->stats;
+    } else {
+        rv = E_OS_ID;
+    }
+
+    return rv;
+}
@@ -15,6 +15,31 @@
 #ifndef SPINLOCK_I_H_
 #define SPINLOCK_I_H_
 
+#include "arc.h"
+
+/* Spinlock implementations, selected per spinlock */
+#define OS_SPINLOCK_METHOD_TAS      0u  /* Arch test-and-set lock */
+#define OS_SPINLOCK_METHOD_TICKET   1u  /* FIFO ticket lock */
+#define OS_SPINLOCK_METHOD_MCS      2u  /* FIFO queue lock, each core spins on its own node */
+
+#if !defined(OS_SPINLOCK_METHOD_DEFAULT)
+#define OS_SPINLOCK_METHOD_DEFAULT  OS_SPINLOCK_METHOD_TAS
+#endif
+
+#if !defined(OS_SPINLOCK_CACHE_LINE)
+#define OS_SPINLOCK_CACHE_LINE      64u
+#endif
+
+/* One cache line per node, a core spins on its own line only. busy is set
+ * from the enqueue until the release, a second acquire of the same lock on
+ * the core while it is set is refused, see os_spinlock.c */
+typedef struct OsSpinlockMcsNode {
+    struct OsSpinlockMcsNode * volatile next;
+    volatile uint32 locked;
+    uint32 busy;
+    uint8 pad[OS_SPINLOCK_CACHE_LINE - sizeof(void *) - (2u * sizeof(uint32))];
+} OsSpinlockMcsNodeType;
+
 typedef struct OsSpinlock {
     SpinlockIdType id;
     char name[32];
@@ -23,6 +48,15 @@ typedef struct OsSpinlock {
     uint32 accessingApplMask;
 #endif
     TAILQ_ENTRY(OsSpinlock) spinlockEntry;
+    uint8 method;                               /* OS_SPINLOCK_METHOD_xxx */
+    /* Ticket lock */
+    volatile uint32 ticketNext;
+    volatile uint32 ticketOwner;
+    /* MCS lock, one queue node per core */
+    OsSpinlockMcsNodeType * volatile mcsTail;
+    __balign(OS_SPINLOCK_CACHE_LINE) OsSpinlockMcsNodeType mcsNode[OS_NUM_CORES];
+    /* Statistics, updated while holding the lock */
+    SpinlockStatsType stats;
 } OsSpinlockType;
 
 
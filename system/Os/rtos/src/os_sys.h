@@ -18,6 +18,15 @@
 
 #define SYSTEM_FLAGS_IN_OS      1u
 
+/* Number of priority levels in the ready queue. Each level has its own list
+ * and a bit in ready_map so the top priority task is found with a bit scan.
+ * Priorities >= OS_READY_PRIO_CNT-1 (e.g. the RES_SCHEDULER ceiling) share
+ * the last level, which is searched linearly. */
+#if !defined(OS_READY_PRIO_CNT)
+#define OS_READY_PRIO_CNT       64u
+#endif
+#define OS_READY_MAP_WORDS      ((OS_READY_PRIO_CNT + 31u) / 32u)
+
 /* STD container : OsOs. OSEK properties
  * Class: ALL
  *
@@ -101,9 +110,14 @@ typedef struct Os_Sys {
 #if defined(CFG_KERNEL_EXTRA)
     /* List of PCB's to be put in ready list when timeout */
     TAILQ_HEAD(,OsTaskVar) 	timerHead;		/* TASK */
+    TickType 				timerTick;		/* Tick up to which timerHead has been processed */
+    uint32 					timerQDepth;	/* Number of tasks in timerHead */
+    uint32 					timerQDepthMax;	/* Max number of tasks in timerHead */
+    uint32 					timerQRelMax;	/* Max number of tasks released by timeout in one tick */
 	OsSemType *semPtr;
 #endif
-    TAILQ_HEAD(,OsTaskVar) 	ready_head;		/* Ready queue */
+    TAILQ_HEAD(,OsTaskVar) 	ready_head[OS_READY_PRIO_CNT];	/* Ready queue, one list per priority level */
+    uint32 					ready_map[OS_READY_MAP_WORDS];	/* Bit set for each non-empty ready_head */
     struct OsResource 		*resScheduler;	/* According to OSEK 8.3 RES_SCHEDULER is accessible to all tasks */
     Os_CoreStatusType 		status;
     boolean             osFlags;      /* Indication that the kernel is running */
@@ -44,8 +44,7 @@ static inline void Os_TaskRunningToReady( OsTaskVarType *currPcbPtr ) {
  */
 /*lint --e{818} MISRA:OTHER:need not be const pointer:[MISRA 2012 Rule 8.13, advisory] */
 static void Os_ReadyQRemove(OsTaskVarType *tPtr) {
-    /*lint -e{9012, 9036} MISRA:EXTERNAL_FILE::[MISRA 2012 Rule 15.6, required], [MISRA 2012 Rule 14.4, required] */
-    TAILQ_REMOVE(&OS_SYS_PTR->ready_head,tPtr,ready_list);
+    Os_ReadyQDelete(tPtr);
     OS_DEBUG(D_TASK,"Removed %s from ready list\n",pcb->constPtr->name);
 }
 
@@ -54,8 +53,7 @@ static void Os_ReadyQRemove(OsTaskVarType *tPtr) {
  * @param[in] pcb  Pointer to task
  */
 static void Os_ReadyQEnqueue(OsTaskVarType *pcb) {
-    /*lint -e{9036} MISRA:EXTERNAL_FILE::[MISRA 2012 Rule 14.4, required] */
-    TAILQ_INSERT_TAIL(& OS_SYS_PTR->ready_head,pcb,ready_list);
+    Os_ReadyQInsert(pcb,FALSE);
 }
 
 
@@ -336,33 +334,15 @@ void Os_TaskContextInit( OsTaskVarType *pcb ) {
  */
 
 OsTaskVarType *Os_TaskGetTop( void ){
-    OsTaskVarType *i_pcb;
-    OsTaskVarType *top_prio_pcb = NULL_PTR;
-    OsPriorityType top_prio = 0;
-    boolean found = FALSE;
+    OsTaskVarType *top_prio_pcb;
 
     OS_DEBUG(D_TASK,"os_find_top_prio_proc\n");
-    /*lint -e{9036} MISRA:EXTERNAL_FILE::[MISRA 2012 Rule 14.4, required] */
-    TAILQ_FOREACH(i_pcb,& OS_SYS_PTR->ready_head,ready_list) {
-        // all ready task on the current core are candidates
-        if (Os_OnRunningCore(OBJECT_TASK,i_pcb->constPtr->pid)) {
-
-        	ASSERT((i_pcb->state & (ST_READY | ST_RUNNING)) != 0u);
-        	if( found == TRUE) {
-        		if( i_pcb->activePriority > top_prio ) {
-        			top_prio = i_pcb->activePriority;
-        			top_prio_pcb = i_pcb;
-        		}
-        	} else {
-        		found = TRUE;
-
-        		top_prio = i_pcb->activePriority;
-        		top_prio_pcb = i_pcb;
-        	}
-        }
-    }
+    /* Only tasks on the current core are in its ready queue */
+    top_prio_pcb = Os_ReadyQTop();
 
     ASSERT(top_prio_pcb!=NULL_PTR);
+    ASSERT((top_prio_pcb->state & (ST_READY | ST_RUNNING)) != 0u);
+    ASSERT(Os_OnRunningCore(OBJECT_TASK,top_prio_pcb->constPtr->pid));
 
     OS_DEBUG(D_TASK,"Found %s\n",top_prio_pcb->constPtr->name);
 
@@ -448,49 +428,49 @@ void Os_SwapPostHandler(OpType op,OsTaskVarType *old_pcb, OsTaskVarType *new_pcb
 
 /**
  * Insert a task into the timer queue sorted with shortest timeout first.
+ * The queue is a delta list, tmo of each task holds the number of ticks
+ * after the task before it, counted from OS_SYS_PTR->timerTick.
  *
  * @param tPtr Task to insert.
+ * @param tmo  Timeout in ticks from now.
  */
-void Os_TimerQInsertSorted(OsTaskVarType *tPtr) {
+void Os_TimerQInsertSorted(OsTaskVarType *tPtr, TickType tmo) {
     OsTaskVarType *i_pcb;
     uint8 insertLast = 1u;
+    /* Ticks not yet handled by Os_TimerQCheck() are added to the timeout */
+    TickType delta = tmo + (GetOsTick() - OS_SYS_PTR->timerTick);
 
     ASSERT(tPtr!=NULL_PTR);
+    ASSERT(tPtr->timerQueued == FALSE);
 
-    if ( TAILQ_EMPTY(& OS_SYS_PTR->timerHead) ) {
-        ASSERT( TAILQ_FIRST(& OS_SYS_PTR->timerHead) != tPtr );
-        TAILQ_INSERT_HEAD(& OS_SYS_PTR->timerHead,tPtr, timerEntry);
-    } else {
-        TAILQ_FOREACH(i_pcb,& OS_SYS_PTR->timerHead,timerEntry) {
+    TAILQ_FOREACH(i_pcb,& OS_SYS_PTR->timerHead,timerEntry) {
 
-            ASSERT(i_pcb != tPtr );
+        ASSERT(i_pcb != tPtr );
 
-            if ( (tPtr->tmo) < (i_pcb->tmo) ) {
-                TAILQ_INSERT_BEFORE(i_pcb, tPtr, timerEntry);
-                insertLast = 0u;
-                break;
-            }
-        }
-        if( insertLast == 1u) {
-            ASSERT(i_pcb != tPtr );
-            TAILQ_INSERT_TAIL(& OS_SYS_PTR->timerHead,tPtr, timerEntry);
+        if ( delta < i_pcb->tmo ) {
+            i_pcb->tmo -= delta;
+            TAILQ_INSERT_BEFORE(i_pcb, tPtr, timerEntry);
+            insertLast = 0u;
+            break;
         }
+        delta -= i_pcb->tmo;
+    }
+    if( insertLast == 1u) {
+        TAILQ_INSERT_TAIL(& OS_SYS_PTR->timerHead,tPtr, timerEntry);
+    }
+    tPtr->tmo = delta;
+    tPtr->timerQueued = TRUE;
+
+    OS_SYS_PTR->timerQDepth++;
+    if( OS_SYS_PTR->timerQDepth > OS_SYS_PTR->timerQDepthMax ) {
+        OS_SYS_PTR->timerQDepthMax = OS_SYS_PTR->timerQDepth;
     }
 }
 
 boolean Os_TimerQIsPresent(OsTaskVarType *tPtr) {
-    boolean rv = FALSE;
-    OsTaskVarType *i_pcb;
-
     ASSERT(tPtr!=NULL_PTR);
 
-    TAILQ_FOREACH(i_pcb,& OS_SYS_PTR->timerHead,timerEntry) {
-        if( i_pcb == tPtr ) {
-            rv = TRUE;
-            break;
-        }
-    }
-    return rv;
+    return tPtr->timerQueued;
 }
 
 
@@ -511,13 +491,63 @@ OsTaskVarType * Os_TimerQFirst( void ) {
 }
 
 /**
- * Remove task from timer queue.
+ * Remove task from timer queue. Does nothing if the task is not in the
+ * queue, e.g. it has already been released by a timeout.
  * @param tPtr
  */
 void Os_TimerQRemove(OsTaskVarType *tPtr) {
+    OsTaskVarType *nextPtr;
 
-    tPtr->tmo = TMO_INFINITE;
-    TAILQ_REMOVE(&OS_SYS_PTR->timerHead, tPtr, timerEntry);
+    if( tPtr->timerQueued == TRUE ) {
+        /* Give our delta to the next task so its expiry is unchanged */
+        nextPtr = TAILQ_NEXT(tPtr, timerEntry);
+        if( nextPtr != NULL_PTR ) {
+            nextPtr->tmo += tPtr->tmo;
+        }
+        TAILQ_REMOVE(&OS_SYS_PTR->timerHead, tPtr, timerEntry);
+        tPtr->timerQueued = FALSE;
+        OS_SYS_PTR->timerQDepth--;
+    }
+}
+
+/**
+ * Release all tasks in the timer queue that have timed out at tick <now>.
+ * All ticks since the last call are accounted for, so a missed tick does
+ * not lose any timeout.
+ *
+ * @param now The current OS tick
+ */
+void Os_TimerQCheck( TickType now ) {
+    OsTaskVarType *pcbPtr;
+    TickType elapsed = now - OS_SYS_PTR->timerTick;
+    uint32 relCnt = 0u;
+
+    OS_SYS_PTR->timerTick = now;
+
+    while( !TAILQ_EMPTY(&OS_SYS_PTR->timerHead) ) {
+        pcbPtr = TAILQ_FIRST(&OS_SYS_PTR->timerHead);
+        if( pcbPtr->tmo > elapsed ) {
+            pcbPtr->tmo -= elapsed;
+            break;
+        }
+        elapsed -= pcbPtr->tmo;
+        pcbPtr->tmo = 0u;
+
+        OS_DEBUG(D_TASK,"Timeout, released %s\n",pcbPtr->constPtr->name);
+
+        ASSERT( (pcbPtr->state & (ST_SLEEPING|ST_WAIT_SEM)) != 0  );
+
+        /* We have timeout, so remove the task from the timer queue and make ready   */
+        pcbPtr->rv = E_OS_TIMEOUT;
+        Os_TimerQRemove(pcbPtr);
+        /* ... and add to the ready queue */
+        Os_TaskMakeReady(pcbPtr);
+        relCnt++;
+    }
+
+    if( relCnt > OS_SYS_PTR->timerQRelMax ) {
+        OS_SYS_PTR->timerQRelMax = relCnt;
+    }
 }
 
 
@@ -530,13 +560,9 @@ StatusType Os_DispatchToSleepWithTmo( OpType op, TickType tmo) {
     ASSERT(tmo != 0);
     /* Check if there is a dispatch lock */
     if ( Os_SchedulerResourceIsFree() ) {
-        TickType now;
-
         currPcbPtr->tmoVal = tmo;
         if( tmo != TMO_INFINITE) {
-            now = GetOsTick();
-            currPcbPtr->tmo = now + tmo;
-            Os_TimerQInsertSorted(currPcbPtr );
+            Os_TimerQInsertSorted(currPcbPtr, tmo);
         }
 
         currPcbPtr->rv = E_OK;
@@ -107,8 +107,10 @@ typedef struct OsTaskVar {
     uint32       	regs[16]; 					/* NOTE: Arch specific regs .. make space for them later...*/
 #if defined(CFG_KERNEL_EXTRA)
     TAILQ_ENTRY(OsTaskVar) timerEntry;
-    /* Absolute timeout in ticks */
+    /* Timeout in ticks after the previous task in the timer queue */
     TickType        tmo;
+    /* TRUE while in the timer queue */
+    boolean         timerQueued;
     /* Set timeout value */
     TickType        tmoVal;
 
@@ -197,6 +199,120 @@ static inline void Os_TaskMakeRunning( OsTaskVarType *pcb ) {
     pcb->state = ST_RUNNING;
 }
 
+/**
+ * Map a priority to a ready queue level
+ */
+static inline uint32 Os_ReadyQLevel( OsPriorityType prio ) {
+    return (prio < (OS_READY_PRIO_CNT - 1u)) ? (uint32)prio : (OS_READY_PRIO_CNT - 1u);
+}
+
+/**
+ * Index of the most significant bit set in a non-zero ready_map word
+ */
+static inline uint32 Os_ReadyMapMsb( uint32 map ) {
+#if defined(__GNUC__)
+    return 31u - (uint32)__builtin_clz(map);
+#else
+    uint32 n = 0u;
+    if( (map & 0xffff0000UL) != 0u ) { n += 16u; map >>= 16u; }
+    if( (map & 0x0000ff00UL) != 0u ) { n += 8u;  map >>= 8u; }
+    if( (map & 0x000000f0UL) != 0u ) { n += 4u;  map >>= 4u; }
+    if( (map & 0x0000000cUL) != 0u ) { n += 2u;  map >>= 2u; }
+    if( (map & 0x00000002UL) != 0u ) { n += 1u; }
+    return n;
+#endif
+}
+
+/**
+ * Add task to the ready queue of the current core.
+ *
+ * @param pcb   Ptr to the task
+ * @param first TRUE to put the task first among tasks with the same priority,
+ *              FALSE to put it last.
+ */
+static inline void Os_ReadyQInsert( OsTaskVarType *pcb, boolean first ) {
+    Os_SysType *sysPtr = OS_SYS_PTR;
+    uint32 level = Os_ReadyQLevel(pcb->activePriority);
+
+    if( first == TRUE ) {
+        /*lint -e{9036} MISRA:EXTERNAL_FILE::[MISRA 2012 Rule 14.4, required] */
+        TAILQ_INSERT_HEAD(&sysPtr->ready_head[level],pcb,ready_list);
+    } else {
+        /*lint -e{9036} MISRA:EXTERNAL_FILE::[MISRA 2012 Rule 14.4, required] */
+        TAILQ_INSERT_TAIL(&sysPtr->ready_head[level],pcb,ready_list);
+    }
+    sysPtr->ready_map[level >> 5u] |= (1UL << (level & 31u));
+}
+
+/**
+ * Remove task from the ready queue of the current core.
+ *
+ * @param pcb Ptr to the task
+ */
+static inline void Os_ReadyQDelete( OsTaskVarType *pcb ) {
+    Os_SysType *sysPtr = OS_SYS_PTR;
+    uint32 level = Os_ReadyQLevel(pcb->activePriority);
+
+    /*lint -e{9012, 9036} MISRA:EXTERNAL_FILE::[MISRA 2012 Rule 15.6, required], [MISRA 2012 Rule 14.4, required] */
+    TAILQ_REMOVE(&sysPtr->ready_head[level],pcb,ready_list);
+    if( TAILQ_EMPTY(&sysPtr->ready_head[level]) ) {
+        sysPtr->ready_map[level >> 5u] &= ~(1UL << (level & 31u));
+    }
+}
+
+/**
+ * Get the top priority task in the ready queue of the current core,
+ * the running task included. Among tasks with the same priority the
+ * first one in the queue is selected.
+ *
+ * @return Ptr to the task, NULL_PTR if the queue is empty
+ */
+static inline OsTaskVarType *Os_ReadyQTop( void ) {
+    Os_SysType *sysPtr = OS_SYS_PTR;
+    OsTaskVarType *topPtr = NULL_PTR;
+    OsTaskVarType *iPtr;
+    uint32 word = OS_READY_MAP_WORDS;
+    uint32 level;
+
+    while( word > 0u ) {
+        word--;
+        if( sysPtr->ready_map[word] != 0u ) {
+            level = (word << 5u) + Os_ReadyMapMsb(sysPtr->ready_map[word]);
+            topPtr = TAILQ_FIRST(&sysPtr->ready_head[level]);
+
+            /* The last level holds all priorities above it, find the highest */
+            if( level == (OS_READY_PRIO_CNT - 1u) ) {
+                /*lint -e{9036} MISRA:EXTERNAL_FILE::[MISRA 2012 Rule 14.4, required] */
+                TAILQ_FOREACH(iPtr,&sysPtr->ready_head[level],ready_list) {
+                    if( iPtr->activePriority > topPtr->activePriority ) {
+                        topPtr = iPtr;
+                    }
+                }
+            }
+            break;
+        }
+    }
+    return topPtr;
+}
+
+/**
+ * Change the active priority of a task. A task in the ready queue is moved
+ * first among the tasks with its new priority so that the running task keeps
+ * the CPU when it raises or lowers its priority through a resource.
+ *
+ * @param pcbPtr Ptr to the task
+ * @param prio   The new priority
+ */
+static inline void Os_TaskSetActivePriority( OsTaskVarType *pcbPtr, OsPriorityType prio ) {
+    if( (pcbPtr->state & (ST_READY | ST_RUNNING)) != 0u ) {
+        Os_ReadyQDelete(pcbPtr);
+        pcbPtr->activePriority = prio;
+        Os_ReadyQInsert(pcbPtr,TRUE);
+    } else {
+        pcbPtr->activePriority = prio;
+    }
+}
+
 static inline OsTaskVarType * Os_TaskGet( TaskType pid ) {
     return &Os_TaskVarList[pid];
 }
@@ -224,7 +340,7 @@ static inline void Os_TaskResourceAdd( OsResourceType *rPtr, OsTaskVarType *pcbP
     /* Save old task prio in resource and set new task prio */
     rPtr->owner = pcbPtr->constPtr->pid;
     rPtr->old_task_prio = pcbPtr->activePriority;
-    pcbPtr->activePriority = rPtr->ceiling_priority;
+    Os_TaskSetActivePriority(pcbPtr,rPtr->ceiling_priority);
 
     if( rPtr->type != RESOURCE_TYPE_INTERNAL ) {
         TAILQ_INSERT_TAIL(&pcbPtr->resourceHead, rPtr, listEntry);
@@ -239,7 +355,7 @@ static inline void Os_TaskResourceAdd( OsResourceType *rPtr, OsTaskVarType *pcbP
 static inline  void Os_TaskResourceRemove( OsResourceType *rPtr , OsTaskVarType *pcbPtr) {
     ASSERT( rPtr->owner == pcbPtr->constPtr->pid );
     rPtr->owner = NO_TASK_OWNER;
-    pcbPtr->activePriority = rPtr->old_task_prio;
+    Os_TaskSetActivePriority(pcbPtr,rPtr->old_task_prio);
 
     if( rPtr->type != RESOURCE_TYPE_INTERNAL ) {
         /* The list can't be empty here */
@@ -334,7 +450,7 @@ static inline _Bool Os_TaskOccupiesSpinlocks( OsTaskVarType *pcb ) {
 }
 #endif //OS_NUM_CORES > 1
 
-void Os_TimerQInsertSorted(OsTaskVarType *tPtr);
+void Os_TimerQInsertSorted(OsTaskVarType *tPtr, TickType tmo);
 boolean Os_TimerQIsPresent(OsTaskVarType *tPtr);
 
 /**
@@ -355,5 +471,11 @@ OsTaskVarType * Os_TimerQFirst( void );
  */
 void Os_TimerQRemove(OsTaskVarType *tPtr);
 
+/**
+ * Release all timed out tasks, called from the OS tick.
+ * @param now
+ */
+void Os_TimerQCheck( TickType now );
+
 
 #endif /*TASK_I_H_*/
@@ -25,6 +25,9 @@
 
 /* @req SWS_BSW_00024 Include AUTOSAR Standard Types Header in implementation header */
 #include "Std_Types.h"
+#if defined(USE_STRACE)
+#include "strace.h"
+#endif
 
 #define SCHM_MODULE_ID            130u
 #define SCHM_VENDOR_ID            60u
@@ -60,10 +63,18 @@ typedef struct  {
         SchM_InfoType SchM_Info_ ## _mod
 
 /* @req ARC_SWS_SchM_00008 */
+#if defined(USE_STRACE)
+#define SCHM_MAINFUNCTION(_mod,_func) \
+        if( (++SchM_Info_ ## _mod.timer % SCHM_MAINFUNCTION_CYCLE_ ## _mod )== 0 ) { \
+            STRACE_SCOPE(#_mod, _func); \
+            SchM_Info_ ## _mod.timer = 0; \
+        }
+#else
 #define SCHM_MAINFUNCTION(_mod,_func) \
         if( (++SchM_Info_ ## _mod.timer % SCHM_MAINFUNCTION_CYCLE_ ## _mod )== 0 ) { \
             _func; \
             SchM_Info_ ## _mod.timer = 0; \
         }
+#endif
 
 #endif /*SCHM_H_*/
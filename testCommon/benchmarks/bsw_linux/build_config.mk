@@ -0,0 +1,5 @@
+
+# The cases that need no configuration, see testCommon/src/bench_cases.c
+MOD_USE += CRC E2E
+
+include $(ROOTDIR)/testCommon/benchmarks_common.mk
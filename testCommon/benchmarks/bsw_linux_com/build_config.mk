@@ -0,0 +1,10 @@
+
+# Com on a hand written configuration, see config/Com_PbCfg.c. PduR is a
+# stub that accepts every transmission, Det is only included.
+MOD_USE += COM
+
+inc-y += $(ROOTDIR)/communication/PduR/inc
+inc-y += $(ROOTDIR)/diagnostic/Det/inc
+obj-y += PduR_Stub.o
+
+include $(ROOTDIR)/testCommon/benchmarks_common.mk
@@ -0,0 +1,37 @@
+/*-------------------------------- Arctic Core ------------------------------
+ * Copyright (C) 2013, ArcCore AB, Sweden, www.arccore.com.
+ * Contact: <contact@arccore.com>
+ *
+ * You may ONLY use this file:
+ * 1)if you have a valid commercial ArcCore license and then in accordance with
+ * the terms contained in the written license agreement between you and ArcCore,
+ * or alternatively
+ * 2)if you follow the terms found in GNU General Public License version 2 as
+ * published by the Free Software Foundation and appearing in the file
+ * LICENSE.GPL included in the packaging of this file or here
+ * <http://www.gnu.org/licenses/old-licenses/gpl-2.0.txt>
+ *-------------------------------- Arctic Core -----------------------------*/
+
+#ifndef COM_CFG_H_
+#define COM_CFG_H_
+
+#define COM_DEV_ERROR_DETECT                        STD_OFF
+#define COM_VERSION_INFO_API                        STD_OFF
+#define COM_IPDU_COUNTING_ENABLE                    STD_OFF
+#define COM_SIG_GATEWAY_ENABLE                      STD_OFF
+#define COM_OSEKNM_SUPPORT                          STD_OFF
+
+#define COM_N_SUPPORTED_IPDU_GROUPS                 4u
+#define COM_MAX_N_SUPPORTED_IPDU_COUNTERS           4u
+#define COM_MAX_N_SUPPORTED_GWSOURCE_DESCRIPTIONS   4u
+#define INVALID_GWSIGNAL_DESCRIPTION_HANDLE         0xFFFFu
+
+#define COM_MAX_BUFFER_SIZE                         128u
+#define COM_MAX_N_IPDUS                             16u
+#define COM_MAX_N_SIGNALS                           16u
+#define COM_MAX_N_GROUP_SIGNALS                     1u
+
+#define COM_INVALID_PDU_ID                          0xFFFFu
+#define COM_E_TOO_MANY_IPDU                         0x10u
+
+#endif /* COM_CFG_H_ */
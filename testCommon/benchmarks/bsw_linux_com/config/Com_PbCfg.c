@@ -0,0 +1,110 @@
+/*-------------------------------- Arctic Core ------------------------------
+ * Copyright (C) 2013, ArcCore AB, Sweden, www.arccore.com.
+ * Contact: <contact@arccore.com>
+ *
+ * You may ONLY use this file:
+ * 1)if you have a valid commercial ArcCore license and then in accordance with
+ * the terms contained in the written license agreement between you and ArcCore,
+ * or alternatively
+ * 2)if you follow the terms found in GNU General Public License version 2 as
+ * published by the Free Software Foundation and appearing in the file
+ * LICENSE.GPL included in the packaging of this file or here
+ * <http://www.gnu.org/licenses/old-licenses/gpl-2.0.txt>
+ *-------------------------------- Arctic Core -----------------------------*/
+
+/*
+ * Hand written Com configuration of the Com benchmarks.
+ *
+ * Tx0..Tx2 are direct IPdus of three 8 bit signals each, with pending,
+ * triggered and triggered on change signals, for the send cases. Rx0 holds
+ * the signal of com_receive_signal. Periodic0..3 are periodic IPdus that
+ * keep Com_MainFunctionTx busy. All IPdus are in IPdu group 0.
+ */
+
+#include "Com.h"
+
+#define BENCH_SIG(_id, _pos, _prop, _ipdu) \
+    { .ComBitPosition = (_pos), .ComBitSize = 8u, .ComHandleId = (_id), \
+      .ComSignalEndianess = COM_LITTLE_ENDIAN, .ComSignalInitValue = benchComInit, \
+      .ComSignalType = COM_UINT8, .ComTransferProperty = (_prop), \
+      .ComRxDataTimeoutAction = COM_TIMEOUT_DATA_ACTION_NONE, \
+      .ComTimeoutNotification = COM_NO_FUNCTION_CALLOUT, .ComNotification = COM_NO_FUNCTION_CALLOUT, \
+      .ComErrorNotification = COM_NO_FUNCTION_CALLOUT, .ComIPduHandleId = (_ipdu), .Com_Arc_EOL = 0u }
+
+#define BENCH_IPDU_CALLOUTS \
+    .ComRxIPduCallout = COM_NO_FUNCTION_CALLOUT, .ComTxIPduCallout = COM_NO_FUNCTION_CALLOUT, \
+    .ComTriggerTransmitIPduCallout = COM_NO_FUNCTION_CALLOUT
+
+#define BENCH_IPDU_DIRECT(_id, _signals, _reps) \
+    { BENCH_IPDU_CALLOUTS, .ArcIPduOutgoingId = (_id), .ComIPduSignalProcessing = COM_IMMEDIATE, \
+      .ComIPduSize = 8u, .ComIPduDirection = COM_SEND, .ComIPduGroupRefs = benchComGroupRefs, \
+      .ComTxIPdu = { .ComTxModeTrue = { .ComTxModeMode = COM_DIRECT, .ComTxModeNumberOfRepetitions = (_reps), \
+                                        .ComTxModeRepetitionPeriodFactor = 2u }, \
+                     .ComTxModeFalse = { .ComTxModeMode = COM_DIRECT } }, \
+      .ComIPduSignalRef = (_signals), .Com_Arc_EOL = 0u }
+
+#define BENCH_IPDU_PERIODIC(_id, _signals, _period) \
+    { BENCH_IPDU_CALLOUTS, .ArcIPduOutgoingId = (_id), .ComIPduSignalProcessing = COM_IMMEDIATE, \
+      .ComIPduSize = 8u, .ComIPduDirection = COM_SEND, .ComIPduGroupRefs = benchComGroupRefs, \
+      .ComTxIPdu = { .ComTxModeTrue = { .ComTxModeMode = COM_PERIODIC, .ComTxModeTimePeriodFactor = (_period) }, \
+                     .ComTxModeFalse = { .ComTxModeMode = COM_PERIODIC, .ComTxModeTimePeriodFactor = (_period) } }, \
+      .ComIPduSignalRef = (_signals), .Com_Arc_EOL = 0u }
+
+static const uint8 benchComInit[8] = { 0u };
+
+static const ComIPduGroup_type benchComGroupRefs[] = {
+    { .ComIPduGroupHandleId = 0u, .Com_Arc_EOL = 0u },
+    { .Com_Arc_EOL = 1u }
+};
+
+static const ComSignal_type benchComSignals[];
+
+static const ComSignal_type * const benchComTx0Signals[] = { &benchComSignals[0], &benchComSignals[1], &benchComSignals[2], NULL };
+static const ComSignal_type * const benchComTx1Signals[] = { &benchComSignals[3], &benchComSignals[4], &benchComSignals[5], NULL };
+static const ComSignal_type * const benchComTx2Signals[] = { &benchComSignals[6], &benchComSignals[7], &benchComSignals[8], NULL };
+static const ComSignal_type * const benchComRx0Signals[] = { &benchComSignals[9], NULL };
+static const ComSignal_type * const benchComPeriodic0Signals[] = { &benchComSignals[10], NULL };
+static const ComSignal_type * const benchComPeriodic1Signals[] = { &benchComSignals[11], NULL };
+static const ComSignal_type * const benchComPeriodic2Signals[] = { &benchComSignals[12], NULL };
+static const ComSignal_type * const benchComPeriodic3Signals[] = { &benchComSignals[13], NULL };
+
+static const ComSignal_type benchComSignals[] = {
+    BENCH_SIG(ComConf_ComSignal_Tx0_Pending,   0u,  COM_PENDING,                                 ComConf_ComIPdu_Tx0),
+    BENCH_SIG(ComConf_ComSignal_Tx0_OnChange,  8u,  COM_TRIGGERED_ON_CHANGE,                     ComConf_ComIPdu_Tx0),
+    BENCH_SIG(ComConf_ComSignal_Tx0_OnChange2, 16u, COM_TRIGGERED_ON_CHANGE,                     ComConf_ComIPdu_Tx0),
+    BENCH_SIG(ComConf_ComSignal_Tx1_Pending,   0u,  COM_PENDING,                                 ComConf_ComIPdu_Tx1),
+    BENCH_SIG(ComConf_ComSignal_Tx1_Pending2,  8u,  COM_PENDING,                                 ComConf_ComIPdu_Tx1),
+    BENCH_SIG(ComConf_ComSignal_Tx1_Triggered, 16u, COM_TRIGGERED_WITHOUT_REPETITION,            ComConf_ComIPdu_Tx1),
+    BENCH_SIG(ComConf_ComSignal_Tx2_Pending,   0u,  COM_PENDING,                                 ComConf_ComIPdu_Tx2),
+    BENCH_SIG(ComConf_ComSignal_Tx2_OnChange,  8u,  COM_TRIGGERED_ON_CHANGE_WITHOUT_REPETITION,  ComConf_ComIPdu_Tx2),
+    BENCH_SIG(ComConf_ComSignal_Tx2_Pending2,  16u, COM_PENDING,                                 ComConf_ComIPdu_Tx2),
+    BENCH_SIG(ComConf_ComSignal_Rx0,           0u,  COM_PENDING,                                 ComConf_ComIPdu_Rx0),
+    BENCH_SIG(ComConf_ComSignal_Periodic0,     0u,  COM_PENDING,                                 ComConf_ComIPdu_Periodic0),
+    BENCH_SIG(ComConf_ComSignal_Periodic1,     0u,  COM_PENDING,                                 ComConf_ComIPdu_Periodic1),
+    BENCH_SIG(ComConf_ComSignal_Periodic2,     0u,  COM_PENDING,                                 ComConf_ComIPdu_Periodic2),
+    BENCH_SIG(ComConf_ComSignal_Periodic3,     0u,  COM_PENDING,                                 ComConf_ComIPdu_Periodic3),
+    { .Com_Arc_EOL = 1u }
+};
+
+static const ComIPdu_type benchComIPdus[] = {
+    BENCH_IPDU_DIRECT(ComConf_ComIPdu_Tx0, benchComTx0Signals, 3u),
+    BENCH_IPDU_DIRECT(ComConf_ComIPdu_Tx1, benchComTx1Signals, 0u),
+    BENCH_IPDU_DIRECT(ComConf_ComIPdu_Tx2, benchComTx2Signals, 0u),
+    { BENCH_IPDU_CALLOUTS, .ComIPduSignalProcessing = COM_IMMEDIATE, .ComIPduSize = 8u,
+      .ComIPduDirection = COM_RECEIVE, .ComIPduGroupRefs = benchComGroupRefs,
+      .ComIPduSignalRef = benchComRx0Signals, .Com_Arc_EOL = 0u },
+    BENCH_IPDU_PERIODIC(ComConf_ComIPdu_Periodic0, benchComPeriodic0Signals, 10u),
+    BENCH_IPDU_PERIODIC(ComConf_ComIPdu_Periodic1, benchComPeriodic1Signals, 20u),
+    BENCH_IPDU_PERIODIC(ComConf_ComIPdu_Periodic2, benchComPeriodic2Signals, 40u),
+    BENCH_IPDU_PERIODIC(ComConf_ComIPdu_Periodic3, benchComPeriodic3Signals, 80u),
+    { .Com_Arc_EOL = 1u }
+};
+
+const Com_ConfigType ComConfiguration = {
+    .ComConfigurationId = 1u,
+    .ComNofIPdus = 8u,
+    .ComNofSignals = 14u,
+    .ComNofGroupSignals = 0u,
+    .ComIPdu = benchComIPdus,
+    .ComSignal = benchComSignals,
+};
@@ -0,0 +1,44 @@
+/*-------------------------------- Arctic Core ------------------------------
+ * Copyright (C) 2013, ArcCore AB, Sweden, www.arccore.com.
+ * Contact: <contact@arccore.com>
+ *
+ * You may ONLY use this file:
+ * 1)if you have a valid commercial ArcCore license and then in accordance with
+ * the terms contained in the written license agreement between you and ArcCore,
+ * or alternatively
+ * 2)if you follow the terms found in GNU General Public License version 2 as
+ * published by the Free Software Foundation and appearing in the file
+ * LICENSE.GPL included in the packaging of this file or here
+ * <http://www.gnu.org/licenses/old-licenses/gpl-2.0.txt>
+ *-------------------------------- Arctic Core -----------------------------*/
+
+#ifndef COM_PBCFG_H_
+#define COM_PBCFG_H_
+
+/* IPdu ids, see Com_PbCfg.c */
+#define ComConf_ComIPdu_Tx0             0u  /* Direct, 3 repetitions */
+#define ComConf_ComIPdu_Tx1             1u  /* Direct */
+#define ComConf_ComIPdu_Tx2             2u  /* Direct */
+#define ComConf_ComIPdu_Rx0             3u
+#define ComConf_ComIPdu_Periodic0       4u  /* Periodic, 10..80 ticks */
+#define ComConf_ComIPdu_Periodic1       5u
+#define ComConf_ComIPdu_Periodic2       6u
+#define ComConf_ComIPdu_Periodic3       7u
+
+/* Signal ids, three 8 bit signals per IPdu */
+#define ComConf_ComSignal_Tx0_Pending   0u
+#define ComConf_ComSignal_Tx0_OnChange  1u
+#define ComConf_ComSignal_Tx0_OnChange2 2u
+#define ComConf_ComSignal_Tx1_Pending   3u
+#define ComConf_ComSignal_Tx1_Pending2  4u
+#define ComConf_ComSignal_Tx1_Triggered 5u
+#define ComConf_ComSignal_Tx2_Pending   6u
+#define ComConf_ComSignal_Tx2_OnChange  7u
+#define ComConf_ComSignal_Tx2_Pending2  8u
+#define ComConf_ComSignal_Rx0           9u
+#define ComConf_ComSignal_Periodic0     10u
+#define ComConf_ComSignal_Periodic1     11u
+#define ComConf_ComSignal_Periodic2     12u
+#define ComConf_ComSignal_Periodic3     13u
+
+#endif /* COM_PBCFG_H_ */
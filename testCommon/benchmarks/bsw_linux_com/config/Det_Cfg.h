@@ -0,0 +1,23 @@
+/*-------------------------------- Arctic Core ------------------------------
+ * Copyright (C) 2013, ArcCore AB, Sweden, www.arccore.com.
+ * Contact: <contact@arccore.com>
+ *
+ * You may ONLY use this file:
+ * 1)if you have a valid commercial ArcCore license and then in accordance with
+ * the terms contained in the written license agreement between you and ArcCore,
+ * or alternatively
+ * 2)if you follow the terms found in GNU General Public License version 2 as
+ * published by the Free Software Foundation and appearing in the file
+ * LICENSE.GPL included in the packaging of this file or here
+ * <http://www.gnu.org/licenses/old-licenses/gpl-2.0.txt>
+ *-------------------------------- Arctic Core -----------------------------*/
+
+#ifndef DET_CFG_H_
+#define DET_CFG_H_
+
+/* Com includes Det.h, the benchmark configurations don't report to Det */
+#define DET_ENABLE_CALLBACKS    STD_OFF
+#define DET_DEINIT_API          STD_OFF
+#define DET_VERSIONINFO_API     STD_OFF
+
+#endif /* DET_CFG_H_ */
@@ -0,0 +1,33 @@
+/*-------------------------------- Arctic Core ------------------------------
+ * Copyright (C) 2013, ArcCore AB, Sweden, www.arccore.com.
+ * Contact: <contact@arccore.com>
+ *
+ * You may ONLY use this file:
+ * 1)if you have a valid commercial ArcCore license and then in accordance with
+ * the terms contained in the written license agreement between you and ArcCore,
+ * or alternatively
+ * 2)if you follow the terms found in GNU General Public License version 2 as
+ * published by the Free Software Foundation and appearing in the file
+ * LICENSE.GPL included in the packaging of this file or here
+ * <http://www.gnu.org/licenses/old-licenses/gpl-2.0.txt>
+ *-------------------------------- Arctic Core -----------------------------*/
+
+#ifndef PDUR_CFG_H_
+#define PDUR_CFG_H_
+
+/* Only what Com needs from PduR, the benchmark links stubs/PduR_Stub.c */
+#define PDUR_DEV_ERROR_DETECT       STD_OFF
+#define PDUR_ZERO_COST_OPERATION    STD_OFF
+#define PDUR_COM_SUPPORT            STD_ON
+#define PDUR_CANIF_SUPPORT          STD_OFF
+#define PDUR_CANNM_SUPPORT          STD_OFF
+#define PDUR_UDPNM_SUPPORT          STD_OFF
+#define PDUR_LINIF_SUPPORT          STD_OFF
+#define PDUR_CANTP_SUPPORT          STD_OFF
+#define PDUR_J1939TP_SUPPORT        STD_OFF
+#define PDUR_DCM_SUPPORT            STD_OFF
+#define PDUR_SOAD_SUPPORT           STD_OFF
+#define PDUR_DOIP_SUPPORT           STD_OFF
+#define PDUR_IPDUM_SUPPORT          STD_OFF
+
+#endif /* PDUR_CFG_H_ */
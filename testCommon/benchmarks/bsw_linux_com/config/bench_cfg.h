@@ -0,0 +1,40 @@
+/*-------------------------------- Arctic Core ------------------------------
+ * Copyright (C) 2013, ArcCore AB, Sweden, www.arccore.com.
+ * Contact: <contact@arccore.com>
+ *
+ * You may ONLY use this file:
+ * 1)if you have a valid commercial ArcCore license and then in accordance with
+ * the terms contained in the written license agreement between you and ArcCore,
+ * or alternatively
+ * 2)if you follow the terms found in GNU General Public License version 2 as
+ * published by the Free Software Foundation and appearing in the file
+ * LICENSE.GPL included in the packaging of this file or here
+ * <http://www.gnu.org/licenses/old-licenses/gpl-2.0.txt>
+ *-------------------------------- Arctic Core -----------------------------*/
+
+#ifndef BENCH_CFG_H_
+#define BENCH_CFG_H_
+
+#include "Com.h"
+
+extern const Com_ConfigType ComConfiguration;
+
+#define BENCH_COM_TX_SIGNAL_ID      ComConf_ComSignal_Tx0_Pending
+#define BENCH_COM_RX_SIGNAL_ID      ComConf_ComSignal_Rx0
+/* Three signals of each Tx IPdu in mixed order */
+#define BENCH_COM_BATCH_SIGNALS \
+    ComConf_ComSignal_Tx0_Pending, ComConf_ComSignal_Tx1_Pending, ComConf_ComSignal_Tx2_Pending, \
+    ComConf_ComSignal_Tx0_OnChange, ComConf_ComSignal_Tx1_Pending2, ComConf_ComSignal_Tx2_OnChange, \
+    ComConf_ComSignal_Tx0_OnChange2, ComConf_ComSignal_Tx1_Triggered, ComConf_ComSignal_Tx2_Pending2
+
+/* Com with IPdu group 0, all IPdus, started */
+#define BENCH_INIT() \
+    do { \
+        Com_IpduGroupVector benchGroups; \
+        Com_Init(&ComConfiguration); \
+        Com_ClearIpduGroupVector(benchGroups); \
+        Com_SetIpduGroup(benchGroups, 0u, TRUE); \
+        Com_IpduGroupControl(benchGroups, TRUE); \
+    } while (0)
+
+#endif /* BENCH_CFG_H_ */
@@ -0,0 +1,40 @@
+
+###
+# Host micro-benchmarks of the BSW hot paths, see testCommon/inc/bench.h.
+#
+# Included from the build_config.mk of a benchmark project built for the
+# linux board, see testCommon/benchmarks/bsw_linux:
+#
+#   <project>/makefile               PROJECTNAME, include project_defaults.mk
+#   <project>/build_config.mk        MOD_USE += ..., include this file
+#   <project>/config/bench_cfg.h     BENCH_INIT() and the ids of the cases
+#   <project>/config/                module configuration
+#   <project>/stubs/                 lower layer stubs
+#
+# The binary prints one JSON object per case, see bench.h. An argument
+# selects the cases whose name contains it.
+###
+
+CFG_STANDARD_NEWLIB:=y
+
+# === Benchmark runner and cases ===
+VPATH += $(ROOTDIR)/testCommon/src
+inc-y += $(ROOTDIR)/testCommon/inc
+obj-y += bench.o
+obj-y += bench_cases.o
+
+# === Project specific configuration files ===
+# The more precise configuration, the higher preceedance.
+VPATH := ../config/$(board_name) ../config ../stubs ../utils $(VPATH)
+inc-y := $(inc-pre-y) ../config/$(board_name) ../config ../stubs ../utils $(inc-y)
+
+# === Project specific object files ===
+PROJECT_C_FILES=$(notdir $(wildcard ../*.c))
+obj-y += $(PROJECT_C_FILES:%.c=%.o)
+VPATH += ..
+
+# Timings are only meaningful optimized
+SELECT_OPT?=OPT_RELEASE
+
+# === Module includes ===
+include $(ROOTDIR)/testCommon/module_includes.mk
@@ -0,0 +1,62 @@
+/*-------------------------------- Arctic Core ------------------------------
+ * Copyright (C) 2013, ArcCore AB, Sweden, www.arccore.com.
+ * Contact: <contact@arccore.com>
+ *
+ * You may ONLY use this file:
+ * 1)if you have a valid commercial ArcCore license and then in accordance with
+ * the terms contained in the written license agreement between you and ArcCore,
+ * or alternatively
+ * 2)if you follow the terms found in GNU General Public License version 2 as
+ * published by the Free Software Foundation and appearing in the file
+ * LICENSE.GPL included in the packaging of this file or here
+ * <http://www.gnu.org/licenses/old-licenses/gpl-2.0.txt>
+ *-------------------------------- Arctic Core -----------------------------*/
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+/*
+ * Host micro-benchmarks for the linux board, see testCommon/benchmarks_common.mk.
+ *
+ * Each case is run BENCH_WARMUP times untimed and then a fixed number of
+ * iterations, each iteration timed on its own with CLOCK_MONOTONIC. The timer
+ * overhead, measured at start-up, is subtracted. Results are printed as one
+ * JSON object per line:
+ *
+ *   {"bench":"crc32_64b","iterations":100000,"ns_per_op":41.2,
+ *    "p50":40,"p90":44,"p99":61,"p999":190,"max":5210}
+ *
+ * The BSW cases in bench_cases.c are built when the module is used and the
+ * test project's bench_cfg.h defines the ids the case needs. Projects where
+ * the Os owns main() define BENCH_NO_MAIN in bench_cfg.h and call Bench_Run()
+ * with Bench_BswCases from a task.
+ */
+
+#include "Std_Types.h"
+
+#if !defined(BENCH_ITERATIONS)
+#define BENCH_ITERATIONS    100000uL
+#endif
+#if !defined(BENCH_WARMUP)
+#define BENCH_WARMUP        1000uL
+#endif
+
+typedef struct {
+    const char *name;
+    void (*setup)(void);            /* Optional, before warm-up */
+    void (*run)(uint32 iteration);  /* One operation */
+    void (*teardown)(void);         /* Optional */
+    uint32 iterations;              /* 0 = BENCH_ITERATIONS */
+} Bench_CaseType;
+
+/* Run the cases and print the results. Returns the number of failed cases. */
+uint32 Bench_Run(const Bench_CaseType *cases, uint32 caseCnt);
+
+/* Mark the running case as failed, e.g. when the API returns an error. */
+void Bench_Fail(const char *reason);
+
+/* The BSW cases of bench_cases.c */
+extern const Bench_CaseType Bench_BswCases[];
+extern const uint32 Bench_BswCaseCnt;
+
+#endif /* BENCH_H_ */
@@ -0,0 +1,130 @@
+
+###
+# Include paths of the used modules, shared by tests_common.mk and
+# benchmarks_common.mk.
+###
+
+ifeq (USE_LINSM, $(findstring USE_LINSM,$(def-y)))
+inc-y += $(ROOTDIR)/communication/LinSM/inc 
+endif
+
+ifeq (USE_LINIF, $(findstring USE_LINIF,$(def-y)))
+inc-y += $(ROOTDIR)/communication/LinIf/inc 
+endif
+
+ifeq (USE_CANSM, $(findstring USE_CANSM,$(def-y)))
+inc-y += $(ROOTDIR)/communication/CanSM/inc 
+endif
+
+ifeq (USE_CANIF, $(findstring USE_CANIF,$(def-y)))
+inc-y += $(ROOTDIR)/communication/CanIf/inc 
+endif
+
+ifeq (USE_LIN, $(findstring USE_LIN,$(def-y)))
+inc-y += $(ROOTDIR)/mcal/Lin/inc 
+endif
+
+ifeq (USE_SPI, $(findstring USE_SPI,$(def-y)))
+inc-y += $(ROOTDIR)/mcal/Spi/inc 
+endif
+
+ifeq (USE_FRSM, $(findstring USE_FRSM,$(def-y)))
+inc-y += $(ROOTDIR)/communication/FrSM/inc 
+endif
+
+ifeq (USE_ETHSM, $(findstring USE_ETHSM,$(def-y)))
+inc-y += $(ROOTDIR)/communication/EthSM/inc 
+endif
+
+ifeq (USE_ETH, $(findstring USE_ETH,$(def-y)))
+inc-y += $(ROOTDIR)/mcal/Eth/inc 
+endif
+
+ifeq (USE_NM, $(findstring USE_NM,$(def-y)))
+inc-y += $(ROOTDIR)/communication/Nm/inc 
+endif
+
+ifeq (USE_ECUM, $(findstring USE_ECUM,$(def-y)))
+inc-y += $(ROOTDIR)/system/EcuM/inc 
+endif
+
+ifeq (USE_DEM, $(findstring USE_DEM,$(def-y)))
+inc-y += $(ROOTDIR)/diagnostic/Dem/inc 
+endif
+
+ifeq (USE_COM, $(findstring USE_COM,$(def-y)))
+inc-y += $(ROOTDIR)/communication/Com/inc 
+endif
+
+ifeq (USE_COMM, $(findstring USE_COMM,$(def-y)))
+inc-y += $(ROOTDIR)/communication/ComM/inc 
+endif
+
+ifeq (USE_PDUR, $(findstring USE_PDUR,$(def-y)))
+inc-y += $(ROOTDIR)/communication/PduR/inc
+inc-y += $(ROOTDIR)/communication/Com/inc 
+endif
+
+ifeq (USE_SD, $(findstring USE_SD,$(def-y)))
+inc-y += $(ROOTDIR)/communication/SD/inc 
+endif
+
+ifeq (USE_TCPIP, $(findstring USE_TCPIP,$(def-y)))
+inc-y += $(ROOTDIR)/communication/TcpIp/inc 
+endif
+
+ifeq (USE_SOAD, $(findstring USE_SOAD,$(def-y)))
+inc-y += $(ROOTDIR)/communication/SoAd/inc 
+endif
+
+
+ifeq (USE_DOIP, $(findstring USE_DOIP,$(def-y)))
+inc-y += $(ROOTDIR)/communication/DoIP/inc 
+endif
+
+ifeq (USE_DCM, $(findstring USE_DCM,$(def-y)))
+inc-y += $(ROOTDIR)/diagnostic/Dcm/inc 
+endif
+
+ifeq (USE_DET, $(findstring USE_DET,$(def-y)))
+inc-y += $(ROOTDIR)/diagnostic/Det/inc 
+endif
+
+ifeq (USE_NM, $(findstring USE_NM,$(def-y)))
+inc-y += $(ROOTDIR)/communication/Nm/inc 
+endif
+
+ifeq (USE_CANNM, $(findstring USE_CANNM,$(def-y)))
+inc-y += $(ROOTDIR)/communication/CanNm/inc 
+endif
+
+ifeq (USE_UDPNM, $(findstring USE_UDPNM,$(def-y)))
+inc-y += $(ROOTDIR)/communication/UdpNm/inc 
+endif
+
+ifeq (USE_CANTP, $(findstring USE_CANTP,$(def-y)))
+inc-y += $(ROOTDIR)/communication/CanTp/inc 
+endif
+
+
+ifeq (USE_MEMIF, $(findstring USE_MEMIF,$(def-y)))
+inc-y += $(ROOTDIR)/memory/Memif/inc 
+endif
+
+ifeq (USE_NVM, $(findstring USE_NVM,$(def-y)))
+inc-y += $(ROOTDIR)/memory/NvM/inc 
+endif
+
+ifeq (USE_Fee, $(findstring USE_FEE,$(def-y)))
+inc-y += $(ROOTDIR)/memory/Fee/inc 
+endif
+
+ifeq (USE_EA, $(findstring USE_EA,$(def-y)))
+inc-y += $(ROOTDIR)/memory/Ea/inc 
+endif
+
+
+ifeq (USE_BSWM, $(findstring USE_BSWM,$(def-y)))
+inc-y += $(ROOTDIR)/system/BswM/inc 
+endif
+
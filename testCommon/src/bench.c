@@ -0,0 +1,177 @@
+/*-------------------------------- Arctic Core ------------------------------
+ * Copyright (C) 2013, ArcCore AB, Sweden, www.arccore.com.
+ * Contact: <contact@arccore.com>
+ *
+ * You may ONLY use this file:
+ * 1)if you have a valid commercial ArcCore license and then in accordance with
+ * the terms contained in the written license agreement between you and ArcCore,
+ * or alternatively
+ * 2)if you follow the terms found in GNU General Public License version 2 as
+ * published by the Free Software Foundation and appearing in the file
+ * LICENSE.GPL included in the packaging of this file or here
+ * <http://www.gnu.org/licenses/old-licenses/gpl-2.0.txt>
+ *-------------------------------- Arctic Core -----------------------------*/
+
+
+/*
+ * Benchmark runner, see bench.h.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "bench.h"
+#include "bench_cfg.h"
+
+#if !defined(BENCH_INIT)
+#define BENCH_INIT()
+#endif
+
+#define BENCH_CALIB_CNT     10000uL
+
+static const char *benchFailReason;
+static uint32 benchOverhead_ns;
+static boolean benchCalibrated = FALSE;
+
+static inline uint64 bench_now(void) {
+    struct timespec ts;
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64)ts.tv_sec * 1000000000uLL) + (uint64)ts.tv_nsec;
+}
+
+static int bench_cmp(const void *a, const void *b) {
+    uint32 x = *(const uint32 *)a;
+    uint32 y = *(const uint32 *)b;
+    return (x > y) - (x < y);
+}
+
+/* Value at permille of the sorted samples (nearest rank) */
+static uint32 bench_percentile(const uint32 *sorted, uint32 cnt, uint32 permille) {
+    uint32 rank = (uint32)(((uint64)cnt * permille + 999uL) / 1000uL);
+    return sorted[(rank > 0u) ? (rank - 1u) : 0u];
+}
+
+/* Median cost of reading the clock twice, subtracted from every sample */
+static void bench_calibrate(void) {
+    uint32 *samples = malloc(BENCH_CALIB_CNT * sizeof(uint32));
+    uint32 i;
+
+    if (samples == NULL) {
+        return;
+    }
+    for (i = 0; i < BENCH_CALIB_CNT; i++) {
+        uint64 t0 = bench_now();
+        samples[i] = (uint32)(bench_now() - t0);
+    }
+    qsort(samples, BENCH_CALIB_CNT, sizeof(uint32), bench_cmp);
+    benchOverhead_ns = samples[BENCH_CALIB_CNT / 2u];
+    benchCalibrated = TRUE;
+    free(samples);
+}
+
+/* Print s as the contents of a JSON string */
+static void bench_print_json(const char *s) {
+    for (; *s != '\0'; s++) {
+        if ((*s == '"') || (*s == '\\')) {
+            printf("\\%c", *s);
+        } else if ((unsigned char)*s < 0x20u) {
+            printf("\\u%04x", (unsigned)(unsigned char)*s);
+        } else {
+            putchar(*s);
+        }
+    }
+}
+
+void Bench_Fail(const char *reason) {
+    if (benchFailReason == NULL) {
+        benchFailReason = reason;
+    }
+}
+
+static boolean bench_case(const Bench_CaseType *c) {
+    uint32 iterations = (c->iterations != 0u) ? c->iterations : BENCH_ITERATIONS;
+    uint32 *samples = malloc(iterations * sizeof(uint32));
+    uint64 total = 0;
+    uint32 i;
+
+    if (samples == NULL) {
+        printf("{\"bench\":\"%s\",\"error\":\"out of memory\"}\n", c->name);
+        return FALSE;
+    }
+
+    benchFailReason = NULL;
+    if (c->setup != NULL) {
+        c->setup();
+    }
+    for (i = 0; i < BENCH_WARMUP; i++) {
+        c->run(i);
+    }
+    for (i = 0; i < iterations; i++) {
+        uint64 t0 = bench_now();
+        uint64 dt;
+        c->run(i);
+        dt = bench_now() - t0;
+        dt = (dt > benchOverhead_ns) ? (dt - benchOverhead_ns) : 0u;
+        samples[i] = (dt > 0xFFFFFFFFuLL) ? 0xFFFFFFFFuL : (uint32)dt;
+        total += samples[i];
+    }
+    if (c->teardown != NULL) {
+        c->teardown();
+    }
+
+    if (benchFailReason != NULL) {
+        printf("{\"bench\":\"%s\",\"error\":\"", c->name);
+        bench_print_json(benchFailReason);
+        printf("\"}\n");
+        free(samples);
+        return FALSE;
+    }
+
+    qsort(samples, iterations, sizeof(uint32), bench_cmp);
+    printf("{\"bench\":\"%s\",\"iterations\":%lu,\"ns_per_op\":%.1f,"
+           "\"p50\":%lu,\"p90\":%lu,\"p99\":%lu,\"p999\":%lu,\"max\":%lu}\n",
+           c->name, (unsigned long)iterations, (double)total / (double)iterations,
+           (unsigned long)bench_percentile(samples, iterations, 500u),
+           (unsigned long)bench_percentile(samples, iterations, 900u),
+           (unsigned long)bench_percentile(samples, iterations, 990u),
+           (unsigned long)bench_percentile(samples, iterations, 999u),
+           (unsigned long)samples[iterations - 1u]);
+    free(samples);
+    return TRUE;
+}
+
+uint32 Bench_Run(const Bench_CaseType *cases, uint32 caseCnt) {
+    uint32 failed = 0;
+    uint32 i;
+
+    if (!benchCalibrated) {
+        bench_calibrate();
+    }
+    for (i = 0; i < caseCnt; i++) {
+        if (!bench_case(&cases[i])) {
+            failed++;
+        }
+    }
+    (void)fflush(stdout);
+    return failed;
+}
+
+#if !defined(BENCH_NO_MAIN)
+/* Usage: <binary> [case name filter] */
+int main(int argc, char **argv) {
+    uint32 failed = 0;
+    uint32 i;
+
+    BENCH_INIT();
+
+    bench_calibrate();
+    printf("{\"suite\":\"bsw\",\"timer_overhead_ns\":%lu}\n", (unsigned long)benchOverhead_ns);
+    for (i = 0; i < Bench_BswCaseCnt; i++) {
+        if ((argc < 2) || (strstr(Bench_BswCases[i].name, argv[1]) != NULL)) {
+            failed += Bench_Run(&Bench_BswCases[i], 1u);
+        }
+    }
+    return (failed != 0u) ? 1 : 0;
+}
+#endif
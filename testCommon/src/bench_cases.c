@@ -0,0 +1,750 @@
+/*-------------------------------- Arctic Core ------------------------------
+ * Copyright (C) 2013, ArcCore AB, Sweden, www.arccore.com.
+ * Contact: <contact@arccore.com>
+ *
+ * You may ONLY use this file:
+ * 1)if you have a valid commercial ArcCore license and then in accordance with
+ * the terms contained in the written license agreement between you and ArcCore,
+ * or alternatively
+ * 2)if you follow the terms found in GNU General Public License version 2 as
+ * published by the Free Software Foundation and appearing in the file
+ * LICENSE.GPL included in the packaging of this file or here
+ * <http://www.gnu.org/licenses/old-licenses/gpl-2.0.txt>
+ *-------------------------------- Arctic Core -----------------------------*/
+
+
+/*
+ * BSW hot path benchmarks.
+ *
+ * A case is built when its module is used and the test project's bench_cfg.h
+ * defines the configuration ids it needs:
+ *
+ *   Com        BENCH_COM_TX_SIGNAL_ID, BENCH_COM_RX_SIGNAL_ID
+ *              BENCH_COM_BATCH_SIGNALS  (comma separated signal ids)
+ *   PduR       BENCH_PDUR_ROUTING_PATH  (index into PduRConfig->RoutingPaths)
+ *   CanIf      BENCH_CANIF_HRH, BENCH_CANIF_CANID
+ *   CanTp      BENCH_CANTP_TX_SDU_ID, BENCH_CANTP_TX_PDU_ID, BENCH_CANTP_FC_PDU_ID
+ *   Dem        BENCH_DEM_EVENT_ID
+ *   Dcm        BENCH_DCM_RX_PDU_ID, BENCH_DCM_TX_PDU_ID, BENCH_DCM_DID
+ *   NvM        BENCH_NVM_BLOCK_ID
+ *   Os         BENCH_OS_EVENT_TASK_ID, BENCH_OS_EVENT_WAIT_TASK_ID
+ *              BENCH_OS_ALARM_ID, BENCH_OS_COUNTER_ID
+ *              BENCH_OS_TASK_ID, BENCH_OS_RESOURCE_ID
+ *   LinuxOs DB (USE_LINOS_DB) none, BENCH_DB_FILE to not use the default file
+ *
+ * Crc and E2E need no configuration. BENCH_INIT() in bench_cfg.h initializes
+ * the used modules, the lower layers are the project's stubs.
+ *
+ * Projects in testCommon/benchmarks:
+ *
+ *   bsw_linux       noop, cirqbuff_*, os_set_event*_mutex, crc32, e2e_p04_protect
+ *   bsw_linux_com   the Com cases on a hand written Com configuration
+ *
+ * The PduR, CanIf, CanTp, Dem, Dcm, NvM, Os, LinuxOs logger and DB cases
+ * need a project with a generated configuration of the module, or the Os,
+ * and are not built by these.
+ *
+ * com_main_function_tx is one Com_MainFunctionTx call with the IPdu groups
+ * started by BENCH_INIT(). Its cost depends on the Tx IPdus configured and
+ * how often they are due, run it on configurations with a growing number of
+ * Tx IPdus to see how it scales.
+ *
+ * com_send_signals/com_receive_signals pass BENCH_COM_BATCH_SIGNALS to
+ * Com_Arc_SendSignals/Com_Arc_ReceiveSignals in one call. List signals of a
+ * few IPdus in mixed order to measure the grouping per IPdu, and the same
+ * signals sorted by IPdu for the pass without it.
+ *
+ * os_set_event sets an event the task does not wait for, in LinuxOs the
+ * futex fast path that does not enter the kernel. os_set_event_wake sets the
+ * event BENCH_OS_EVENT_WAIT_TASK_ID loops on with WaitEvent/ClearEvent, so
+ * each call also wakes the waiter. The Os owns main(), so these projects
+ * define BENCH_NO_MAIN and call Bench_Run() from a task.
+ *
+ * os_set_event_mutex and os_set_event_wake_mutex are the same two operations
+ * on the mutex/condvar event path LinuxOs used before the futex one: lock,
+ * set the bits, signal the condition and unlock, the waiter blocks in
+ * pthread_cond_wait. They need no Os and run on every linux project, compare
+ * them with os_set_event/os_set_event_wake of the same run.
+ *
+ * os_alarm_set_cancel inserts BENCH_OS_ALARM_ID in the alarm wheel of its
+ * counter and removes it again. os_increment_counter is one tick of the
+ * software counter BENCH_OS_COUNTER_ID, give it many alarms with different
+ * expiry values to see that the tick only visits the due alarms.
+ *
+ * os_activate_task activates BENCH_OS_TASK_ID, a task of higher priority than
+ * the benchmark task that only terminates: ready queue insert, dispatch, top
+ * of the ready queue on terminate and back. os_get_release_resource requeues
+ * the benchmark task at the resource ceiling and back.
+ *
+ * logger_async is one logger() call with a literal format while the LinuxOs
+ * logger thread runs, the cost the calling task pays for a queued record.
+ * logger_sync is the same message formatted in the calling task, what
+ * logger() does without the logger thread and (logger)() always does. Both run with all logger outputs off to leave out syslog/stdout.
+ * So that no record is dropped logger_async waits for the logger thread
+ * every LOGGER_ASYNC_WAKE_FILL records, when the producer wakes it, these
+ * samples show in p99/max, compare the p50.
+ *
+ * db_set_register queues register writes to the write-behind buffer of the
+ * LinuxOs database, written by its background thread. db_set_register_merged
+ * writes the same register every time, merged in the buffer.
+ *
+ * The cirq_buffer cases push from the benchmark thread while a consumer
+ * thread drains the buffer and, for MPSC, other producer threads push too.
+ */
+
+#include <string.h>
+#if defined(__linux__)
+#include <pthread.h>
+#endif
+#include "bench.h"
+#include "cirq_buffer.h"
+#include "bench_cfg.h"
+#if defined(USE_COM) && (defined(BENCH_COM_TX_SIGNAL_ID) || defined(BENCH_COM_BATCH_SIGNALS))
+#include "Com.h"
+#endif
+#if defined(USE_PDUR) && defined(BENCH_PDUR_ROUTING_PATH)
+#include "PduR.h"
+#include "PduR_If.h"
+#endif
+#if defined(USE_CANIF) && defined(BENCH_CANIF_HRH)
+#include "CanIf.h"
+#include "CanIf_Cbk.h"
+#endif
+#if defined(USE_CANTP) && defined(BENCH_CANTP_TX_SDU_ID)
+#include "CanTp.h"
+#include "CanTp_Cbk.h"
+#endif
+#if defined(USE_DEM) && defined(BENCH_DEM_EVENT_ID)
+#include "Dem.h"
+#endif
+#if defined(USE_DCM) && defined(BENCH_DCM_RX_PDU_ID)
+#include "Dcm.h"
+#include "Dcm_Cbk.h"
+#endif
+#if defined(USE_NVM) && defined(BENCH_NVM_BLOCK_ID)
+#include "NvM.h"
+#endif
+#if (defined(USE_KERNEL) || defined(USE_LINUXOS)) && \
+    (defined(BENCH_OS_EVENT_TASK_ID) || defined(BENCH_OS_ALARM_ID) || defined(BENCH_OS_COUNTER_ID) || \
+     defined(BENCH_OS_TASK_ID) || defined(BENCH_OS_RESOURCE_ID))
+#include "Os.h"
+#endif
+#if defined(USE_LINOS_DB)
+#include <stdio.h>
+#include "database.h"
+#endif
+#if defined(USE_LINUXOS)
+#include <sched.h>
+#include "linos_logger.h"
+#endif
+#if defined(USE_CRC)
+#include "Crc.h"
+#endif
+#if defined(USE_E2E)
+#include "E2E_P04.h"
+#endif
+
+#if !defined(BENCH_CANTP_LENGTH)
+#define BENCH_CANTP_LENGTH      64u
+#endif
+#if !defined(BENCH_NVM_MAIN_MAX)
+#define BENCH_NVM_MAIN_MAX      1000u
+#endif
+#if !defined(BENCH_OS_EVENT_MASK)
+#define BENCH_OS_EVENT_MASK     0x80000000uL
+#endif
+#if !defined(BENCH_OS_ALARM_TICKS)
+#define BENCH_OS_ALARM_TICKS    1000u
+#endif
+#if !defined(BENCH_DB_FILE)
+#define BENCH_DB_FILE           "/tmp/bench.sqlite3"
+#endif
+#if !defined(BENCH_DATA_LENGTH)
+#define BENCH_DATA_LENGTH       64u
+#endif
+
+#if (defined(USE_PDUR) && defined(BENCH_PDUR_ROUTING_PATH)) || \
+    (defined(USE_CANIF) && defined(BENCH_CANIF_HRH)) || \
+    (defined(USE_CANTP) && defined(BENCH_CANTP_TX_SDU_ID)) || \
+    (defined(USE_DCM) && defined(BENCH_DCM_RX_PDU_ID)) || \
+    (defined(USE_NVM) && defined(BENCH_NVM_BLOCK_ID)) || \
+    defined(USE_CRC) || defined(USE_E2E)
+static uint8 benchData[256];
+#endif
+
+/* Baseline, what is left of the timer overhead after calibration */
+static void bench_noop(uint32 i) {
+    (void)i;
+}
+
+/* ----------------------------[Com]-----------------------------------------*/
+#if defined(USE_COM) && defined(BENCH_COM_TX_SIGNAL_ID)
+static void bench_com_send(uint32 i) {
+    uint64 value = i;
+    if (Com_SendSignal(BENCH_COM_TX_SIGNAL_ID, &value) != E_OK) {
+        Bench_Fail("Com_SendSignal");
+    }
+}
+
+static void bench_com_receive(uint32 i) {
+    uint64 value = 0;
+    (void)i;
+    if (Com_ReceiveSignal(BENCH_COM_RX_SIGNAL_ID, &value) != E_OK) {
+        Bench_Fail("Com_ReceiveSignal");
+    }
+}
+
+static void bench_com_main_tx(uint32 i) {
+    (void)i;
+    Com_MainFunctionTx();
+}
+#endif
+
+#if defined(USE_COM) && defined(BENCH_COM_BATCH_SIGNALS)
+static const Com_SignalIdType benchComBatchIds[] = { BENCH_COM_BATCH_SIGNALS };
+#define BENCH_COM_BATCH_CNT     (sizeof(benchComBatchIds) / sizeof(benchComBatchIds[0]))
+static uint64 benchComBatchValues[BENCH_COM_BATCH_CNT];
+static Com_Arc_SendSignalType benchComSend[BENCH_COM_BATCH_CNT];
+static Com_Arc_ReceiveSignalType benchComReceive[BENCH_COM_BATCH_CNT];
+
+static void bench_com_batch_setup(void) {
+    for (uint32 k = 0; k < BENCH_COM_BATCH_CNT; k++) {
+        benchComSend[k].SignalId = benchComBatchIds[k];
+        benchComSend[k].SignalDataPtr = &benchComBatchValues[k];
+        benchComReceive[k].SignalId = benchComBatchIds[k];
+        benchComReceive[k].SignalDataPtr = &benchComBatchValues[k];
+    }
+}
+
+static void bench_com_send_signals(uint32 i) {
+    benchComBatchValues[i % BENCH_COM_BATCH_CNT] = i;
+    if (Com_Arc_SendSignals(benchComSend, (uint16)BENCH_COM_BATCH_CNT) != E_OK) {
+        Bench_Fail("Com_Arc_SendSignals");
+    }
+}
+
+static void bench_com_receive_signals(uint32 i) {
+    (void)i;
+    if (Com_Arc_ReceiveSignals(benchComReceive, (uint16)BENCH_COM_BATCH_CNT) != E_OK) {
+        Bench_Fail("Com_Arc_ReceiveSignals");
+    }
+}
+#endif
+
+/* ----------------------------[PduR]----------------------------------------*/
+#if defined(USE_PDUR) && defined(BENCH_PDUR_ROUTING_PATH)
+static const PduRDestPdu_type *benchPduRDest;
+
+static void bench_pdur_setup(void) {
+    benchPduRDest = PduRConfig->RoutingPaths[BENCH_PDUR_ROUTING_PATH]->PduRDestPdus[0];
+}
+
+static void bench_pdur_route(uint32 i) {
+    PduInfoType info = { benchData, 8u };
+    benchData[0] = (uint8)i;
+    (void)PduR_ARC_RouteTransmit(benchPduRDest, &info);
+}
+#endif
+
+/* ----------------------------[CanIf]---------------------------------------*/
+#if defined(USE_CANIF) && defined(BENCH_CANIF_HRH)
+static void bench_canif_rx(uint32 i) {
+    benchData[0] = (uint8)i;
+#if defined(CFG_CANIF_ASR_4_3_1)
+    {
+        Can_HwType mailbox;
+        PduInfoType info = { benchData, 8u };
+        mailbox.CanId = BENCH_CANIF_CANID;
+        mailbox.Hoh = BENCH_CANIF_HRH;
+        mailbox.ControllerId = 0;
+        CanIf_RxIndication(&mailbox, &info);
+    }
+#else
+    CanIf_RxIndication(BENCH_CANIF_HRH, BENCH_CANIF_CANID, 8u, benchData);
+#endif
+}
+#endif
+
+/* ----------------------------[CanTp]---------------------------------------*/
+#if defined(USE_CANTP) && defined(BENCH_CANTP_TX_SDU_ID)
+/* One segmented transmission: FF, FC(CTS) from the receiver, then all CFs */
+static void bench_cantp_segmented(uint32 i) {
+    PduInfoType sdu = { benchData, BENCH_CANTP_LENGTH };
+    uint8 fc[8] = { 0x30u, 0u, 0u, 0u, 0u, 0u, 0u, 0u };
+    PduInfoType fcInfo = { fc, 8u };
+    uint32 frames = ((BENCH_CANTP_LENGTH - 6u) + 6u) / 7u;    /* CFs after the 6 bytes of the FF */
+    uint32 f;
+
+    (void)i;
+    if (CanTp_Transmit(BENCH_CANTP_TX_SDU_ID, &sdu) != E_OK) {
+        Bench_Fail("CanTp_Transmit");
+        return;
+    }
+    CanTp_MainFunction();
+    CanTp_TxConfirmation(BENCH_CANTP_TX_PDU_ID);
+    CanTp_RxIndication(BENCH_CANTP_FC_PDU_ID, &fcInfo);
+    for (f = 0; f < frames; f++) {
+        CanTp_MainFunction();
+        CanTp_TxConfirmation(BENCH_CANTP_TX_PDU_ID);
+    }
+    CanTp_MainFunction();
+}
+#endif
+
+/* ----------------------------[Dem]-----------------------------------------*/
+#if defined(USE_DEM) && defined(BENCH_DEM_EVENT_ID)
+static void bench_dem_report(uint32 i) {
+    Dem_ReportErrorStatus(BENCH_DEM_EVENT_ID, ((i & 1u) != 0u) ? DEM_EVENT_STATUS_FAILED : DEM_EVENT_STATUS_PASSED);
+}
+#endif
+
+/* ----------------------------[Dcm]-----------------------------------------*/
+#if defined(USE_DCM) && defined(BENCH_DCM_RX_PDU_ID)
+/* ReadDataByIdentifier, request in to response out */
+static void bench_dcm_read_did(uint32 i) {
+    uint8 req[3] = { 0x22u, (uint8)((BENCH_DCM_DID >> 8u) & 0xFFu), (uint8)(BENCH_DCM_DID & 0xFFu) };
+    PduInfoType reqInfo = { req, sizeof(req) };
+    PduInfoType resInfo = { benchData, 0u };
+    PduLengthType bufSize = 0;
+
+    (void)i;
+    if (Dcm_StartOfReception(BENCH_DCM_RX_PDU_ID, sizeof(req), &bufSize) != BUFREQ_OK) {
+        Bench_Fail("Dcm_StartOfReception");
+        return;
+    }
+    (void)Dcm_CopyRxData(BENCH_DCM_RX_PDU_ID, &reqInfo, &bufSize);
+    Dcm_TpRxIndication(BENCH_DCM_RX_PDU_ID, NTFRSLT_OK);
+    Dcm_MainFunction();
+    resInfo.SduLength = 0;
+    (void)Dcm_CopyTxData(BENCH_DCM_TX_PDU_ID, &resInfo, NULL, &bufSize);
+    resInfo.SduLength = (bufSize < sizeof(benchData)) ? bufSize : sizeof(benchData);
+    (void)Dcm_CopyTxData(BENCH_DCM_TX_PDU_ID, &resInfo, NULL, &bufSize);
+    Dcm_TpTxConfirmation(BENCH_DCM_TX_PDU_ID, NTFRSLT_OK);
+    Dcm_MainFunction();
+}
+#endif
+
+/* ----------------------------[NvM]-----------------------------------------*/
+#if defined(USE_NVM) && defined(BENCH_NVM_BLOCK_ID)
+/* Request to completion, the main functions of the memory stack are the
+ * project's, called from BENCH_NVM_MAIN() */
+#if !defined(BENCH_NVM_MAIN)
+#define BENCH_NVM_MAIN()        NvM_MainFunction()
+#endif
+
+static void bench_nvm_write(uint32 i) {
+    NvM_RequestResultType result = NVM_REQ_PENDING;
+    uint32 n;
+
+    benchData[0] = (uint8)i;
+    if (NvM_WriteBlock(BENCH_NVM_BLOCK_ID, benchData) != E_OK) {
+        Bench_Fail("NvM_WriteBlock");
+        return;
+    }
+    for (n = 0; (n < BENCH_NVM_MAIN_MAX) && (result == NVM_REQ_PENDING); n++) {
+        BENCH_NVM_MAIN();
+        (void)NvM_GetErrorStatus(BENCH_NVM_BLOCK_ID, &result);
+    }
+    if (result != NVM_REQ_OK) {
+        Bench_Fail("NvM_WriteBlock did not complete");
+    }
+}
+#endif
+
+/* ----------------------------[Os]------------------------------------------*/
+#if (defined(USE_KERNEL) || defined(USE_LINUXOS)) && defined(BENCH_OS_EVENT_TASK_ID)
+static void bench_os_set_event(uint32 i) {
+    EventMaskType mask = 0;
+
+    (void)i;
+    if (SetEvent(BENCH_OS_EVENT_TASK_ID, BENCH_OS_EVENT_MASK) != E_OK) {
+        Bench_Fail("SetEvent");
+    }
+    (void)GetEvent(BENCH_OS_EVENT_TASK_ID, &mask);
+}
+
+#if defined(BENCH_OS_EVENT_WAIT_TASK_ID)
+static void bench_os_set_event_wake(uint32 i) {
+    (void)i;
+    if (SetEvent(BENCH_OS_EVENT_WAIT_TASK_ID, BENCH_OS_EVENT_MASK) != E_OK) {
+        Bench_Fail("SetEvent");
+    }
+}
+#endif
+#endif
+
+#if (defined(USE_KERNEL) || defined(USE_LINUXOS)) && defined(BENCH_OS_ALARM_ID)
+static void bench_os_alarm_set_cancel(uint32 i) {
+    if (SetRelAlarm(BENCH_OS_ALARM_ID, BENCH_OS_ALARM_TICKS + (i & 0xFFu), 0) != E_OK) {
+        Bench_Fail("SetRelAlarm");
+    }
+    if (CancelAlarm(BENCH_OS_ALARM_ID) != E_OK) {
+        Bench_Fail("CancelAlarm");
+    }
+}
+#endif
+
+#if (defined(USE_KERNEL) || defined(USE_LINUXOS)) && defined(BENCH_OS_COUNTER_ID)
+static void bench_os_increment_counter(uint32 i) {
+    (void)i;
+    if (IncrementCounter(BENCH_OS_COUNTER_ID) != E_OK) {
+        Bench_Fail("IncrementCounter");
+    }
+}
+#endif
+
+#if (defined(USE_KERNEL) || defined(USE_LINUXOS)) && defined(BENCH_OS_TASK_ID)
+static void bench_os_activate_task(uint32 i) {
+    (void)i;
+    if (ActivateTask(BENCH_OS_TASK_ID) != E_OK) {
+        Bench_Fail("ActivateTask");
+    }
+}
+#endif
+
+#if (defined(USE_KERNEL) || defined(USE_LINUXOS)) && defined(BENCH_OS_RESOURCE_ID)
+static void bench_os_get_release_resource(uint32 i) {
+    (void)i;
+    if (GetResource(BENCH_OS_RESOURCE_ID) != E_OK) {
+        Bench_Fail("GetResource");
+        return;
+    }
+    if (ReleaseResource(BENCH_OS_RESOURCE_ID) != E_OK) {
+        Bench_Fail("ReleaseResource");
+    }
+}
+#endif
+
+/* ----------------------------[Os event baseline]---------------------------*/
+#if defined(__linux__)
+/* The event state of a task as LinuxOs kept it before the futex path */
+typedef struct {
+    pthread_mutex_t mutex_lock;
+    pthread_cond_t cond;
+    uint32 EventState;
+} BenchEventType;
+
+static BenchEventType benchEvent = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, 0 };
+static pthread_t benchEventWaiter;
+static volatile boolean benchEventStop;
+
+static void bench_event_set(uint32 mask) {
+    pthread_mutex_lock(&benchEvent.mutex_lock);
+    benchEvent.EventState |= mask;
+    pthread_cond_signal(&benchEvent.cond);
+    pthread_mutex_unlock(&benchEvent.mutex_lock);
+}
+
+/* WaitEvent and ClearEvent of the waiting task */
+static void *bench_event_waiter(void *arg) {
+    (void)arg;
+    pthread_mutex_lock(&benchEvent.mutex_lock);
+    while (!benchEventStop) {
+        while (((benchEvent.EventState & BENCH_OS_EVENT_MASK) == 0) && !benchEventStop) {
+            pthread_cond_wait(&benchEvent.cond, &benchEvent.mutex_lock);
+        }
+        benchEvent.EventState &= ~(uint32)BENCH_OS_EVENT_MASK;
+    }
+    pthread_mutex_unlock(&benchEvent.mutex_lock);
+    return NULL;
+}
+
+static void bench_event_wake_setup(void) {
+    benchEventStop = FALSE;
+    benchEvent.EventState = 0;
+    (void)pthread_create(&benchEventWaiter, NULL, bench_event_waiter, NULL);
+}
+
+static void bench_event_wake_teardown(void) {
+    pthread_mutex_lock(&benchEvent.mutex_lock);
+    benchEventStop = TRUE;
+    pthread_cond_signal(&benchEvent.cond);
+    pthread_mutex_unlock(&benchEvent.mutex_lock);
+    (void)pthread_join(benchEventWaiter, NULL);
+}
+
+static void bench_os_set_event_mutex(uint32 i) {
+    uint32 mask;
+
+    (void)i;
+    bench_event_set(BENCH_OS_EVENT_MASK);
+    pthread_mutex_lock(&benchEvent.mutex_lock);
+    mask = benchEvent.EventState;
+    pthread_mutex_unlock(&benchEvent.mutex_lock);
+    (void)mask;
+}
+
+static void bench_os_set_event_wake_mutex(uint32 i) {
+    (void)i;
+    bench_event_set(BENCH_OS_EVENT_MASK);
+}
+#endif
+
+/* ----------------------------[LinuxOs logger]-----------------------------*/
+#if defined(USE_LINUXOS)
+extern int logger_output_mask;
+
+static int benchLoggerMask;
+static int benchLoggerWasAsync;
+static uint64_t benchLoggerDone;
+static uint64_t benchLoggerDropped;
+static uint32 benchLoggerCnt;
+
+static void bench_logger_setup(void) {
+    benchLoggerMask = logger_output_mask;
+    benchLoggerWasAsync = logger_async_active();
+    /* Write what is queued before turning the outputs off */
+    logger_async_stop();
+    (void)logger_set_output(0);
+}
+
+static void bench_logger_async_setup(void) {
+    bench_logger_setup();
+    if (logger_async_start() != 0) {
+        Bench_Fail("logger_async_start");
+    }
+    logger_async_stats(&benchLoggerDone, &benchLoggerDropped);
+    benchLoggerDone += benchLoggerDropped;
+    benchLoggerCnt = 0;
+}
+
+static void bench_logger_teardown(void) {
+    logger_async_stop();
+    (void)logger_set_output(benchLoggerMask);
+    if (benchLoggerWasAsync) {
+        (void)logger_async_start();
+    }
+}
+
+static void bench_logger_async_teardown(void) {
+    uint64_t written;
+    uint64_t dropped;
+
+    logger_async_stop();
+    logger_async_stats(&written, &dropped);
+    if (dropped != benchLoggerDropped) {
+        Bench_Fail("logger records dropped");
+    }
+    bench_logger_teardown();
+}
+
+static void bench_logger_async(uint32 i) {
+    uint64_t written;
+    uint64_t dropped;
+
+    /* Not i, the warmup calls count too */
+    if ((benchLoggerCnt++ % LOGGER_ASYNC_WAKE_FILL) == 0u) {
+        do {
+            (void)sched_yield();
+            logger_async_stats(&written, &dropped);
+        } while ((written + dropped) < benchLoggerDone);
+    }
+    logger(LOG_DEBUG, "bench %u %s", (unsigned)i, "logger");
+    benchLoggerDone++;
+}
+
+static void bench_logger_sync(uint32 i) {
+    /* The function, not the macro, formats in the calling task */
+    (logger)(LOG_DEBUG, "bench %u %s", (unsigned)i, "logger");
+}
+#endif
+
+/* ----------------------------[LinuxOs DB]---------------------------------*/
+#if defined(USE_LINOS_DB)
+#define BENCH_DB_REG_CNT        64u
+
+static void bench_db_setup(void) {
+    (void)remove(BENCH_DB_FILE);
+    if (db_init(BENCH_DB_FILE) != DB_OK) {
+        Bench_Fail("db_init");
+    }
+}
+
+static void bench_db_teardown(void) {
+    (void)db_close();
+}
+
+static void bench_db_set(uint32 i) {
+    if (db_set_register((int)(i % BENCH_DB_REG_CNT), (int)i, DB_CREATE_MISSING_WRITE, 1, 1) != DB_OK) {
+        Bench_Fail("db_set_register");
+    }
+}
+
+static void bench_db_set_merged(uint32 i) {
+    if (db_set_register(0, (int)i, DB_CREATE_MISSING_WRITE, 1, 1) != DB_OK) {
+        Bench_Fail("db_set_register");
+    }
+}
+#endif
+
+/* ----------------------------[Crc]-----------------------------------------*/
+#if defined(USE_CRC) && defined(Crc_32_Mode)
+static void bench_crc32(uint32 i) {
+    benchData[0] = (uint8)i;
+    (void)Crc_CalculateCRC32(benchData, BENCH_DATA_LENGTH, 0xFFFFFFFFuL, TRUE);
+}
+#endif
+
+/* ----------------------------[E2E]-----------------------------------------*/
+#if defined(USE_E2E)
+static const E2E_P04ConfigType benchE2EConfig = {
+    0x12345678uL,               /* DataID */
+    0u,                         /* Offset */
+    12u * 8u,                   /* MinDataLength, bits */
+    BENCH_DATA_LENGTH * 8u,     /* MaxDataLength, bits */
+    1u,                         /* MaxDeltaCounter */
+};
+static E2E_P04ProtectStateType benchE2EState;
+
+static void bench_e2e_setup(void) {
+    (void)E2E_P04ProtectInit(&benchE2EState);
+}
+
+static void bench_e2e_p04_protect(uint32 i) {
+    benchData[12] = (uint8)i;
+    if (E2E_P04Protect(&benchE2EConfig, &benchE2EState, benchData, BENCH_DATA_LENGTH) != E_OK) {
+        Bench_Fail("E2E_P04Protect");
+    }
+}
+#endif
+
+/* ----------------------------[cirq_buffer]---------------------------------*/
+#if defined(__linux__)
+#define BENCH_CIRQ_CNT          256u
+#define BENCH_CIRQ_PROD_MAX     4u
+
+static CirqBuffLfType benchCirq;
+static uint32 benchCirqData[BENCH_CIRQ_CNT];
+static uint32 benchCirqSeq[BENCH_CIRQ_CNT];
+static pthread_t benchCirqThreads[BENCH_CIRQ_PROD_MAX];
+static uint32 benchCirqThreadCnt;
+static volatile boolean benchCirqStop;
+
+static void *bench_cirq_consumer(void *arg) {
+    uint32 v;
+    (void)arg;
+    while (!benchCirqStop) {
+        (void)CirqBuffLf_Pop(&benchCirq, &v);
+    }
+    return NULL;
+}
+
+static void *bench_cirq_producer(void *arg) {
+    uint32 v = 0;
+    (void)arg;
+    while (!benchCirqStop) {
+        (void)CirqBuffLf_Push(&benchCirq, &v);
+        v++;
+    }
+    return NULL;
+}
+
+/* Consumer thread and producers - 1 other producer threads */
+static void bench_cirq_start(CirqBuffLfModeType mode, uint32 producers) {
+    uint32 i;
+
+    (void)CirqBuffLf_Init(&benchCirq, mode, benchCirqData, benchCirqSeq, BENCH_CIRQ_CNT, sizeof(uint32));
+    benchCirqStop = FALSE;
+    benchCirqThreadCnt = 0;
+    (void)pthread_create(&benchCirqThreads[benchCirqThreadCnt++], NULL, bench_cirq_consumer, NULL);
+    for (i = 1; i < producers; i++) {
+        (void)pthread_create(&benchCirqThreads[benchCirqThreadCnt++], NULL, bench_cirq_producer, NULL);
+    }
+}
+
+static void bench_cirq_stop(void) {
+    uint32 i;
+
+    benchCirqStop = TRUE;
+    for (i = 0; i < benchCirqThreadCnt; i++) {
+        (void)pthread_join(benchCirqThreads[i], NULL);
+    }
+}
+
+static void bench_cirq_spsc_setup(void) { bench_cirq_start(CIRQBUFF_SPSC, 1u); }
+static void bench_cirq_mpsc1_setup(void) { bench_cirq_start(CIRQBUFF_MPSC, 1u); }
+static void bench_cirq_mpsc2_setup(void) { bench_cirq_start(CIRQBUFF_MPSC, 2u); }
+static void bench_cirq_mpsc4_setup(void) { bench_cirq_start(CIRQBUFF_MPSC, 4u); }
+
+/* One push, retried while the buffer is full */
+static void bench_cirq_push(uint32 i) {
+    while (CirqBuffLf_Push(&benchCirq, &i) != 0) {
+        /* Wait for the consumer */
+    }
+}
+#endif
+
+const Bench_CaseType Bench_BswCases[] = {
+    { "noop", NULL, bench_noop, NULL, 0 },
+#if defined(__linux__)
+    { "cirqbuff_spsc_push", bench_cirq_spsc_setup, bench_cirq_push, bench_cirq_stop, 0 },
+    { "cirqbuff_mpsc_push_p1", bench_cirq_mpsc1_setup, bench_cirq_push, bench_cirq_stop, 0 },
+    { "cirqbuff_mpsc_push_p2", bench_cirq_mpsc2_setup, bench_cirq_push, bench_cirq_stop, 0 },
+    { "cirqbuff_mpsc_push_p4", bench_cirq_mpsc4_setup, bench_cirq_push, bench_cirq_stop, 0 },
+#endif
+#if defined(USE_COM) && defined(BENCH_COM_TX_SIGNAL_ID)
+    { "com_send_signal", NULL, bench_com_send, NULL, 0 },
+    { "com_receive_signal", NULL, bench_com_receive, NULL, 0 },
+    { "com_main_function_tx", NULL, bench_com_main_tx, NULL, 0 },
+#endif
+#if defined(USE_COM) && defined(BENCH_COM_BATCH_SIGNALS)
+    { "com_send_signals", bench_com_batch_setup, bench_com_send_signals, NULL, 0 },
+    { "com_receive_signals", bench_com_batch_setup, bench_com_receive_signals, NULL, 0 },
+#endif
+#if defined(USE_PDUR) && defined(BENCH_PDUR_ROUTING_PATH)
+    { "pdur_route_transmit", bench_pdur_setup, bench_pdur_route, NULL, 0 },
+#endif
+#if defined(USE_CANIF) && defined(BENCH_CANIF_HRH)
+    { "canif_rx_indication", NULL, bench_canif_rx, NULL, 0 },
+#endif
+#if defined(USE_CANTP) && defined(BENCH_CANTP_TX_SDU_ID)
+    { "cantp_segmented_tx", NULL, bench_cantp_segmented, NULL, 10000uL },
+#endif
+#if defined(USE_DEM) && defined(BENCH_DEM_EVENT_ID)
+    { "dem_report_error_status", NULL, bench_dem_report, NULL, 0 },
+#endif
+#if defined(USE_DCM) && defined(BENCH_DCM_RX_PDU_ID)
+    { "dcm_read_did", NULL, bench_dcm_read_did, NULL, 10000uL },
+#endif
+#if defined(USE_NVM) && defined(BENCH_NVM_BLOCK_ID)
+    { "nvm_write_block", NULL, bench_nvm_write, NULL, 1000uL },
+#endif
+#if (defined(USE_KERNEL) || defined(USE_LINUXOS)) && defined(BENCH_OS_EVENT_TASK_ID)
+    { "os_set_event", NULL, bench_os_set_event, NULL, 0 },
+#if defined(BENCH_OS_EVENT_WAIT_TASK_ID)
+    { "os_set_event_wake", NULL, bench_os_set_event_wake, NULL, 0 },
+#endif
+#endif
+#if defined(__linux__)
+    { "os_set_event_mutex", NULL, bench_os_set_event_mutex, NULL, 0 },
+    { "os_set_event_wake_mutex", bench_event_wake_setup, bench_os_set_event_wake_mutex, bench_event_wake_teardown, 0 },
+#endif
+#if (defined(USE_KERNEL) || defined(USE_LINUXOS)) && defined(BENCH_OS_ALARM_ID)
+    { "os_alarm_set_cancel", NULL, bench_os_alarm_set_cancel, NULL, 0 },
+#endif
+#if (defined(USE_KERNEL) || defined(USE_LINUXOS)) && defined(BENCH_OS_COUNTER_ID)
+    { "os_increment_counter", NULL, bench_os_increment_counter, NULL, 0 },
+#endif
+#if (defined(USE_KERNEL) || defined(USE_LINUXOS)) && defined(BENCH_OS_TASK_ID)
+    { "os_activate_task", NULL, bench_os_activate_task, NULL, 0 },
+#endif
+#if (defined(USE_KERNEL) || defined(USE_LINUXOS)) && defined(BENCH_OS_RESOURCE_ID)
+    { "os_get_release_resource", NULL, bench_os_get_release_resource, NULL, 0 },
+#endif
+#if defined(USE_LINUXOS)
+    { "logger_async", bench_logger_async_setup, bench_logger_async, bench_logger_async_teardown, 0 },
+    { "logger_sync", bench_logger_setup, bench_logger_sync, bench_logger_teardown, 0 },
+#endif
+#if defined(USE_LINOS_DB)
+    { "db_set_register", bench_db_setup, bench_db_set, bench_db_teardown, 0 },
+    { "db_set_register_merged", bench_db_setup, bench_db_set_merged, bench_db_teardown, 0 },
+#endif
+#if defined(USE_CRC) && defined(Crc_32_Mode)
+    { "crc32", NULL, bench_crc32, NULL, 0 },
+#endif
+#if defined(USE_E2E)
+    { "e2e_p04_protect", bench_e2e_setup, bench_e2e_p04_protect, NULL, 0 },
+#endif
+};
+
+const uint32 Bench_BswCaseCnt = sizeof(Bench_BswCases) / sizeof(Bench_BswCases[0]);